@@ -0,0 +1,507 @@
+#include <vector>
+#include <algorithm>
+#include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vkFFT.h>
+#include <vulkan/vulkan.h>
+
+//Command line benchmark of VkFFT. Every system is planned, filled with data and transformed iterations times, each transform is timed with GPU timestamps (or CPU timer if the queue has no timestamp support). Results are written as JSON.
+//Usage: VkFFT_benchmark [-size X [Y [Z]]]... [-dim D] [-r2c] [-inverse] [-precision single] [-coordinates C] [-batch B] [-iterations I] [-warmup W] [-device ID] [-cpu] [-threads T] [-o results.json]
+//Each -size adds one system. -dim overrides the dimensionality derived from the number of sizes given. -batch is numberBatches of the configuration (systems per VkFFTAppend).
+//recordTime and executeRecordTime are the CPU times of recording the transform into a command buffer every call and of executing a secondary command buffer recorded once.
+//-cpu additionally times the same configuration on the CPU backend (executeOnCPU on host memory) with T threads (0 - all hardware threads). If no Vulkan device can be created, only the CPU backend is timed. -cpu and -threads are available in builds with VKFFT_CPU_BACKEND defined.
+
+VkInstance instance = {};
+VkPhysicalDevice physicalDevice = {};
+VkPhysicalDeviceProperties physicalDeviceProperties = {};
+VkDevice device = {};
+uint32_t queueFamilyIndex = {};
+uint32_t timestampValidBits = 0;
+VkQueue queue = {};
+VkCommandPool commandPool = {};
+VkFence fence = {};
+
+typedef struct {
+	std::vector<std::vector<uint32_t>> sizes;
+	uint32_t FFTdim = 0; //0 - number of sizes given
+	bool performR2C = false;
+	bool inverse = false;
+	char precision[16] = "single";
+	uint32_t coordinateFeatures = 1;
+	uint32_t numberBatches = 1;
+	uint32_t iterations = 100;
+	uint32_t warmup = 5;
+	uint32_t deviceID = 0;
+	bool cpu = false;
+	uint32_t numberCPUThreads = 0;
+	char outputPath[256] = "";
+} BenchmarkOptions;
+
+typedef struct {
+	uint32_t size[3];
+	uint32_t FFTdim;
+	float planTime; //ms, initializeVulkanFFT
+	float minTime; //ms per VkFFTAppend
+	float medianTime;
+	float p90Time;
+	float p99Time;
+	float maxTime;
+	float meanTime;
+	double gflops;
+	double bandwidth; //GB/s of global memory traffic predicted by getMemoryRequirements
+	double bufferBandwidth; //GB/s of reading and writing the buffer once
+	uint64_t bytesMoved;
+	uint32_t numPasses;
+	bool isTimestamp;
+	float recordTime; //ms of CPU time to record one VkFFTAppend into a new command buffer
+	float executeRecordTime; //ms of CPU time to record a primary command buffer executing a secondary recorded once with VkFFTRecordCommandBuffer
+	bool isGPU; //false if no Vulkan device was available
+	bool isCPU;
+	float cpuPlanTime; //ms, initializeVulkanFFT of the CPU backend
+	float cpuMinTime; //ms per executeOnCPU
+	float cpuMedianTime;
+	double cpuGflops;
+} BenchmarkResult;
+
+bool parseOptions(int argc, char* argv[], BenchmarkOptions* options) {
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-size") == 0) {
+			std::vector<uint32_t> size;
+			while ((i + 1 < argc) && (argv[i + 1][0] != '-') && (size.size() < 3)) {
+				size.push_back(atoi(argv[i + 1]));
+				i++;
+			}
+			if (size.size() == 0) {
+				printf("-size needs 1 to 3 values\n");
+				return false;
+			}
+			options->sizes.push_back(size);
+		}
+		else if ((strcmp(argv[i], "-dim") == 0) && (i + 1 < argc)) options->FFTdim = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-r2c") == 0) options->performR2C = true;
+		else if (strcmp(argv[i], "-c2c") == 0) options->performR2C = false;
+		else if (strcmp(argv[i], "-inverse") == 0) options->inverse = true;
+		else if ((strcmp(argv[i], "-precision") == 0) && (i + 1 < argc)) sprintf(options->precision, "%.15s", argv[++i]);
+		else if ((strcmp(argv[i], "-coordinates") == 0) && (i + 1 < argc)) options->coordinateFeatures = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-batch") == 0) && (i + 1 < argc)) options->numberBatches = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-iterations") == 0) && (i + 1 < argc)) options->iterations = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-warmup") == 0) && (i + 1 < argc)) options->warmup = atoi(argv[++i]);
+		else if ((strcmp(argv[i], "-device") == 0) && (i + 1 < argc)) options->deviceID = atoi(argv[++i]);
+#ifdef VKFFT_CPU_BACKEND
+		else if (strcmp(argv[i], "-cpu") == 0) options->cpu = true;
+		else if ((strcmp(argv[i], "-threads") == 0) && (i + 1 < argc)) options->numberCPUThreads = atoi(argv[++i]);
+#else
+		else if ((strcmp(argv[i], "-cpu") == 0) || (strcmp(argv[i], "-threads") == 0)) {
+			printf("%s needs the CPU backend, build with VKFFT_CPU_BACKEND defined\n", argv[i]);
+			return false;
+		}
+#endif
+		else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) sprintf(options->outputPath, "%.255s", argv[++i]);
+		else {
+			printf("Unknown option: %s\n", argv[i]);
+			printf("Usage: VkFFT_benchmark [-size X [Y [Z]]]... [-dim D] [-r2c] [-inverse] [-precision single] [-coordinates C] [-batch B] [-iterations I] [-warmup W] [-device ID] [-cpu] [-threads T] [-o results.json]\n");
+			return false;
+		}
+	}
+	if (options->sizes.size() == 0) {
+		//default set - powers of two from 2^6 to 2^14 in 1D, 2D and 3D
+		for (uint32_t n = 6; n <= 14; n++) options->sizes.push_back({ (uint32_t)1 << n });
+		for (uint32_t n = 6; n <= 12; n++) options->sizes.push_back({ (uint32_t)1 << n, (uint32_t)1 << n });
+		for (uint32_t n = 5; n <= 8; n++) options->sizes.push_back({ (uint32_t)1 << n, (uint32_t)1 << n, (uint32_t)1 << n });
+	}
+	if (strcmp(options->precision, "single") != 0) {
+		//only single precision shaders are shipped
+		printf("Precision %s is not supported, only single precision shaders are available\n", options->precision);
+		return false;
+	}
+	if ((options->iterations == 0) || (options->numberBatches == 0) || (options->coordinateFeatures == 0)) {
+		printf("iterations, batch and coordinates have to be positive\n");
+		return false;
+	}
+	return true;
+}
+
+bool createDevice(uint32_t deviceID) {
+	VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+	applicationInfo.pApplicationName = "VkFFT_benchmark";
+	applicationInfo.pEngineName = "VkFFT";
+	applicationInfo.apiVersion = VK_API_VERSION_1_0;
+	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+	createInfo.pApplicationInfo = &applicationInfo;
+	if (vkCreateInstance(&createInfo, NULL, &instance) != VK_SUCCESS) {
+		fprintf(stderr, "Instance creation failed\n");
+		return false;
+	}
+	uint32_t deviceCount = 0;
+	vkEnumeratePhysicalDevices(instance, &deviceCount, NULL);
+	if (deviceID >= deviceCount) {
+		fprintf(stderr, "Device %d not found, %d devices with Vulkan support available\n", deviceID, deviceCount);
+		return false;
+	}
+	std::vector<VkPhysicalDevice> devices(deviceCount);
+	vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+	physicalDevice = devices[deviceID];
+	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	for (queueFamilyIndex = 0; queueFamilyIndex < queueFamilyCount; queueFamilyIndex++) {
+		if ((queueFamilies[queueFamilyIndex].queueCount > 0) && (queueFamilies[queueFamilyIndex].queueFlags & VK_QUEUE_COMPUTE_BIT)) break;
+	}
+	if (queueFamilyIndex == queueFamilyCount) {
+		fprintf(stderr, "Device has no compute queue\n");
+		return false;
+	}
+	timestampValidBits = queueFamilies[queueFamilyIndex].timestampValidBits;
+
+	VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+	float queuePriorities = 1.0;
+	queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+	queueCreateInfo.queueCount = 1;
+	queueCreateInfo.pQueuePriorities = &queuePriorities;
+	VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+	deviceCreateInfo.queueCreateInfoCount = 1;
+	if (vkCreateDevice(physicalDevice, &deviceCreateInfo, NULL, &device) != VK_SUCCESS) {
+		fprintf(stderr, "Device creation failed\n");
+		return false;
+	}
+	vkGetDeviceQueue(device, queueFamilyIndex, 0, &queue);
+	VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+	vkCreateFence(device, &fenceCreateInfo, NULL, &fence);
+	VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+	vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+	return true;
+}
+
+uint32_t findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) {
+	VkPhysicalDeviceMemoryProperties memoryProperties = {};
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+	for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+		if ((memoryTypeBits & (1 << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties))
+			return i;
+	}
+	return -1;
+}
+bool allocateBuffer(VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usageFlags;
+	if (vkCreateBuffer(device, &bufferCreateInfo, NULL, buffer) != VK_SUCCESS) return false;
+	VkMemoryRequirements memoryRequirements = {};
+	vkGetBufferMemoryRequirements(device, buffer[0], &memoryRequirements);
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags);
+	if (vkAllocateMemory(device, &memoryAllocateInfo, NULL, deviceMemory) != VK_SUCCESS) {
+		vkDestroyBuffer(device, buffer[0], NULL);
+		return false;
+	}
+	vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
+	return true;
+}
+void submitAndWait(VkCommandBuffer commandBuffer) {
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
+}
+void fillBuffer(VkBuffer* buffer, VkDeviceSize bufferSize) {
+	//pseudorandom data in [-1,1] through a staging buffer, so the timed transforms don't work on zeros
+	VkBuffer stagingBuffer = {};
+	VkDeviceMemory stagingBufferMemory = {};
+	allocateBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, bufferSize);
+	float* data;
+	vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, (void**)&data);
+	uint32_t seed = 1;
+	for (uint64_t i = 0; i < bufferSize / sizeof(float); i++) {
+		seed = seed * 1664525 + 1013904223;
+		data[i] = 2.0f * (seed >> 8) / (1 << 24) - 1.0f;
+	}
+	vkUnmapMemory(device, stagingBufferMemory);
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	VkBufferCopy copyRegion = {};
+	copyRegion.size = bufferSize;
+	vkCmdCopyBuffer(commandBuffer, stagingBuffer, buffer[0], 1, &copyRegion);
+	vkEndCommandBuffer(commandBuffer);
+	submitAndWait(commandBuffer);
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	vkDestroyBuffer(device, stagingBuffer, NULL);
+	vkFreeMemory(device, stagingBufferMemory, NULL);
+}
+double transformFlops(VkFFTConfiguration* configuration) {
+	//5 N log2(N) flops per complex transform of N points, half of it for R2C/C2R
+	double N = (double)configuration->size[0] * configuration->size[1] * configuration->size[2];
+	double flops = 5.0 * N * log2(N) * configuration->coordinateFeatures * configuration->numberBatches;
+	if (configuration->performR2C) flops *= 0.5;
+	return flops;
+}
+float percentile(std::vector<float>& sortedTimes, float p) {
+	uint32_t index = (uint32_t)(p * (sortedTimes.size() - 1) + 0.5f);
+	return sortedTimes[index];
+}
+
+bool benchmarkSystem(BenchmarkOptions* options, std::vector<uint32_t>& size, BenchmarkResult* result) {
+	VkFFTConfiguration configuration = {};
+	configuration.FFTdim = (options->FFTdim > 0) ? options->FFTdim : size.size();
+	for (uint32_t i = 0; i < 3; i++)
+		configuration.size[i] = ((i < size.size()) && (i < configuration.FFTdim)) ? size[i] : 1;
+	configuration.performR2C = options->performR2C;
+	configuration.inverse = options->inverse;
+	configuration.coordinateFeatures = options->coordinateFeatures;
+	configuration.numberBatches = options->numberBatches;
+	configuration.device = &device;
+	configuration.physicalDeviceProperties = &physicalDeviceProperties;
+	sprintf(configuration.shaderPath, SHADER_DIR);
+	for (uint32_t i = 0; i < 3; i++) result->size[i] = configuration.size[i];
+	result->FFTdim = configuration.FFTdim;
+
+	VkFFTApplication app = {};
+	VkFFTMemoryRequirements requirements = app.getMemoryRequirements(configuration);
+	VkDeviceSize bufferSize = requirements.bufferSize;
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	if (!allocateBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize)) {
+		fprintf(stderr, "System %dx%dx%d: could not allocate %llu bytes\n", configuration.size[0], configuration.size[1], configuration.size[2], (unsigned long long)bufferSize);
+		return false;
+	}
+	configuration.buffer = &buffer;
+	configuration.inputBuffer = &buffer;
+	configuration.outputBuffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.inputBufferSize = &bufferSize;
+	configuration.outputBufferSize = &bufferSize;
+	fillBuffer(&buffer, bufferSize);
+
+	auto timePlan = std::chrono::steady_clock::now();
+	VkResult res = app.initializeVulkanFFT(configuration);
+	auto timePlanEnd = std::chrono::steady_clock::now();
+	if (res != VK_SUCCESS) {
+		fprintf(stderr, "System %dx%dx%d: could not initialize the application (%d)\n", configuration.size[0], configuration.size[1], configuration.size[2], res);
+		app.deleteVulkanFFT();
+		vkDestroyBuffer(device, buffer, NULL);
+		vkFreeMemory(device, bufferDeviceMemory, NULL);
+		return false;
+	}
+	result->planTime = std::chrono::duration_cast<std::chrono::microseconds>(timePlanEnd - timePlan).count() * 0.001f;
+
+	//one reusable command buffer - a single VkFFTAppend between two timestamps
+	result->isTimestamp = (timestampValidBits > 0);
+	VkQueryPool queryPool = {};
+	if (result->isTimestamp) {
+		VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = 2;
+		vkCreateQueryPool(device, &queryPoolCreateInfo, NULL, &queryPool);
+	}
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	if (result->isTimestamp) {
+		vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+	}
+	app.VkFFTAppend(commandBuffer);
+	if (result->isTimestamp)
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+	vkEndCommandBuffer(commandBuffer);
+
+	for (uint32_t i = 0; i < options->warmup; i++)
+		submitAndWait(commandBuffer);
+	std::vector<float> times(options->iterations);
+	for (uint32_t i = 0; i < options->iterations; i++) {
+		auto timeSubmit = std::chrono::steady_clock::now();
+		submitAndWait(commandBuffer);
+		auto timeEnd = std::chrono::steady_clock::now();
+		if (result->isTimestamp) {
+			uint64_t timestamps[2] = { 0,0 };
+			vkGetQueryPoolResults(device, queryPool, 0, 2, sizeof(uint64_t) * 2, timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+			times[i] = (timestamps[1] - timestamps[0]) * physicalDeviceProperties.limits.timestampPeriod * 0.000001f;
+		}
+		else
+			times[i] = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeSubmit).count() * 0.001f;
+	}
+	std::sort(times.begin(), times.end());
+	result->minTime = times[0];
+	result->maxTime = times[times.size() - 1];
+	result->medianTime = percentile(times, 0.5f);
+	result->p90Time = percentile(times, 0.9f);
+	result->p99Time = percentile(times, 0.99f);
+	result->meanTime = 0;
+	for (uint32_t i = 0; i < times.size(); i++) result->meanTime += times[i] / times.size();
+
+	double flops = transformFlops(&configuration);
+	result->gflops = (result->medianTime > 0) ? flops / (result->medianTime * 1e6) : 0;
+	result->bytesMoved = requirements.bytesRead + requirements.bytesWritten;
+	result->numPasses = requirements.numPasses;
+	result->bandwidth = (result->medianTime > 0) ? result->bytesMoved / (result->medianTime * 1e6) : 0;
+	result->bufferBandwidth = (result->medianTime > 0) ? 2.0 * bufferSize / (result->medianTime * 1e6) : 0;
+
+	//CPU cost per call of recording the transform every time, against executing a secondary command buffer recorded once. Only command buffer recording is timed, not allocation and submission
+	VkCommandBuffer secondaryCommandBuffer = {};
+	app.VkFFTRecordCommandBuffer(commandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, &secondaryCommandBuffer);
+	double recordTime[2] = { 0, 0 };
+	for (uint32_t i = 0; i < options->iterations; i++) {
+		for (uint32_t t = 0; t < 2; t++) {
+			VkCommandBuffer recordCommandBuffer = {};
+			vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &recordCommandBuffer);
+			auto timeStart = std::chrono::steady_clock::now();
+			vkBeginCommandBuffer(recordCommandBuffer, &commandBufferBeginInfo);
+			if (t == 0)
+				app.VkFFTAppend(recordCommandBuffer);
+			else
+				vkCmdExecuteCommands(recordCommandBuffer, 1, &secondaryCommandBuffer);
+			vkEndCommandBuffer(recordCommandBuffer);
+			auto timeEnd = std::chrono::steady_clock::now();
+			recordTime[t] += std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count() * 0.000001;
+			vkFreeCommandBuffers(device, commandPool, 1, &recordCommandBuffer);
+		}
+	}
+	result->recordTime = recordTime[0] / options->iterations;
+	result->executeRecordTime = recordTime[1] / options->iterations;
+	vkFreeCommandBuffers(device, commandPool, 1, &secondaryCommandBuffer);
+
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	if (result->isTimestamp) vkDestroyQueryPool(device, queryPool, NULL);
+	app.deleteVulkanFFT();
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	result->isGPU = true;
+	return true;
+}
+
+#ifdef VKFFT_CPU_BACKEND
+bool benchmarkSystemCPU(BenchmarkOptions* options, std::vector<uint32_t>& size, BenchmarkResult* result) {
+	//same configuration without a Vulkan device - the application runs on the CPU backend, timed with the CPU timer
+	VkFFTConfiguration configuration = {};
+	configuration.FFTdim = (options->FFTdim > 0) ? options->FFTdim : size.size();
+	for (uint32_t i = 0; i < 3; i++)
+		configuration.size[i] = ((i < size.size()) && (i < configuration.FFTdim)) ? size[i] : 1;
+	configuration.performR2C = options->performR2C;
+	configuration.inverse = options->inverse;
+	configuration.coordinateFeatures = options->coordinateFeatures;
+	configuration.numberBatches = options->numberBatches;
+	configuration.useCPU = true;
+	configuration.numberCPUThreads = options->numberCPUThreads;
+	for (uint32_t i = 0; i < 3; i++) result->size[i] = configuration.size[i];
+	result->FFTdim = configuration.FFTdim;
+
+	VkFFTApplication app = {};
+	uint64_t bufferSize = app.getMemoryRequirements(configuration).bufferSize;
+	float* buffer = (float*)malloc(bufferSize);
+	if (buffer == NULL) {
+		fprintf(stderr, "System %dx%dx%d: could not allocate %llu bytes of host memory\n", configuration.size[0], configuration.size[1], configuration.size[2], (unsigned long long)bufferSize);
+		return false;
+	}
+	uint32_t seed = 1;
+	for (uint64_t i = 0; i < bufferSize / sizeof(float); i++) {
+		seed = seed * 1664525 + 1013904223;
+		buffer[i] = 2.0f * (seed >> 8) / (1 << 24) - 1.0f;
+	}
+
+	auto timePlan = std::chrono::steady_clock::now();
+	app.initializeVulkanFFT(configuration);
+	auto timePlanEnd = std::chrono::steady_clock::now();
+	result->cpuPlanTime = std::chrono::duration_cast<std::chrono::microseconds>(timePlanEnd - timePlan).count() * 0.001f;
+
+	for (uint32_t i = 0; i < options->warmup; i++)
+		app.executeOnCPU(buffer);
+	std::vector<float> times(options->iterations);
+	for (uint32_t i = 0; i < options->iterations; i++) {
+		auto timeStart = std::chrono::steady_clock::now();
+		app.executeOnCPU(buffer);
+		auto timeEnd = std::chrono::steady_clock::now();
+		times[i] = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() * 0.001f;
+	}
+	std::sort(times.begin(), times.end());
+	result->cpuMinTime = times[0];
+	result->cpuMedianTime = percentile(times, 0.5f);
+	result->cpuGflops = (result->cpuMedianTime > 0) ? transformFlops(&configuration) / (result->cpuMedianTime * 1e6) : 0;
+
+	app.deleteVulkanFFT();
+	free(buffer);
+	result->isCPU = true;
+	return true;
+}
+#endif
+
+void writeJSON(FILE* fp, BenchmarkOptions* options, std::vector<BenchmarkResult>& results) {
+	fprintf(fp, "{\n\t\"device\": \"%s\", \"vendorID\": %d, \"deviceID\": %d, \"driverVersion\": %d, \"apiVersion\": %d,\n", physicalDeviceProperties.deviceName, physicalDeviceProperties.vendorID, physicalDeviceProperties.deviceID, physicalDeviceProperties.driverVersion, physicalDeviceProperties.apiVersion);
+	fprintf(fp, "\t\"R2C\": %s, \"inverse\": %s, \"precision\": \"%s\", \"coordinateFeatures\": %d, \"numberBatches\": %d, \"iterations\": %d, \"warmup\": %d, \"cpuThreads\": %d,\n\t\"results\": [\n", (options->performR2C) ? "true" : "false", (options->inverse) ? "true" : "false", options->precision, options->coordinateFeatures, options->numberBatches, options->iterations, options->warmup, options->numberCPUThreads);
+	for (uint32_t i = 0; i < results.size(); i++) {
+		BenchmarkResult* r = &results[i];
+		fprintf(fp, "\t\t{ \"size\": [%d, %d, %d], \"FFTdim\": %d, ", r->size[0], r->size[1], r->size[2], r->FFTdim);
+		if (r->isCPU)
+			fprintf(fp, "\"cpuPlanTime\": %.3f, \"cpuMinTime\": %.4f, \"cpuMedianTime\": %.4f, \"cpuGflops\": %.2f%s", r->cpuPlanTime, r->cpuMinTime, r->cpuMedianTime, r->cpuGflops, (r->isGPU) ? ", " : "");
+		if (r->isGPU) {
+			fprintf(fp, "\"timer\": \"%s\", \"planTime\": %.3f, \"minTime\": %.4f, \"medianTime\": %.4f, \"p90Time\": %.4f, \"p99Time\": %.4f, \"maxTime\": %.4f, \"meanTime\": %.4f, ", (r->isTimestamp) ? "gpu" : "cpu", r->planTime, r->minTime, r->medianTime, r->p90Time, r->p99Time, r->maxTime, r->meanTime);
+			fprintf(fp, "\"gflops\": %.2f, \"bandwidth\": %.2f, \"bufferBandwidth\": %.2f, \"bytesMoved\": %llu, \"numPasses\": %d, \"recordTime\": %.5f, \"executeRecordTime\": %.5f", r->gflops, r->bandwidth, r->bufferBandwidth, (unsigned long long)r->bytesMoved, r->numPasses, r->recordTime, r->executeRecordTime);
+		}
+		fprintf(fp, " }%s\n", (i == results.size() - 1) ? "" : ",");
+	}
+	fprintf(fp, "\t]\n}\n");
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkOptions options = {};
+	if (!parseOptions(argc, argv, &options)) return 1;
+	bool isDevice = createDevice(options.deviceID);
+	if (!isDevice) {
+		if (!options.cpu) return 1;
+		fprintf(stderr, "Timing only the CPU backend\n");
+	}
+
+	std::vector<BenchmarkResult> results;
+	for (uint32_t i = 0; i < options.sizes.size(); i++) {
+		BenchmarkResult result = {};
+		//human readable progress goes to stderr, so stdout only holds JSON
+		if ((isDevice) && (benchmarkSystem(&options, options.sizes[i], &result)))
+			fprintf(stderr, "System: %dx%dx%d, plan: %.3f ms, median: %.4f ms, p90: %.4f ms, p99: %.4f ms, %.2f GFLOPS, %.2f GB/s, CPU recording: %.4f ms, pre-recorded: %.4f ms\n", result.size[0], result.size[1], result.size[2], result.planTime, result.medianTime, result.p90Time, result.p99Time, result.gflops, result.bandwidth, result.recordTime, result.executeRecordTime);
+#ifdef VKFFT_CPU_BACKEND
+		if ((options.cpu) && (benchmarkSystemCPU(&options, options.sizes[i], &result)))
+			fprintf(stderr, "System: %dx%dx%d, CPU backend plan: %.3f ms, median: %.4f ms, %.2f GFLOPS\n", result.size[0], result.size[1], result.size[2], result.cpuPlanTime, result.cpuMedianTime, result.cpuGflops);
+#endif
+		if ((result.isGPU) || (result.isCPU))
+			results.push_back(result);
+	}
+	FILE* fp = stdout;
+	if (options.outputPath[0] != 0) {
+		fp = fopen(options.outputPath, "w");
+		if (fp == NULL) {
+			printf("Could not open output file: %s\n", options.outputPath);
+			return 1;
+		}
+	}
+	writeJSON(fp, &options, results);
+	if (fp != stdout) fclose(fp);
+
+	if (isDevice) {
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		vkDestroyInstance(instance, NULL);
+	}
+	return 0;
+}
@@ -0,0 +1,854 @@
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+#include <vkFFT.h>
+#include <vulkan/vulkan.h>
+
+//Accuracy validation of VkFFT. Every plan type is compared with a double precision CPU reference: C2C, R2C/C2R, all register-boosted shaders, multi-upload sequences, 1x1 and matrix convolutions, zeropadding, output pruning and batched multi-kernel convolutions. L2 and max relative errors of every check are printed.
+//With VKFFT_CPU_BACKEND defined, C2C, R2C, four-step, zeropadding, pruning and convolution checks are repeated on the CPU backend with 1, 2 and all hardware threads. Its forward results are compared in the storage order of the plan for the validated device.
+//Usage: VkFFT_validation [-device ID]
+//Exits with 0 if all checks passed and with 1 if any check failed or no Vulkan device could be created. Runs on software implementations (lavapipe, SwiftShader), so it is registered as a CTest test and can be used as a regression check without a GPU.
+
+VkInstance instance = {};
+VkPhysicalDevice physicalDevice = {};
+VkPhysicalDeviceProperties physicalDeviceProperties = {};
+VkDevice device = {};
+uint32_t queueFamilyIndex = {};
+VkQueue queue = {};
+VkCommandPool commandPool = {};
+VkFence fence = {};
+VkFFTStagingPool stagingPool = {};
+
+bool createDevice(uint32_t deviceID) {
+	VkApplicationInfo applicationInfo = { VK_STRUCTURE_TYPE_APPLICATION_INFO };
+	applicationInfo.pApplicationName = "VkFFT_validation";
+	applicationInfo.pEngineName = "VkFFT";
+	applicationInfo.apiVersion = VK_API_VERSION_1_0;
+	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
+	createInfo.pApplicationInfo = &applicationInfo;
+	if (vkCreateInstance(&createInfo, NULL, &instance) != VK_SUCCESS) {
+		fprintf(stderr, "Instance creation failed\n");
+		return false;
+	}
+	uint32_t deviceCount = 0;
+	vkEnumeratePhysicalDevices(instance, &deviceCount, NULL);
+	if (deviceID >= deviceCount) {
+		fprintf(stderr, "Device %d not found, %d devices with Vulkan support available\n", deviceID, deviceCount);
+		return false;
+	}
+	std::vector<VkPhysicalDevice> devices(deviceCount);
+	vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+	physicalDevice = devices[deviceID];
+	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	for (queueFamilyIndex = 0; queueFamilyIndex < queueFamilyCount; queueFamilyIndex++) {
+		if ((queueFamilies[queueFamilyIndex].queueCount > 0) && (queueFamilies[queueFamilyIndex].queueFlags & VK_QUEUE_COMPUTE_BIT)) break;
+	}
+	if (queueFamilyIndex == queueFamilyCount) {
+		fprintf(stderr, "Device has no compute queue\n");
+		return false;
+	}
+
+	VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
+	float queuePriorities = 1.0;
+	queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+	queueCreateInfo.queueCount = 1;
+	queueCreateInfo.pQueuePriorities = &queuePriorities;
+	VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
+	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+	deviceCreateInfo.queueCreateInfoCount = 1;
+	if (vkCreateDevice(physicalDevice, &deviceCreateInfo, NULL, &device) != VK_SUCCESS) {
+		fprintf(stderr, "Device creation failed\n");
+		return false;
+	}
+	vkGetDeviceQueue(device, queueFamilyIndex, 0, &queue);
+	VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+	vkCreateFence(device, &fenceCreateInfo, NULL, &fence);
+	VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+	vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
+	//3 slots of 16MB - bigger transfers are streamed through the ring
+	if (!stagingPool.initializeStagingPool(&device, &physicalDevice, &queue, &commandPool, 16 * 1024 * 1024, 3)) return false;
+	return true;
+}
+
+uint32_t findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) {
+	VkPhysicalDeviceMemoryProperties memoryProperties = {};
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+	for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+		if ((memoryTypeBits & (1 << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & properties) == properties))
+			return i;
+	}
+	return -1;
+}
+void allocateFFTBuffer(VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags propertyFlags, VkDeviceSize size) {
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usageFlags;
+	vkCreateBuffer(device, &bufferCreateInfo, NULL, buffer);
+	VkMemoryRequirements memoryRequirements = {};
+	vkGetBufferMemoryRequirements(device, buffer[0], &memoryRequirements);
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = findMemoryType(memoryRequirements.memoryTypeBits, propertyFlags);
+	vkAllocateMemory(device, &memoryAllocateInfo, NULL, deviceMemory);
+	vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
+}
+void transferDataFromCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
+	stagingPool.transferDataFromCPU(arr, buffer, bufferSize);
+}
+void transferDataToCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
+	stagingPool.transferDataToCPU(arr, buffer, bufferSize);
+}
+void submitAndWait(VkCommandBuffer commandBuffer) {
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
+}
+VkCommandBuffer beginCommandBuffer() {
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	return commandBuffer;
+}
+void performVulkanFFT(VkFFTApplication* app) {
+	VkCommandBuffer commandBuffer = beginCommandBuffer();
+	app->VkFFTAppend(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+	submitAndWait(commandBuffer);
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+void prepareConvolutionKernel(VkFFTConvolutionKernel* kernel_cache) {
+	if (kernel_cache->isPrepared) return;
+	VkCommandBuffer commandBuffer = beginCommandBuffer();
+	kernel_cache->appendConvolutionKernelPreparation(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+	submitAndWait(commandBuffer);
+	kernel_cache->markPrepared();
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+void performAccuracyFFT(VkFFTApplication* app, VkBuffer* buffer, VkDeviceSize bufferSize, float* input, float* output) {
+	//runs the application on input and reads its result to output. CPU backend applications transform a host copy, the device buffer is not used
+#ifdef VKFFT_CPU_BACKEND
+	if (app->isCPUBackend) {
+		if (output != input) memcpy(output, input, bufferSize);
+		app->executeOnCPU(output);
+		return;
+	}
+#endif
+	transferDataFromCPU(input, buffer, bufferSize);
+	performVulkanFFT(app);
+	transferDataToCPU(output, buffer, bufferSize);
+}
+void appendAccuracyBackendName(char* caseName, VkFFTConfiguration* configuration) {
+#ifdef VKFFT_CPU_BACKEND
+	if (!configuration->useCPU) return;
+	if (configuration->numberCPUThreads > 0)
+		sprintf(caseName + strlen(caseName), ", CPU backend with %d threads", configuration->numberCPUThreads);
+	else
+		sprintf(caseName + strlen(caseName), ", CPU backend with all threads");
+#endif
+}
+
+//Reference transforms are computed on CPU in double precision with radix-2 FFT. VkFFT forward transform uses exp(2*pi*i*j*k/N), inverse transform uses exp(-2*pi*i*j*k/N) and is normalized by 1/N. referenceFFT is not normalized in both directions.
+void referenceFFT1D(double* data, uint32_t size, uint64_t stride, bool inverse, double* temp) {
+	//transforms size complex numbers located stride complex numbers apart. temp holds 2*size doubles
+	for (uint32_t i = 0; i < size; i++) {
+		uint32_t reversed = 0;
+		for (uint32_t bit = 1, rbit = size >> 1; bit < size; bit <<= 1, rbit >>= 1)
+			if (i & bit) reversed |= rbit;
+		temp[2 * reversed] = data[2 * i * stride];
+		temp[2 * reversed + 1] = data[2 * i * stride + 1];
+	}
+	double sign = (inverse) ? -1.0 : 1.0;
+	for (uint32_t len = 2; len <= size; len <<= 1) {
+		for (uint32_t k = 0; k < len / 2; k++) {
+			double angle = sign * 2 * M_PI * k / len;
+			double w_re = cos(angle);
+			double w_im = sin(angle);
+			for (uint32_t i = k; i < size; i += len) {
+				double* v0 = temp + 2 * i;
+				double* v1 = temp + 2 * (i + len / 2);
+				double t_re = v1[0] * w_re - v1[1] * w_im;
+				double t_im = v1[0] * w_im + v1[1] * w_re;
+				v1[0] = v0[0] - t_re;
+				v1[1] = v0[1] - t_im;
+				v0[0] += t_re;
+				v0[1] += t_im;
+			}
+		}
+	}
+	for (uint32_t i = 0; i < size; i++) {
+		data[2 * i * stride] = temp[2 * i];
+		data[2 * i * stride + 1] = temp[2 * i + 1];
+	}
+}
+void referenceFFT(double* data, uint32_t* size, uint32_t FFTdim, bool inverse) {
+	//in-place multidimensional FFT of size[0]*size[1]*size[2] complex numbers, x is the fastest dimension
+	uint64_t stride[3] = { 1, size[0], (uint64_t)size[0] * size[1] };
+	uint64_t totalSize = (uint64_t)size[0] * size[1] * size[2];
+	uint32_t maxSize = (size[0] > size[1]) ? size[0] : size[1];
+	if (size[2] > maxSize) maxSize = size[2];
+	double* temp = (double*)malloc(2 * sizeof(double) * maxSize);
+	for (uint32_t axis = 0; axis < FFTdim; axis++) {
+		for (uint64_t start = 0; start < totalSize; start++) {
+			if ((start / stride[axis]) % size[axis] != 0) continue; //start has to be the first element of the sequence
+			referenceFFT1D(data + 2 * start, size[axis], stride[axis], inverse, temp);
+		}
+	}
+	free(temp);
+}
+bool printAccuracy(const char* caseName, double* reference, double* result, uint64_t count, uint32_t* numPassed, uint32_t* numCases) {
+	//L2 relative error: ||result - reference|| / ||reference||. Max relative error: max|result - reference| / max|reference|
+	const double l2Tolerance = 1e-5;
+	const double maxTolerance = 1e-4;
+	double differenceNorm = 0;
+	double referenceNorm = 0;
+	double maxDifference = 0;
+	double maxReference = 0;
+	for (uint64_t i = 0; i < count; i++) {
+		double difference = fabs(result[i] - reference[i]);
+		differenceNorm += difference * difference;
+		referenceNorm += reference[i] * reference[i];
+		if (difference > maxDifference) maxDifference = difference;
+		if (fabs(reference[i]) > maxReference) maxReference = fabs(reference[i]);
+	}
+	double l2Error = (referenceNorm > 0) ? sqrt(differenceNorm / referenceNorm) : sqrt(differenceNorm);
+	double maxError = (maxReference > 0) ? maxDifference / maxReference : maxDifference;
+	bool passed = (l2Error < l2Tolerance) && (maxError < maxTolerance);
+	printf("%s: L2 relative error: %e, max relative error: %e - %s\n", caseName, l2Error, maxError, (passed) ? "passed" : "FAILED");
+	numCases[0]++;
+	if (passed) numPassed[0]++;
+	return passed;
+}
+uint64_t getAccuracyBufferIndex(VkFFTConfiguration* configuration, uint32_t i, uint32_t j, uint32_t k, uint64_t system) {
+	//index of the real part of the element in the float buffer. R2C systems have each x*y plane padded to (x+2)*y
+	uint32_t* size = configuration->size;
+	if (configuration->performR2C)
+		return i + (uint64_t)j * size[0] + (uint64_t)k * (size[0] + 2) * size[1] + system * (size[0] + 2) * size[1] * size[2];
+	else
+		return 2 * (i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1] + system * size[0] * size[1] * size[2]);
+}
+uint32_t getAccuracyUploadLengths(VkFFTApplication* app, uint32_t axis, bool isSupportAxis, uint32_t* lengths) {
+	//number and lengths of the uploads the axis is done in. Support axes transform the last x column of R2C y and z axes
+#ifdef VKFFT_CPU_BACKEND
+	if (app->isCPUBackend) {
+		VkFFTConfiguration* configuration = &app->configuration;
+		//CPU backend stores axes in the order of the plan for the configured device, except the R2C x axis, which is stored in natural order
+		if ((axis == 0) && (configuration->performR2C)) {
+			lengths[0] = configuration->size[0];
+			return 1;
+		}
+		VkFFTStagePlan stagePlan;
+		if (isSupportAxis)
+			app->VkFFTPlanStages(&stagePlan, log2(configuration->size[axis]), (axis > 1), configuration->size[1], configuration->groupedBatch[axis]);
+		else
+			app->VkFFTPlanStages(&stagePlan, log2(configuration->size[axis]), (axis > 0), (configuration->performR2C) ? configuration->size[0] / 2 : configuration->size[0], configuration->groupedBatch[axis]);
+		for (uint32_t u = 0; u < stagePlan.numPasses; u++)
+			lengths[u] = 1 << stagePlan.logSize[u];
+		return stagePlan.numPasses;
+	}
+#endif
+	VkFFTAxis* uploads = (isSupportAxis) ? app->localFFTPlan.supportAxes[axis - 1] : app->localFFTPlan.axes[axis];
+	uint32_t numUploads = (isSupportAxis) ? app->localFFTPlan.numSupportAxisUploads[axis - 1] : app->localFFTPlan.numAxisUploads[axis];
+	for (uint32_t u = 0; u < numUploads; u++)
+		lengths[u] = uploads[u].specializationConstants.fftDim;
+	return numUploads;
+}
+uint32_t* getAccuracyStorageOrder(uint32_t* lengths, uint32_t numUploads, uint32_t size) {
+	//frequency stored at each index of an axis. An axis done in several uploads is left in four-step order: digit u of the index, in base of the length of upload u, holds digit numUploads - 1 - u of the frequency
+	uint32_t* order = (uint32_t*)malloc(size * sizeof(uint32_t));
+	for (uint32_t s = 0; s < size; s++) {
+		uint32_t frequency = 0;
+		uint32_t rest = s;
+		for (uint32_t u = 0; u < numUploads; u++) {
+			uint32_t length = lengths[u];
+			frequency = frequency * length + rest % length;
+			rest /= length;
+		}
+		order[s] = (numUploads > 1) ? frequency : s;
+	}
+	return order;
+}
+double getAccuracyRandom() {
+	//value in [-1,1], rounded to float so that the GPU and the reference get the same input
+	return (float)(2.0 * rand() / RAND_MAX - 1.0);
+}
+void checkFFTAccuracy(VkFFTConfiguration configuration, uint32_t* numPassed, uint32_t* numCases) {
+	//Forward FFT is checked against the reference permuted in the storage order of the plan - multi-upload axes store forward result in the four-step order. The R2C x axis done in several uploads has no defined order, its forward check is skipped. Inverse FFT of the forward result is checked against the input in all cases.
+	uint32_t* size = configuration.size;
+	uint64_t totalSize = (uint64_t)size[0] * size[1] * size[2];
+	VkDeviceSize bufferSize = ((configuration.performR2C) ? (uint64_t)(size[0] + 2) * size[1] * size[2] : 2 * totalSize) * sizeof(float);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, bufferSize);
+	configuration.coordinateFeatures = 1;
+	configuration.device = &device;
+	configuration.physicalDeviceProperties = &physicalDeviceProperties;
+	configuration.buffer = &buffer;
+	configuration.inputBuffer = &buffer;
+	configuration.outputBuffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.inputBufferSize = &bufferSize;
+	configuration.outputBufferSize = &bufferSize;
+	sprintf(configuration.shaderPath, SHADER_DIR);
+	char caseName[256];
+	sprintf(caseName, "%s %dD %dx%dx%d registerBoost %d", (configuration.performR2C) ? "R2C" : "C2C", configuration.FFTdim, size[0], size[1], size[2], configuration.registerBoost);
+	appendAccuracyBackendName(caseName, &configuration);
+	//a configuration that can't be planned is a failed check
+	VkFFTApplication app_forward;
+	VkFFTApplication app_inverse;
+	configuration.inverse = false;
+	VkResult res = app_forward.initializeVulkanFFT(configuration);
+	if (res == VK_SUCCESS) {
+		configuration.inverse = true;
+		res = app_inverse.initializeVulkanFFT(configuration);
+		if (res != VK_SUCCESS) app_inverse.deleteVulkanFFT();
+	}
+	if (res != VK_SUCCESS) {
+		printf("%s: initialization failed, error %d - FAILED\n", caseName, res);
+		numCases[0]++;
+		app_forward.deleteVulkanFFT();
+		vkDestroyBuffer(device, buffer, NULL);
+		vkFreeMemory(device, bufferDeviceMemory, NULL);
+		return;
+	}
+
+	float* buffer_input = (float*)calloc(bufferSize / sizeof(float), sizeof(float));
+	float* buffer_output = (float*)malloc(bufferSize);
+	double* input = (double*)calloc(2 * totalSize, sizeof(double));
+	double* reference = (double*)malloc(2 * totalSize * sizeof(double));
+	double* result = (double*)malloc(2 * totalSize * sizeof(double));
+	for (uint32_t k = 0; k < size[2]; k++) {
+		for (uint32_t j = 0; j < size[1]; j++) {
+			for (uint32_t i = 0; i < size[0]; i++) {
+				uint64_t id = i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1];
+				uint64_t bufferId = getAccuracyBufferIndex(&configuration, i, j, k, 0);
+				input[2 * id] = getAccuracyRandom();
+				buffer_input[bufferId] = input[2 * id];
+				if (!configuration.performR2C) {
+					input[2 * id + 1] = getAccuracyRandom();
+					buffer_input[bufferId + 1] = input[2 * id + 1];
+				}
+			}
+		}
+	}
+
+	//1. Forward FFT. R2C stores size[0]/2+1 complex numbers per x sequence.
+	performAccuracyFFT(&app_forward, &buffer, bufferSize, buffer_input, buffer_output);
+	char stepName[256];
+	sprintf(stepName, "%s forward", caseName);
+	uint32_t lengths[3][5];
+	uint32_t numUploads[3];
+	for (uint32_t i = 0; i < 3; i++) {
+		numUploads[i] = 1;
+		lengths[i][0] = size[i];
+		if (i < configuration.FFTdim) numUploads[i] = getAccuracyUploadLengths(&app_forward, i, false, lengths[i]);
+	}
+	if ((configuration.performR2C) && (numUploads[0] > 1)) {
+		printf("%s: R2C x axis is done in %d uploads, forward order is not defined - skipped\n", stepName, numUploads[0]);
+	}
+	else {
+		//storage order of every axis, R2C y and z axes store the last x column with the support axis uploads
+		uint32_t* order[3];
+		uint32_t* supportOrder[2] = { NULL, NULL };
+		for (uint32_t i = 0; i < 3; i++) {
+			order[i] = getAccuracyStorageOrder(lengths[i], numUploads[i], size[i]);
+			if ((i > 0) && (i < configuration.FFTdim) && (configuration.performR2C)) {
+				uint32_t supportLengths[5];
+				uint32_t numSupportUploads = getAccuracyUploadLengths(&app_forward, i, true, supportLengths);
+				supportOrder[i - 1] = getAccuracyStorageOrder(supportLengths, numSupportUploads, size[i]);
+			}
+		}
+		double* transformed = (double*)malloc(2 * totalSize * sizeof(double));
+		memcpy(transformed, input, 2 * totalSize * sizeof(double));
+		referenceFFT(transformed, size, configuration.FFTdim, false);
+		uint32_t storedSize = (configuration.performR2C) ? size[0] / 2 + 1 : size[0];
+		uint64_t count = 0;
+		for (uint32_t k = 0; k < size[2]; k++) {
+			for (uint32_t j = 0; j < size[1]; j++) {
+				for (uint32_t i = 0; i < storedSize; i++) {
+					bool lastColumn = (configuration.performR2C) && (i == size[0] / 2);
+					uint32_t frequency_j = ((lastColumn) && (supportOrder[0])) ? supportOrder[0][j] : order[1][j];
+					uint32_t frequency_k = ((lastColumn) && (supportOrder[1])) ? supportOrder[1][k] : order[2][k];
+					uint64_t id = order[0][i] + (uint64_t)frequency_j * size[0] + (uint64_t)frequency_k * size[0] * size[1];
+					uint64_t bufferId = 2 * (i + (uint64_t)j * storedSize + (uint64_t)k * storedSize * size[1]);
+					reference[count] = transformed[2 * id];
+					reference[count + 1] = transformed[2 * id + 1];
+					result[count] = buffer_output[bufferId];
+					result[count + 1] = buffer_output[bufferId + 1];
+					count += 2;
+				}
+			}
+		}
+		printAccuracy(stepName, reference, result, count, numPassed, numCases);
+		free(transformed);
+		for (uint32_t i = 0; i < 3; i++) free(order[i]);
+		for (uint32_t i = 0; i < 2; i++) free(supportOrder[i]);
+	}
+
+	//2. Inverse FFT of the forward result has to be equal to the input.
+	performAccuracyFFT(&app_inverse, &buffer, bufferSize, buffer_output, buffer_output);
+	uint64_t count = 0;
+	for (uint32_t k = 0; k < size[2]; k++) {
+		for (uint32_t j = 0; j < size[1]; j++) {
+			for (uint32_t i = 0; i < size[0]; i++) {
+				uint64_t id = i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1];
+				uint64_t bufferId = getAccuracyBufferIndex(&configuration, i, j, k, 0);
+				reference[count] = input[2 * id];
+				result[count] = buffer_output[bufferId];
+				count++;
+				if (!configuration.performR2C) {
+					reference[count] = input[2 * id + 1];
+					result[count] = buffer_output[bufferId + 1];
+					count++;
+				}
+			}
+		}
+	}
+	sprintf(stepName, "%s %s", caseName, (configuration.performR2C) ? "R2C + C2R" : "forward + inverse");
+	printAccuracy(stepName, reference, result, count, numPassed, numCases);
+
+	free(buffer_input);
+	free(buffer_output);
+	free(input);
+	free(reference);
+	free(result);
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	app_forward.deleteVulkanFFT();
+	app_inverse.deleteVulkanFFT();
+}
+void checkPruningAccuracy(VkFFTConfiguration configuration, uint32_t prunedAxis, uint32_t* numPassed, uint32_t* numCases) {
+	//Forward FFT with performOutputPruning stores only outputPruningRange of the pruned axis, in frequency order. Elements in the window are checked against the reference. Axes done in more than one upload can't be pruned - initialization has to fail for them.
+	uint32_t* size = configuration.size;
+	uint64_t totalSize = (uint64_t)size[0] * size[1] * size[2];
+	VkDeviceSize bufferSize = ((configuration.performR2C) ? (uint64_t)(size[0] + 2) * size[1] * size[2] : 2 * totalSize) * sizeof(float);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, bufferSize);
+	configuration.coordinateFeatures = 1;
+	configuration.inverse = false;
+	configuration.device = &device;
+	configuration.physicalDeviceProperties = &physicalDeviceProperties;
+	configuration.buffer = &buffer;
+	configuration.inputBuffer = &buffer;
+	configuration.outputBuffer = &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.inputBufferSize = &bufferSize;
+	configuration.outputBufferSize = &bufferSize;
+	sprintf(configuration.shaderPath, SHADER_DIR);
+	char caseName[256];
+	sprintf(caseName, "%s %dD %dx%dx%d pruning of axis %d to [%d, %d)", (configuration.performR2C) ? "R2C" : "C2C", configuration.FFTdim, size[0], size[1], size[2], prunedAxis, configuration.outputPruningRange[prunedAxis][0], configuration.outputPruningRange[prunedAxis][1]);
+	appendAccuracyBackendName(caseName, &configuration);
+	VkFFTApplication app;
+	VkResult res = app.initializeVulkanFFT(configuration);
+	if (res != VK_SUCCESS) app.deleteVulkanFFT();
+	//a pruned axis has to be planned in one upload on the device for the check to be meaningful - otherwise the plan has to be rejected
+	VkFFTApplication planner;
+	planner.configuration = configuration;
+	planner.VkFFTDetectDeviceLimits();
+	VkFFTStagePlan stagePlan;
+	planner.VkFFTPlanStages(&stagePlan, log2(size[prunedAxis]), (prunedAxis > 0), (configuration.performR2C) ? size[0] / 2 : size[0], configuration.groupedBatch[prunedAxis]);
+	if (stagePlan.numPasses > 1) {
+		bool isRejected = (res != VK_SUCCESS);
+		printf("%s: axis is done in %d uploads, initialization %s - %s\n", caseName, stagePlan.numPasses, (isRejected) ? "failed" : "succeeded", (isRejected) ? "passed" : "FAILED");
+		numCases[0]++;
+		if (isRejected) numPassed[0]++;
+		else app.deleteVulkanFFT();
+		vkDestroyBuffer(device, buffer, NULL);
+		vkFreeMemory(device, bufferDeviceMemory, NULL);
+		return;
+	}
+	if (res != VK_SUCCESS) {
+		printf("%s: initialization failed, error %d - FAILED\n", caseName, res);
+		numCases[0]++;
+		vkDestroyBuffer(device, buffer, NULL);
+		vkFreeMemory(device, bufferDeviceMemory, NULL);
+		return;
+	}
+	float* buffer_input = (float*)calloc(bufferSize / sizeof(float), sizeof(float));
+	float* buffer_output = (float*)malloc(bufferSize);
+	double* reference = (double*)calloc(2 * totalSize, sizeof(double));
+	double* result = (double*)malloc(2 * totalSize * sizeof(double));
+	for (uint32_t k = 0; k < size[2]; k++) {
+		for (uint32_t j = 0; j < size[1]; j++) {
+			for (uint32_t i = 0; i < size[0]; i++) {
+				uint64_t id = i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1];
+				uint64_t bufferId = getAccuracyBufferIndex(&configuration, i, j, k, 0);
+				reference[2 * id] = getAccuracyRandom();
+				buffer_input[bufferId] = reference[2 * id];
+				if (!configuration.performR2C) {
+					reference[2 * id + 1] = getAccuracyRandom();
+					buffer_input[bufferId + 1] = reference[2 * id + 1];
+				}
+			}
+		}
+	}
+	performAccuracyFFT(&app, &buffer, bufferSize, buffer_input, buffer_output);
+	referenceFFT(reference, size, configuration.FFTdim, false);
+	uint32_t storedSize = (configuration.performR2C) ? size[0] / 2 + 1 : size[0];
+	uint64_t count = 0;
+	for (uint32_t k = 0; k < size[2]; k++) {
+		for (uint32_t j = 0; j < size[1]; j++) {
+			for (uint32_t i = 0; i < storedSize; i++) {
+				uint32_t position[3] = { i, j, k };
+				if ((position[prunedAxis] < configuration.outputPruningRange[prunedAxis][0]) || (position[prunedAxis] >= configuration.outputPruningRange[prunedAxis][1])) continue;
+				uint64_t id = i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1];
+				uint64_t bufferId = 2 * (i + (uint64_t)j * storedSize + (uint64_t)k * storedSize * size[1]);
+				result[count] = buffer_output[bufferId];
+				result[count + 1] = buffer_output[bufferId + 1];
+				reference[count] = reference[2 * id];
+				reference[count + 1] = reference[2 * id + 1];
+				count += 2;
+			}
+		}
+	}
+	printAccuracy(caseName, reference, result, count, numPassed, numCases);
+
+	free(buffer_input);
+	free(buffer_output);
+	free(reference);
+	free(result);
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	app.deleteVulkanFFT();
+}
+void checkConvolutionAccuracy(VkFFTConfiguration configuration, uint32_t* numPassed, uint32_t* numCases) {
+	//Convolution result is equal to the reference inverse FFT of the product of the reference forward FFTs of input and kernel (inverse FFT is normalized). Correlation multiplies by the complex conjugate of the kernel spectrum. With zeropadding, input and kernel are nonzero only in zeropadInputRange of each padded dimension and only zeropadOutputRange of the result is compared.
+	uint32_t* size = configuration.size;
+	uint64_t totalSize = (uint64_t)size[0] * size[1] * size[2];
+	uint32_t coordinates = configuration.coordinateFeatures;
+	uint32_t numberBatches = configuration.numberBatches;
+	uint32_t numberKernels = (configuration.matrixConvolution > 1) ? 1 : configuration.numberKernels;
+	uint32_t outputsPerBatch = numberKernels * coordinates;
+	uint32_t filledRange[3][2]; //[start, end) of nonzero input along each axis
+	uint32_t comparedRange[3][2];
+	for (uint32_t i = 0; i < 3; i++) {
+		bool isPadded = (i < configuration.FFTdim) && (configuration.performZeropadding[i]);
+		bool isDefaultInput = (configuration.zeropadInputRange[i][0] == 0) && (configuration.zeropadInputRange[i][1] == 0);
+		bool isDefaultOutput = (configuration.zeropadOutputRange[i][0] == 0) && (configuration.zeropadOutputRange[i][1] == 0);
+		filledRange[i][0] = (isPadded) ? configuration.zeropadInputRange[i][0] : 0;
+		filledRange[i][1] = (isPadded) ? ((isDefaultInput) ? size[i] / 2 : configuration.zeropadInputRange[i][1]) : size[i];
+		comparedRange[i][0] = (isPadded) ? configuration.zeropadOutputRange[i][0] : 0;
+		comparedRange[i][1] = (isPadded) ? ((isDefaultOutput) ? size[i] / 2 : configuration.zeropadOutputRange[i][1]) : size[i];
+	}
+	configuration.performConvolution = true;
+	configuration.inverse = false;
+	configuration.device = &device;
+	configuration.physicalDeviceProperties = &physicalDeviceProperties;
+	sprintf(configuration.shaderPath, SHADER_DIR);
+	char caseName[256];
+	sprintf(caseName, "%s %dD %dx%dx%d convolution %dx%d%s, coordinates: %d, inputs: %d, kernels: %d%s%s", (configuration.performR2C) ? "R2C" : "C2C", configuration.FFTdim, size[0], size[1], size[2], configuration.matrixConvolution, configuration.matrixConvolution, (configuration.matrixConvolution > 1) ? ((configuration.symmetricKernel) ? " symmetric" : " nonsymmetric") : "", coordinates, numberBatches, numberKernels, (configuration.performZeropadding[0]) ? ((filledRange[0][0] > 0) ? ", zeropadding of a centered window" : ", zeropadding") : "", (configuration.performCorrelation) ? ", correlation" : "");
+	appendAccuracyBackendName(caseName, &configuration);
+	uint64_t systemSize = (configuration.performR2C) ? (uint64_t)(size[0] + 2) * size[1] * size[2] : 2 * totalSize;
+
+	//1. Kernel systems are filled with random values and transformed by VkFFTConvolutionKernel.
+	VkFFTConvolutionKernel kernel_cache;
+	VkDeviceSize kernelSize = kernel_cache.getKernelBufferSize(configuration);
+	uint32_t kernelSystems = numberKernels * kernel_cache.getKernelCoordinates(configuration);
+	VkBuffer kernel = {};
+	VkDeviceMemory kernelDeviceMemory = {};
+	allocateFFTBuffer(&kernel, &kernelDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, kernelSize);
+	configuration.kernel = &kernel;
+	configuration.kernelSize = &kernelSize;
+	float* kernel_input = (float*)calloc(kernelSize / sizeof(float), sizeof(float));
+	double* kernel_reference = (double*)calloc(2 * totalSize * kernelSystems, sizeof(double));
+	//2. numberBatches inputs of coordinateFeatures systems. With more than one kernel results are stored in a separate output buffer.
+	VkDeviceSize bufferSize = numberBatches * coordinates * systemSize * sizeof(float);
+	VkDeviceSize outputBufferSize = numberBatches * outputsPerBatch * systemSize * sizeof(float);
+	VkBuffer buffer = {};
+	VkDeviceMemory bufferDeviceMemory = {};
+	VkBuffer outputBuffer = {};
+	VkDeviceMemory outputBufferDeviceMemory = {};
+	allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, bufferSize);
+	if (numberKernels > 1)
+		allocateFFTBuffer(&outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, outputBufferSize);
+	configuration.buffer = &buffer;
+	configuration.inputBuffer = &buffer;
+	configuration.outputBuffer = (numberKernels > 1) ? &outputBuffer : &buffer;
+	configuration.bufferSize = &bufferSize;
+	configuration.inputBufferSize = &bufferSize;
+	configuration.outputBufferSize = (numberKernels > 1) ? &outputBufferSize : &bufferSize;
+	VkFFTApplication app_convolution;
+	VkResult res = kernel_cache.initializeConvolutionKernel(configuration);
+	if (res == VK_SUCCESS) {
+		res = app_convolution.initializeVulkanFFT(configuration);
+		if (res != VK_SUCCESS) app_convolution.deleteVulkanFFT();
+	}
+	if (res != VK_SUCCESS) {
+		printf("%s: initialization failed, error %d - FAILED\n", caseName, res);
+		numCases[0]++;
+		kernel_cache.deleteConvolutionKernel();
+		vkDestroyBuffer(device, buffer, NULL);
+		vkFreeMemory(device, bufferDeviceMemory, NULL);
+		if (numberKernels > 1) {
+			vkDestroyBuffer(device, outputBuffer, NULL);
+			vkFreeMemory(device, outputBufferDeviceMemory, NULL);
+		}
+		vkDestroyBuffer(device, kernel, NULL);
+		vkFreeMemory(device, kernelDeviceMemory, NULL);
+		return;
+	}
+	float* buffer_input = (float*)calloc(bufferSize / sizeof(float), sizeof(float));
+	float* buffer_output = (float*)malloc(outputBufferSize);
+	double* input_reference = (double*)calloc(2 * totalSize * numberBatches * coordinates, sizeof(double));
+	for (uint32_t s = 0; s < kernelSystems + numberBatches * coordinates; s++) {
+		bool isKernel = (s < kernelSystems);
+		uint64_t system = (isKernel) ? s : s - kernelSystems;
+		double* reference = (isKernel) ? kernel_reference + 2 * totalSize * system : input_reference + 2 * totalSize * system;
+		float* data = (isKernel) ? kernel_input : buffer_input;
+		for (uint32_t k = filledRange[2][0]; k < filledRange[2][1]; k++) {
+			for (uint32_t j = filledRange[1][0]; j < filledRange[1][1]; j++) {
+				for (uint32_t i = filledRange[0][0]; i < filledRange[0][1]; i++) {
+					uint64_t id = i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1];
+					uint64_t bufferId = getAccuracyBufferIndex(&configuration, i, j, k, system);
+					reference[2 * id] = getAccuracyRandom();
+					data[bufferId] = reference[2 * id];
+					if (!configuration.performR2C) {
+						reference[2 * id + 1] = getAccuracyRandom();
+						data[bufferId + 1] = reference[2 * id + 1];
+					}
+				}
+			}
+		}
+		referenceFFT(reference, size, configuration.FFTdim, false);
+	}
+#ifdef VKFFT_CPU_BACKEND
+	if (app_convolution.isCPUBackend) {
+		kernel_cache.prepareConvolutionKernelOnCPU(kernel_input);
+		app_convolution.executeOnCPU(buffer_input, kernel_input, buffer_output);
+	}
+	else
+#endif
+	{
+		transferDataFromCPU(kernel_input, &kernel, kernelSize);
+		prepareConvolutionKernel(&kernel_cache);
+		transferDataFromCPU(buffer_input, &buffer, bufferSize);
+		performVulkanFFT(&app_convolution);
+		transferDataToCPU(buffer_output, (numberKernels > 1) ? &outputBuffer : &buffer, outputBufferSize);
+	}
+
+	//3. Reference convolution. 1x1: output b*numberKernels+f, coordinate v = input b, coordinate v times kernel f, coordinate v. NxN: output coordinate j = sum over k of kernel[j][k] times input coordinate k, symmetric kernel stores only the upper triangle.
+	uint64_t comparedSize = (uint64_t)(comparedRange[0][1] - comparedRange[0][0]) * (comparedRange[1][1] - comparedRange[1][0]) * (comparedRange[2][1] - comparedRange[2][0]);
+	uint32_t componentsPerElement = (configuration.performR2C) ? 1 : 2;
+	double* reference = (double*)malloc(numberBatches * outputsPerBatch * comparedSize * componentsPerElement * sizeof(double));
+	double* result = (double*)malloc(numberBatches * outputsPerBatch * comparedSize * componentsPerElement * sizeof(double));
+	double* product = (double*)malloc(2 * totalSize * sizeof(double));
+	uint64_t count = 0;
+	for (uint32_t b = 0; b < numberBatches; b++) {
+		for (uint32_t f = 0; f < numberKernels; f++) {
+			for (uint32_t v = 0; v < coordinates; v++) {
+				memset(product, 0, 2 * totalSize * sizeof(double));
+				for (uint32_t c = 0; c < coordinates; c++) {
+					uint64_t kernelSystem;
+					if (configuration.matrixConvolution > 1) {
+						uint32_t N = configuration.matrixConvolution;
+						uint32_t row = (v < c) ? v : c;
+						uint32_t column = (v < c) ? c : v;
+						kernelSystem = (configuration.symmetricKernel) ? row * N - row * (row - 1) / 2 + column - row : v * N + c;
+					}
+					else {
+						if (c != v) continue;
+						kernelSystem = f * coordinates + v;
+					}
+					double* kernelSpectrum = kernel_reference + 2 * totalSize * kernelSystem;
+					double* inputSpectrum = input_reference + 2 * totalSize * (b * coordinates + c);
+					double kernelImagSign = (configuration.performCorrelation) ? -1.0 : 1.0;
+					for (uint64_t id = 0; id < totalSize; id++) {
+						double kernel_re = kernelSpectrum[2 * id];
+						double kernel_im = kernelImagSign * kernelSpectrum[2 * id + 1];
+						product[2 * id] += kernel_re * inputSpectrum[2 * id] - kernel_im * inputSpectrum[2 * id + 1];
+						product[2 * id + 1] += kernel_re * inputSpectrum[2 * id + 1] + kernel_im * inputSpectrum[2 * id];
+					}
+				}
+				referenceFFT(product, size, configuration.FFTdim, true);
+				for (uint64_t id = 0; id < 2 * totalSize; id++)
+					product[id] /= totalSize;
+				uint64_t system = (b * numberKernels + f) * coordinates + v;
+				for (uint32_t k = comparedRange[2][0]; k < comparedRange[2][1]; k++) {
+					for (uint32_t j = comparedRange[1][0]; j < comparedRange[1][1]; j++) {
+						for (uint32_t i = comparedRange[0][0]; i < comparedRange[0][1]; i++) {
+							uint64_t id = i + (uint64_t)j * size[0] + (uint64_t)k * size[0] * size[1];
+							uint64_t bufferId = getAccuracyBufferIndex(&configuration, i, j, k, system);
+							for (uint32_t t = 0; t < componentsPerElement; t++) {
+								reference[count] = product[2 * id + t];
+								result[count] = buffer_output[bufferId + t];
+								count++;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	printAccuracy(caseName, reference, result, count, numPassed, numCases);
+
+	free(kernel_input);
+	free(kernel_reference);
+	free(buffer_input);
+	free(buffer_output);
+	free(input_reference);
+	free(reference);
+	free(result);
+	free(product);
+	vkDestroyBuffer(device, buffer, NULL);
+	vkFreeMemory(device, bufferDeviceMemory, NULL);
+	if (numberKernels > 1) {
+		vkDestroyBuffer(device, outputBuffer, NULL);
+		vkFreeMemory(device, outputBufferDeviceMemory, NULL);
+	}
+	vkDestroyBuffer(device, kernel, NULL);
+	vkFreeMemory(device, kernelDeviceMemory, NULL);
+	kernel_cache.deleteConvolutionKernel();
+	app_convolution.deleteVulkanFFT();
+}
+
+VkFFTConfiguration getFFTCaseConfiguration(uint32_t* fftCase) {
+	//FFTdim, size[0], size[1], size[2], performR2C, registerBoost
+	VkFFTConfiguration configuration;
+	configuration.FFTdim = fftCase[0];
+	configuration.size[0] = fftCase[1];
+	configuration.size[1] = fftCase[2];
+	configuration.size[2] = fftCase[3];
+	configuration.performR2C = fftCase[4];
+	configuration.registerBoost = fftCase[5]; //set explicitly, so that 8192 and 16384 register-boosted shaders are used on every device
+	return configuration;
+}
+VkFFTConfiguration getConvolutionCaseConfiguration(uint32_t* convolutionCase) {
+	//FFTdim, size[0], size[1], size[2], performR2C, matrixConvolution, symmetricKernel, coordinateFeatures, numberBatches, numberKernels, performZeropadding (1 - default range, 2 - centered window [size/4, 3*size/4)), performCorrelation
+	VkFFTConfiguration configuration;
+	configuration.FFTdim = convolutionCase[0];
+	configuration.size[0] = convolutionCase[1];
+	configuration.size[1] = convolutionCase[2];
+	configuration.size[2] = convolutionCase[3];
+	configuration.performR2C = convolutionCase[4];
+	configuration.matrixConvolution = convolutionCase[5];
+	configuration.symmetricKernel = convolutionCase[6];
+	configuration.coordinateFeatures = convolutionCase[7];
+	configuration.numberBatches = convolutionCase[8];
+	configuration.numberKernels = convolutionCase[9];
+	for (uint32_t i = 0; i < configuration.FFTdim; i++) {
+		configuration.performZeropadding[i] = (convolutionCase[10] > 0);
+		if (convolutionCase[10] == 2) {
+			configuration.zeropadInputRange[i][0] = configuration.size[i] / 4;
+			configuration.zeropadInputRange[i][1] = 3 * configuration.size[i] / 4;
+			configuration.zeropadOutputRange[i][0] = configuration.size[i] / 4;
+			configuration.zeropadOutputRange[i][1] = 3 * configuration.size[i] / 4;
+		}
+	}
+	configuration.performCorrelation = convolutionCase[11];
+	return configuration;
+}
+VkFFTConfiguration getPruningCaseConfiguration(uint32_t* pruningCase) {
+	//FFTdim, size[0], size[1], size[2], performR2C, pruned axis, outputPruningRange
+	VkFFTConfiguration configuration;
+	configuration.FFTdim = pruningCase[0];
+	configuration.size[0] = pruningCase[1];
+	configuration.size[1] = pruningCase[2];
+	configuration.size[2] = pruningCase[3];
+	configuration.performR2C = pruningCase[4];
+	uint32_t prunedAxis = pruningCase[5];
+	configuration.performOutputPruning[prunedAxis] = true;
+	configuration.outputPruningRange[prunedAxis][0] = pruningCase[6];
+	configuration.outputPruningRange[prunedAxis][1] = pruningCase[7];
+	return configuration;
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t deviceID = 0;
+	for (int i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-device") == 0) && (i + 1 < argc))
+			deviceID = atoi(argv[++i]);
+		else {
+			fprintf(stderr, "Unknown option: %s\nUsage: VkFFT_validation [-device ID]\n", argv[i]);
+			return 1;
+		}
+	}
+	if (!createDevice(deviceID)) return 1;
+
+	uint32_t numPassed = 0;
+	uint32_t numCases = 0;
+	srand(1);
+	const uint32_t num_fft_cases = 17;
+	uint32_t fft_cases[num_fft_cases][6] = {
+		{1, 64, 1, 1, 0, 1}, {1, 1024, 1, 1, 0, 1}, {1, 4096, 1, 1, 0, 1}, {1, 8192, 1, 1, 0, 1}, {1, 8192, 1, 1, 0, 2}, {1, 16384, 1, 1, 0, 4}, {1, 65536, 1, 1, 0, 1},
+		{2, 256, 256, 1, 0, 1}, {2, 1024, 512, 1, 0, 1}, {3, 64, 64, 64, 0, 1},
+		{2, 256, 256, 1, 1, 1}, {2, 1024, 64, 1, 1, 1}, {2, 4096, 64, 1, 1, 1}, {3, 64, 64, 32, 1, 1}, {2, 8192, 16, 1, 1, 1}, {2, 8192, 16, 1, 1, 2}, {2, 16384, 8, 1, 1, 4} };
+	for (uint32_t n = 0; n < num_fft_cases; n++)
+		checkFFTAccuracy(getFFTCaseConfiguration(fft_cases[n]), &numPassed, &numCases);
+	const uint32_t num_convolution_cases = 19;
+	uint32_t convolution_cases[num_convolution_cases][12] = {
+		{1, 1024, 1, 1, 0, 1, 0, 2, 1, 1, 0, 0}, {2, 32768, 8, 1, 0, 1, 0, 1, 1, 1, 0, 0}, {2, 256, 128, 1, 1, 1, 0, 1, 2, 3, 0, 0},
+		{2, 128, 64, 1, 1, 2, 1, 2, 1, 1, 0, 0}, {2, 128, 64, 1, 1, 2, 0, 2, 1, 1, 0, 0}, {2, 128, 64, 1, 1, 3, 1, 3, 1, 1, 0, 0}, {3, 32, 32, 32, 1, 3, 0, 3, 1, 1, 0, 0},
+		{1, 1024, 1, 1, 0, 4, 1, 4, 1, 1, 0, 0}, {2, 128, 64, 1, 1, 4, 0, 4, 1, 1, 0, 0}, {2, 64, 32, 1, 1, 8, 1, 8, 1, 1, 0, 0}, {3, 32, 16, 16, 0, 8, 0, 8, 1, 1, 0, 0},
+		{2, 256, 256, 1, 1, 1, 0, 1, 1, 1, 1, 0}, {3, 64, 64, 64, 1, 1, 0, 1, 1, 1, 1, 0}, {2, 256, 128, 1, 0, 1, 0, 1, 1, 1, 2, 0}, {2, 256, 128, 1, 1, 1, 0, 1, 1, 1, 2, 0}, {3, 64, 64, 32, 1, 1, 0, 1, 1, 1, 2, 0},
+		{1, 1024, 1, 1, 0, 1, 0, 2, 1, 1, 0, 1}, {2, 256, 128, 1, 1, 1, 0, 1, 2, 3, 0, 1}, {2, 128, 64, 1, 1, 3, 1, 3, 1, 1, 0, 1} };
+	for (uint32_t n = 0; n < num_convolution_cases; n++)
+		checkConvolutionAccuracy(getConvolutionCaseConfiguration(convolution_cases[n]), &numPassed, &numCases);
+	const uint32_t num_pruning_cases = 4;
+	uint32_t pruning_cases[num_pruning_cases][8] = {
+		{1, 1024, 1, 1, 0, 0, 100, 300}, {2, 256, 256, 1, 0, 1, 16, 80}, {2, 256, 128, 1, 1, 1, 8, 40}, {1, 65536, 1, 1, 0, 0, 0, 1024} };
+	for (uint32_t n = 0; n < num_pruning_cases; n++)
+		checkPruningAccuracy(getPruningCaseConfiguration(pruning_cases[n]), pruning_cases[n][5], &numPassed, &numCases);
+#ifdef VKFFT_CPU_BACKEND
+	//CPU backend plans with the limits of the validated device. With 32KB of shared memory, 65536 C2C and 8192 R2C y axes are split in two uploads and checked in four-step order, 8192 R2C x axis is checked in natural order
+	const uint32_t num_cpu_threads = 3;
+	uint32_t cpu_threads[num_cpu_threads] = { 1, 2, 0 }; //0 - all hardware threads
+	const uint32_t num_cpu_fft_cases = 7;
+	uint32_t cpu_fft_cases[num_cpu_fft_cases][6] = {
+		{1, 1024, 1, 1, 0, 1}, {1, 65536, 1, 1, 0, 1}, {2, 256, 256, 1, 0, 1}, {3, 64, 64, 64, 0, 1},
+		{2, 1024, 64, 1, 1, 1}, {2, 64, 8192, 1, 1, 1}, {2, 8192, 16, 1, 1, 1} };
+	const uint32_t num_cpu_convolution_cases = 7;
+	uint32_t cpu_convolution_cases[num_cpu_convolution_cases][12] = {
+		{1, 1024, 1, 1, 0, 1, 0, 2, 1, 1, 0, 0}, {2, 32768, 8, 1, 0, 1, 0, 1, 1, 1, 0, 0}, {2, 256, 128, 1, 1, 1, 0, 1, 2, 3, 0, 0}, {2, 128, 64, 1, 1, 3, 1, 3, 1, 1, 0, 0},
+		{2, 256, 256, 1, 1, 1, 0, 1, 1, 1, 1, 0}, {2, 256, 128, 1, 0, 1, 0, 1, 1, 1, 2, 0}, {1, 1024, 1, 1, 0, 1, 0, 2, 1, 1, 0, 1} };
+	const uint32_t num_cpu_pruning_cases = 3;
+	uint32_t cpu_pruning_cases[num_cpu_pruning_cases][8] = {
+		{1, 1024, 1, 1, 0, 0, 100, 300}, {2, 256, 128, 1, 1, 1, 8, 40}, {1, 65536, 1, 1, 0, 0, 0, 1024} };
+	for (uint32_t t = 0; t < num_cpu_threads; t++) {
+		for (uint32_t n = 0; n < num_cpu_fft_cases; n++) {
+			VkFFTConfiguration configuration = getFFTCaseConfiguration(cpu_fft_cases[n]);
+			configuration.useCPU = true;
+			configuration.numberCPUThreads = cpu_threads[t];
+			checkFFTAccuracy(configuration, &numPassed, &numCases);
+		}
+		for (uint32_t n = 0; n < num_cpu_convolution_cases; n++) {
+			VkFFTConfiguration configuration = getConvolutionCaseConfiguration(cpu_convolution_cases[n]);
+			configuration.useCPU = true;
+			configuration.numberCPUThreads = cpu_threads[t];
+			checkConvolutionAccuracy(configuration, &numPassed, &numCases);
+		}
+		for (uint32_t n = 0; n < num_cpu_pruning_cases; n++) {
+			VkFFTConfiguration configuration = getPruningCaseConfiguration(cpu_pruning_cases[n]);
+			configuration.useCPU = true;
+			configuration.numberCPUThreads = cpu_threads[t];
+			checkPruningAccuracy(configuration, cpu_pruning_cases[n][5], &numPassed, &numCases);
+		}
+	}
+#endif
+	printf("Accuracy validation: %d of %d checks passed\n", numPassed, numCases);
+
+	stagingPool.deleteStagingPool();
+	vkDestroyFence(device, fence, NULL);
+	vkDestroyCommandPool(device, commandPool, NULL);
+	vkDestroyDevice(device, NULL);
+	vkDestroyInstance(instance, NULL);
+	return (numPassed == numCases) ? 0 : 1;
+}
@@ -6,6 +6,13 @@
 #include <iostream>
 #include <vkFFT.h>
 #include <vulkan/vulkan.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #ifdef NDEBUG
 const bool enableValidationLayers = false;
 #else
@@ -24,6 +31,10 @@ std::vector<const char*> enabledLayers;
 VkQueue queue = {};
 VkCommandPool commandPool = {};
 VkFence fence = {};
+bool isHostImportSupported = false; //VK_EXT_external_memory_host is enabled on the device
+bool isTimelineSemaphoreSupported = false; //VK_KHR_timeline_semaphore is enabled on the device
+std::vector<VkQueue> computeQueues; //all queues of the compute family, queue is the first one
+VkFFTStagingPool stagingPool = {}; //all host<->device transfers of the samples go through it, no staging allocations per transfer
 
 const std::vector<const char*> validationLayers = {
 	"VK_LAYER_KHRONOS_validation"
@@ -124,7 +135,7 @@ void createInstance() {
 	applicationInfo.applicationVersion = 1.0;
 	applicationInfo.pEngineName = "VkFFT";
 	applicationInfo.engineVersion = 1.0;
-	applicationInfo.apiVersion = VK_API_VERSION_1_0;
+	applicationInfo.apiVersion = VK_API_VERSION_1_1; //1.1 for vkGetPhysicalDeviceProperties2 - alignment of imported host memory
 
 	VkInstanceCreateInfo createInfo = { VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO };
 	createInfo.flags = 0;
@@ -200,9 +211,14 @@ void createDevice() {
 	VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
 	queueFamilyIndex = getComputeQueueFamilyIndex();
 	queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
-	queueCreateInfo.queueCount = 1;
-	float queuePriorities = 1.0;
-	queueCreateInfo.pQueuePriorities = &queuePriorities;
+	//all queues of the family are created - sample 12 spreads FFTs over them, other samples only use the first one
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, NULL);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+	queueCreateInfo.queueCount = queueFamilies[queueFamilyIndex].queueCount;
+	std::vector<float> queuePriorities(queueCreateInfo.queueCount, 1.0f);
+	queueCreateInfo.pQueuePriorities = queuePriorities.data();
 	VkDeviceCreateInfo deviceCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
 	VkPhysicalDeviceFeatures deviceFeatures = {};
 	deviceFeatures.shaderFloat64 = true;
@@ -211,8 +227,40 @@ void createDevice() {
 	deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
 	deviceCreateInfo.queueCreateInfoCount = 1;
 	deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
+	//optional extensions are enabled if the device has them
+	uint32_t extensionCount = 0;
+	vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, NULL);
+	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+	vkEnumerateDeviceExtensionProperties(physicalDevice, NULL, &extensionCount, availableExtensions.data());
+	std::vector<const char*> deviceExtensions;
+#if defined(VK_VERSION_1_2) || defined(VK_KHR_timeline_semaphore)
+	VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR };
+#endif
+	for (uint32_t i = 0; i < extensionCount; i++) {
+		if (strcmp(availableExtensions[i].extensionName, VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME) == 0) {
+			deviceExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+			isHostImportSupported = true;
+		}
+#if defined(VK_VERSION_1_2) || defined(VK_KHR_timeline_semaphore)
+		if (strcmp(availableExtensions[i].extensionName, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == 0) {
+			VkPhysicalDeviceFeatures2 deviceFeatures2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+			deviceFeatures2.pNext = &timelineSemaphoreFeatures;
+			vkGetPhysicalDeviceFeatures2(physicalDevice, &deviceFeatures2);
+			if (timelineSemaphoreFeatures.timelineSemaphore) {
+				deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+				deviceCreateInfo.pNext = &timelineSemaphoreFeatures;
+				isTimelineSemaphoreSupported = true;
+			}
+		}
+#endif
+	}
+	deviceCreateInfo.enabledExtensionCount = deviceExtensions.size();
+	deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
 	vkCreateDevice(physicalDevice, &deviceCreateInfo, NULL, &device);
-	vkGetDeviceQueue(device, queueFamilyIndex, 0, &queue);
+	computeQueues.resize(queueCreateInfo.queueCount);
+	for (uint32_t i = 0; i < queueCreateInfo.queueCount; i++)
+		vkGetDeviceQueue(device, queueFamilyIndex, i, &computeQueues[i]);
+	queue = computeQueues[0];
 
 }
 
@@ -247,15 +295,13 @@ void allocateFFTBuffer(VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferU
 	vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
 }
 void transferDataFromCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
-	VkDeviceSize stagingBufferSize = bufferSize;
-	VkBuffer stagingBuffer = {};
-	VkDeviceMemory stagingBufferMemory = {};
-	allocateFFTBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBufferSize);
-
-	void* data;
-	vkMapMemory(device, stagingBufferMemory, 0, stagingBufferSize, 0, &data);
-	memcpy(data, arr, stagingBufferSize);
-	vkUnmapMemory(device, stagingBufferMemory);
+	stagingPool.transferDataFromCPU(arr, buffer, bufferSize);
+}
+void transferDataToCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
+	stagingPool.transferDataToCPU(arr, buffer, bufferSize);
+}
+
+void performVulkanFFT(VkFFTApplication* app, uint32_t batch) {
 	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
 	commandBufferAllocateInfo.commandPool = commandPool;
 	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -265,29 +311,24 @@ void transferDataFromCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize)
 	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
 	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	VkBufferCopy copyRegion = {};
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = stagingBufferSize;
-	vkCmdCopyBuffer(commandBuffer, stagingBuffer, buffer[0], 1, &copyRegion);
+	//Record commands batch times. Allows to perform multiple convolutions/transforms in one submit.
+	for (uint32_t i = 0; i < batch; i++) {
+		app->VkFFTAppend(commandBuffer);
+	}
 	vkEndCommandBuffer(commandBuffer);
 	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
 	submitInfo.commandBufferCount = 1;
 	submitInfo.pCommandBuffers = &commandBuffer;
+	auto timeSubmit = std::chrono::steady_clock::now();
 	vkQueueSubmit(queue, 1, &submitInfo, fence);
 	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	auto timeEnd = std::chrono::steady_clock::now();
+	double totTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeSubmit).count() * 0.001;
+	printf("Pure submit execution time per batch: %.3f ms\n", totTime/batch );
 	vkResetFences(device, 1, &fence);
 	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-	vkDestroyBuffer(device, stagingBuffer, NULL);
-	vkFreeMemory(device, stagingBufferMemory, NULL);
 }
-void transferDataToCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
-	VkDeviceSize stagingBufferSize = bufferSize;
-	VkBuffer stagingBuffer = {};
-	VkDeviceMemory stagingBufferMemory = {};
-	allocateFFTBuffer(&stagingBuffer, &stagingBufferMemory, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBufferSize);
-
-
+float performVulkanFFTiFFT(VkFFTApplication* app_forward, VkFFTApplication* app_inverse, uint32_t batch) {
 	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
 	commandBufferAllocateInfo.commandPool = commandPool;
 	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -297,28 +338,25 @@ void transferDataToCPU(float* arr, VkBuffer* buffer, VkDeviceSize bufferSize) {
 	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
 	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	VkBufferCopy copyRegion = {};
-	copyRegion.srcOffset = 0;
-	copyRegion.dstOffset = 0;
-	copyRegion.size = stagingBufferSize;
-	vkCmdCopyBuffer(commandBuffer, buffer[0], stagingBuffer, 1, &copyRegion);
+	for (uint32_t i = 0; i < batch; i++) {
+		app_forward->VkFFTAppend(commandBuffer);
+		app_inverse->VkFFTAppend(commandBuffer);
+	}
 	vkEndCommandBuffer(commandBuffer);
 	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
 	submitInfo.commandBufferCount = 1;
 	submitInfo.pCommandBuffers = &commandBuffer;
+	auto timeSubmit = std::chrono::steady_clock::now();
 	vkQueueSubmit(queue, 1, &submitInfo, fence);
 	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	auto timeEnd = std::chrono::steady_clock::now();
+	float totTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeSubmit).count() * 0.001;
 	vkResetFences(device, 1, &fence);
 	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-	void* data;
-	vkMapMemory(device, stagingBufferMemory, 0, stagingBufferSize, 0, &data);
-	memcpy(arr, data, stagingBufferSize);
-	vkUnmapMemory(device, stagingBufferMemory);
-	vkDestroyBuffer(device, stagingBuffer, NULL);
-	vkFreeMemory(device, stagingBufferMemory, NULL);
+	return totTime / batch;
 }
 
-void performVulkanFFT(VkFFTApplication* app, uint32_t batch) {
+float performVulkanFFTTimed(VkFFTApplication* app, uint32_t batch) {
 	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
 	commandBufferAllocateInfo.commandPool = commandPool;
 	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -328,7 +366,6 @@ void performVulkanFFT(VkFFTApplication* app, uint32_t batch) {
 	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
 	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	//Record commands batch times. Allows to perform multiple convolutions/transforms in one submit.
 	for (uint32_t i = 0; i < batch; i++) {
 		app->VkFFTAppend(commandBuffer);
 	}
@@ -340,12 +377,13 @@ void performVulkanFFT(VkFFTApplication* app, uint32_t batch) {
 	vkQueueSubmit(queue, 1, &submitInfo, fence);
 	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
 	auto timeEnd = std::chrono::steady_clock::now();
-	double totTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeSubmit).count() * 0.001;
-	printf("Pure submit execution time per batch: %.3f ms\n", totTime/batch );
+	float totTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeSubmit).count() * 0.001;
 	vkResetFences(device, 1, &fence);
 	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+	return totTime / batch;
 }
-float performVulkanFFTiFFT(VkFFTApplication* app_forward, VkFFTApplication* app_inverse, uint32_t batch) {
+void prepareConvolutionKernel(VkFFTConvolutionKernel* kernel_cache) {
+	if (kernel_cache->isPrepared) return;
 	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
 	commandBufferAllocateInfo.commandPool = commandPool;
 	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -355,10 +393,30 @@ float performVulkanFFTiFFT(VkFFTApplication* app_forward, VkFFTApplication* app_
 	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
 	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-	for (uint32_t i = 0; i < batch; i++) {
-		app_forward->VkFFTAppend(commandBuffer);
-		app_inverse->VkFFTAppend(commandBuffer);
-	}
+	kernel_cache->appendConvolutionKernelPreparation(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	if (vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000) == VK_SUCCESS)
+		kernel_cache->markPrepared();
+	vkResetFences(device, 1, &fence);
+	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+float performStreamingConvolution(VkFFTStreamingConvolution* stream, uint32_t numBlocks, bool reset) {
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	if (reset) stream->resetStreamingConvolution(commandBuffer);
+	//One chunk of numBlocks blocks is filtered in one submit.
+	stream->appendStreamingConvolution(commandBuffer, numBlocks);
 	vkEndCommandBuffer(commandBuffer);
 	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
 	submitInfo.commandBufferCount = 1;
@@ -370,7 +428,87 @@ float performVulkanFFTiFFT(VkFFTApplication* app_forward, VkFFTApplication* app_
 	float totTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeSubmit).count() * 0.001;
 	vkResetFences(device, 1, &fence);
 	vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-	return totTime / batch;
+	return totTime;
+}
+void* allocateHostFrame(size_t size, size_t alignment) {
+	//page-aligned host memory, as filled by a capture driver
+#ifdef _WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	void* frame = NULL;
+	if (posix_memalign(&frame, alignment, size) != 0) return NULL;
+	return frame;
+#endif
+}
+void freeHostFrame(void* frame) {
+#ifdef _WIN32
+	_aligned_free(frame);
+#else
+	free(frame);
+#endif
+}
+void* mapFile(const char* path, uint64_t size, bool isWritable) {
+	//maps a file of size bytes, created or resized if isWritable. Pages are read and written back by the OS on access
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path, isWritable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, NULL, isWritable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+	HANDLE mapping = CreateFileMappingA(file, NULL, isWritable ? PAGE_READWRITE : PAGE_READONLY, (DWORD)(size >> 32), (DWORD)size, NULL);
+	CloseHandle(file);
+	if (mapping == NULL) return NULL;
+	void* data = MapViewOfFile(mapping, isWritable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+	CloseHandle(mapping);
+	return data;
+#else
+	int file = open(path, isWritable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+	if (file < 0) return NULL;
+	if ((isWritable) && (ftruncate(file, size) != 0)) {
+		close(file);
+		return NULL;
+	}
+	void* data = mmap(NULL, size, isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return NULL;
+	madvise(data, size, MADV_SEQUENTIAL);
+	return data;
+#endif
+}
+void unmapFile(void* data, uint64_t size) {
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(data, size);
+#endif
+}
+VkCommandBuffer recordFrame(VkFFTApplication* app, VkBuffer* copySource, VkBuffer* copyDestination, VkDeviceSize copySize) {
+	//command buffer recorded once and submitted for every frame: optional copy of the frame to the device, then the FFT
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+	commandBufferAllocateInfo.commandPool = commandPool;
+	commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = 1;
+	VkCommandBuffer commandBuffer = {};
+	vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+	VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+	vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+	if (copySource != NULL) {
+		VkBufferCopy copyRegion = {};
+		copyRegion.size = copySize;
+		vkCmdCopyBuffer(commandBuffer, copySource[0], copyDestination[0], 1, &copyRegion);
+		VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, NULL, 0, NULL);
+	}
+	app->VkFFTAppend(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+	return commandBuffer;
+}
+void submitFrame(VkCommandBuffer commandBuffer) {
+	VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+	vkQueueSubmit(queue, 1, &submitInfo, fence);
+	vkWaitForFences(device, 1, &fence, VK_TRUE, 100000000000);
+	vkResetFences(device, 1, &fence);
 }
 
 int main()
@@ -391,8 +529,10 @@ int main()
 	vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPool);
 	vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
 	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &physicalDeviceMemoryProperties);
+	//3 slots of 16MB - bigger transfers are streamed through the ring
+	stagingPool.initializeStagingPool(&device, &physicalDevice, &queue, &commandPool, 16 * 1024 * 1024, 3);
 
-	uint32_t sample_id = 0;//setting parameter for VkFFT samples. 0 - FFT + iFFT R2C/C2R benchmark. 1 - convolution. 2 - zeropadding convolution. 3 - multiple feature(kernel) convolution. 4 - 8k sequence for testing
+	uint32_t sample_id = 0;//setting parameter for VkFFT samples. 0 - FFT + iFFT R2C/C2R benchmark. 1 - convolution. 2 - zeropadding convolution. 3 - multiple feature(kernel) convolution. 4 - 8k sequence for testing. 5 - overlap-save streaming convolution benchmark for different block sizes. 6 - batched multi-input, multi-kernel convolution benchmark. 7 - accuracy validation, moved to the VkFFT_validation executable. 8 - chunked streaming FFT of a dataset bigger than one device buffer. 9 - zero-copy input from host memory with VK_EXT_external_memory_host. 10 - out-of-core 3D FFT of memory-mapped files. 11 - small FFTs submitted one by one, recorded every call and pre-recorded. 12 - independent small and medium FFTs spread over all compute queues
 	switch (sample_id) {
 	case 0:
 	{
@@ -413,7 +553,7 @@ int main()
 				VkFFTApplication app_inverse;
 				//FFT + iFFT sample code.
 				//Setting up FFT configuration for forward and inverse FFT.
-				forward_configuration.coalescedMemory = 32;//in bits, for Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher. 
+				forward_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
 				forward_configuration.FFTdim = benchmark_dimensions[n][3]; //FFT dimension, 1D, 2D or 3D (default 1).
 				forward_configuration.size[0] = benchmark_dimensions[n][0]; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z.   
 				forward_configuration.size[1] = benchmark_dimensions[n][1];
@@ -427,11 +567,17 @@ int main()
 				forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
 				//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
 				forward_configuration.device = &device;
+				forward_configuration.physicalDeviceProperties = &physicalDeviceProperties;
+				forward_configuration.queue = &queue; //queue, command pool and fence are only used by autotune
+				forward_configuration.commandPool = &commandPool;
+				forward_configuration.fence = &fence;
+				forward_configuration.autotune = false; //time candidate registerBoost, coalescedMemory, radix and groupedBatch values on this GPU and use the fastest
+				//sprintf(forward_configuration.wisdomPath, "vkfft_wisdom.txt"); //store autotune results keyed by device and system size, later runs load them instead of tuning
 				//Custom path to the floder with shaders, default is "shaders/");
 				sprintf(forward_configuration.shaderPath, SHADER_DIR);
 
-				//Allocate buffer for the input data.
-				VkDeviceSize bufferSize = forward_configuration.coordinateFeatures * sizeof(float) * 2 * (forward_configuration.size[0] / 2 + 1) * forward_configuration.size[1] * forward_configuration.size[2];;
+				//Allocate buffer for the input data. Size includes R2C padding, getMemoryRequirements also returns input, output and kernel sizes and memory traffic of one VkFFTAppend.
+				VkDeviceSize bufferSize = app_forward.getMemoryRequirements(forward_configuration).bufferSize;
 				VkBuffer buffer = {};
 				VkDeviceMemory bufferDeviceMemory = {};
 
@@ -467,6 +613,7 @@ int main()
 				//Initialize applications. This function loads shaders, creates pipeline and configures FFT based on configuration file. No buffer allocations inside VkFFT library.  
 				app_forward.initializeVulkanFFT(forward_configuration);
 				app_inverse.initializeVulkanFFT(inverse_configuration);
+				//app_forward.printPlanJSON(stdout); //dump passes chosen by the planner: shader, radix sequence, strides, dispatch grid and estimated memory traffic
 				//Submit FFT+iFFT.
 				uint32_t batch = ((4096.0 * 1024.0 * 1024.0) / bufferSize > 1000) ? 1000 : (4096.0 * 1024.0 * 1024.0) / bufferSize;
 				if (batch == 0) batch = 1;
@@ -502,6 +649,7 @@ int main()
 		}
 		benchmark_result /= ((num_benchmark_samples-1) * num_runs);
 		printf("Benchmark score: %d\n", (int)(benchmark_result));
+		stagingPool.deleteStagingPool();
 		vkDestroyFence(device, fence, NULL);
 		vkDestroyCommandPool(device, commandPool, NULL);
 		vkDestroyDevice(device, NULL);
@@ -513,87 +661,68 @@ int main()
 	{
 		//1 - convolution
 		//Configuration + FFT application.
-		VkFFTConfiguration forward_configuration;
-		VkFFTConfiguration inverse_configuration;
 		VkFFTConfiguration convolution_configuration;
 		VkFFTApplication app_convolution;
-		VkFFTApplication app_kernel;
+		VkFFTConvolutionKernel kernel_cache;
 		//Convolution sample code
 		//Setting up FFT configuration. FFT is performed in-place with no performance loss. 
-		forward_configuration.coalescedMemory = 32;//in bits, for Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher. 
-		forward_configuration.FFTdim = 3; //FFT dimension, 1D, 2D or 3D (default 1).
-		forward_configuration.size[0] = 32; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z. 
-		forward_configuration.size[1] = 32;
-		forward_configuration.size[2] = 32;
-		forward_configuration.performConvolution = false; //Perform convolution with precomputed kernel. As we perform forward FFT to get the kernel, it is set to false.
-		forward_configuration.performR2C = true; //Perform R2C/C2R transform. Can be combined with all other options. Reduces memory requirements by a factor of 2. Requires special input data alignment: for x*y*z system pad x*y plane to (x+2)*y with last 2*y elements reserved, total array dimensions are (x*y+2y)*z. Memory layout after R2C and before C2R can be found on github.
-		forward_configuration.coordinateFeatures = 9; //Specify dimensionality of the input feature vector (default 1). Each component is stored not as a vector, but as a separate system and padded on it's own according to other options (i.e. for x*y system of 3-vector, first x*y elements correspond to the first dimension, then goes x*y for the second, etc).
-		//coordinateFeatures number is an important constant for convolution. If we perform 1x1 convolution, it is equal to number of features, but matrixConvolution should be equal to 1. For matrix convolution, it must be equal to matrixConvolution parameter. If we perform 2x2 convolution, it is equal to 3 for symmetric kernel (stored as xx, xy, yy) and 4 for nonsymmetric (stored as xx, xy, yx, yy). Similarly, 6 (stored as xx, xy, xz, yy, yz, zz) and 9 (stored as xx, xy, xz, yx, yy, yz, zx, zy, zz) for 3x3 convolutions. 
-		forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
+		convolution_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
+		convolution_configuration.FFTdim = 3; //FFT dimension, 1D, 2D or 3D (default 1).
+		convolution_configuration.size[0] = 32; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z. 
+		convolution_configuration.size[1] = 32;
+		convolution_configuration.size[2] = 32;
+		convolution_configuration.performConvolution = true; //Perform convolution with precomputed kernel.
+		convolution_configuration.performR2C = true; //Perform R2C/C2R transform. Can be combined with all other options. Reduces memory requirements by a factor of 2. Requires special input data alignment: for x*y*z system pad x*y plane to (x+2)*y with last 2*y elements reserved, total array dimensions are (x*y+2y)*z. Memory layout after R2C and before C2R can be found on github.
+		convolution_configuration.symmetricKernel = true;//Specify if convolution kernel is symmetric. In this case we only pass upper triangle part of it in the form of: (xx, xy, yy) for 2d and (xx, xy, xz, yy, yz, zz) for 3d.
+		convolution_configuration.performCorrelation = false;//Specify if cross-correlation has to be performed instead of convolution. Kernel is conjugated on the fly, no need to store a conjugated copy of it.
+		convolution_configuration.matrixConvolution = 3;//we do matrix convolution, so kernel is 6 numbers (upper triangle of symmetric 3x3), but vector dimension is 3
+		convolution_configuration.coordinateFeatures = 3;//equal to matrixConvolution size
+		//coordinateFeatures number is an important constant for convolution. If we perform 1x1 convolution, it is equal to number of features, but matrixConvolution should be equal to 1. For matrix convolution, it must be equal to matrixConvolution parameter. If we perform 2x2 convolution, it is equal to 3 for symmetric kernel (stored as xx, xy, yy) and 4 for nonsymmetric (stored as xx, xy, yx, yy). Similarly, 6 (stored as xx, xy, xz, yy, yz, zz) and 9 (stored as xx, xy, xz, yx, yy, yz, zx, zy, zz) for 3x3 convolutions. In general, NxN convolution uses N*(N+1)/2 coordinates for symmetric kernel (upper triangle, row-major) and N*N for nonsymmetric (row-major). 
+		convolution_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
 		//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
-		forward_configuration.device = &device;
-		sprintf(forward_configuration.shaderPath, SHADER_DIR);
-		//In this example, we perform a convolution for a real vectorfield (3vector) with a symmetric kernel (6 values). We use forward_configuration to initialize convolution kernel first from real data, then we create convolution_configuration for convolution. The buffer object from forward_configuration is passed to convolution_configuration as kernel object.
+		convolution_configuration.device = &device;
+		convolution_configuration.physicalDeviceProperties = &physicalDeviceProperties;
+		sprintf(convolution_configuration.shaderPath, SHADER_DIR);
+		//In this example, we perform a convolution for a real vectorfield (3vector) with a symmetric kernel (6 values). VkFFTConvolutionKernel derives kernel forward FFT configuration from convolution_configuration and transforms the kernel once. Transformed kernel is kept in the kernel buffer and can be reused by any number of convolutions.
 		//1. Kernel forward FFT.
-		VkDeviceSize kernelSize = forward_configuration.coordinateFeatures * sizeof(float) * 2 * (forward_configuration.size[0] / 2 + 1) * forward_configuration.size[1] * forward_configuration.size[2];;
+		//Kernel buffer size is computed from the convolution configuration: symmetric 3x3 kernel stores 6 systems instead of 9.
+		VkDeviceSize kernelSize = kernel_cache.getKernelBufferSize(convolution_configuration);
 		VkBuffer kernel = {};
 		VkDeviceMemory kernelDeviceMemory = {};
 
 		//Sample allocation tool.
 		allocateFFTBuffer(&kernel, &kernelDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, kernelSize);
-		forward_configuration.buffer = &kernel;
-		forward_configuration.inputBuffer = &kernel;
-		forward_configuration.outputBuffer = &kernel;
-		forward_configuration.bufferSize = &kernelSize;
-		forward_configuration.inputBufferSize = &kernelSize;
-		forward_configuration.outputBufferSize = &kernelSize;
+		convolution_configuration.kernel = &kernel;
+		convolution_configuration.kernelSize = &kernelSize;
 
 		printf("Total memory needed for kernel: %d MB\n", kernelSize / 1024 / 1024);
 
-		//Fill kernel on CPU.
+		//Fill kernel on CPU. Below is the test identity kernel for 3x3 symmetric convolution - delta function in the xx, yy and zz coordinates. Its FFT is equal to 1 everywhere.
+		uint32_t kernelCoordinates = kernel_cache.getKernelCoordinates(convolution_configuration);
 		float* kernel_input = (float*)malloc(kernelSize);
-		for (uint32_t v = 0; v < forward_configuration.coordinateFeatures; v++) {
-			for (uint32_t k = 0; k < forward_configuration.size[2]; k++) {
-				for (uint32_t j = 0; j < forward_configuration.size[1]; j++) {
-
-					//for (uint32_t i = 0; i < forward_configuration.size[0]; i++) {
-					//	kernel_input[i + j * forward_configuration.size[0] + k * (forward_configuration.size[0] + 2) * forward_configuration.size[1] + v * (forward_configuration.size[0] + 2) * forward_configuration.size[1] * forward_configuration.size[2]] = 1;
-
-					//Below is the test identity kernel for 3x3 nonsymmetric FFT
-					for (uint32_t i = 0; i < forward_configuration.size[0] / 2 + 1; i++) {
-						if ((v == 0) || (v == 4) || (v == 8))
-
-							kernel_input[2 * i + j * (forward_configuration.size[0] + 2) + k * (forward_configuration.size[0] + 2) * forward_configuration.size[1] + v * (forward_configuration.size[0] + 2) * forward_configuration.size[1] * forward_configuration.size[2]] = 1;
-
+		for (uint32_t v = 0; v < kernelCoordinates; v++) {
+			for (uint32_t k = 0; k < convolution_configuration.size[2]; k++) {
+				for (uint32_t j = 0; j < convolution_configuration.size[1]; j++) {
+					for (uint32_t i = 0; i < convolution_configuration.size[0] + 2; i++) {
+						if ((i == 0) && (j == 0) && (k == 0) && ((v == 0) || (v == 3) || (v == 5)))
+							kernel_input[i + j * (convolution_configuration.size[0] + 2) + k * (convolution_configuration.size[0] + 2) * convolution_configuration.size[1] + v * (convolution_configuration.size[0] + 2) * convolution_configuration.size[1] * convolution_configuration.size[2]] = 1;
 						else
-							kernel_input[2 * i + j * (forward_configuration.size[0] + 2) + k * (forward_configuration.size[0] + 2) * forward_configuration.size[1] + v * (forward_configuration.size[0] + 2) * forward_configuration.size[1] * forward_configuration.size[2]] = 0;
-						kernel_input[2 * i + 1 + j * (forward_configuration.size[0] + 2) + k * (forward_configuration.size[0] + 2) * forward_configuration.size[1] + v * (forward_configuration.size[0] + 2) * forward_configuration.size[1] * forward_configuration.size[2]] = 0;
-
+							kernel_input[i + j * (convolution_configuration.size[0] + 2) + k * (convolution_configuration.size[0] + 2) * convolution_configuration.size[1] + v * (convolution_configuration.size[0] + 2) * convolution_configuration.size[1] * convolution_configuration.size[2]] = 0;
 					}
 				}
 			}
 		}
 		//Sample buffer transfer tool. Uses staging buffer of the same size as destination buffer, which can be reduced if transfer is done sequentially in small buffers.
 		transferDataFromCPU(kernel_input, &kernel, kernelSize);
-		//Initialize application responsible for the kernel. This function loads shaders, creates pipeline and configures FFT based on configuration file. No buffer allocations inside VkFFT library.  
-		app_kernel.initializeVulkanFFT(forward_configuration);
-		//Sample forward FFT command buffer allocation + execution performed on kernel. Second number determines how many times perform application in one submit. FFT can also be appended to user defined command buffers.
-
-		//Uncomment the line below if you want to perform kernel FFT. In this sample we use predefined identitiy kernel.
-		//performVulkanFFT(&app_kernel, 1);
+		//Initialize kernel preparation. This function loads shaders, creates pipeline and configures kernel FFT. No buffer allocations inside VkFFT library.  
+		kernel_cache.initializeConvolutionKernel(convolution_configuration);
+		//Transform the kernel. It is recorded only once, next calls do nothing until the kernel is initialized again.
+		prepareConvolutionKernel(&kernel_cache);
 
 		//The kernel has been trasnformed.
 
 
 		//2. Buffer convolution with transformed kernel.
-		//Copy configuration, as it mostly remains unchanged. Change specific parts.
-		convolution_configuration = forward_configuration;
-		convolution_configuration.performConvolution = true;
-		convolution_configuration.symmetricKernel = false;//Specify if convolution kernel is symmetric. In this case we only pass upper triangle part of it in the form of: (xx, xy, yy) for 2d and (xx, xy, xz, yy, yz, zz) for 3d.
-		convolution_configuration.matrixConvolution = 3;//we do matrix convolution, so kernel is 9 numbers (3x3), but vector dimension is 3
-		convolution_configuration.coordinateFeatures = 3;//equal to matrixConvolution size
-		convolution_configuration.kernel = &kernel;
-		convolution_configuration.kernelSize = &kernelSize;
 
 		//Allocate separate buffer for the input data.
 		VkDeviceSize bufferSize = convolution_configuration.coordinateFeatures * sizeof(float) * 2 * (convolution_configuration.size[0] / 2 + 1) * convolution_configuration.size[1] * convolution_configuration.size[2];;
@@ -607,8 +736,8 @@ int main()
 		convolution_configuration.isOutputFormatted = false;//if output is a different buffer, it can have zeropadding/C2R automatically removed
 		convolution_configuration.outputBuffer = &buffer;
 		convolution_configuration.bufferSize = &bufferSize;
-		convolution_configuration.inputBufferSize = &kernelSize;
-		convolution_configuration.outputBufferSize = &kernelSize;
+		convolution_configuration.inputBufferSize = &bufferSize;
+		convolution_configuration.outputBufferSize = &bufferSize;
 
 		printf("Total memory needed for buffer: %d MB\n", bufferSize / 1024 / 1024);
 		//Fill data on CPU. It is best to perform all operations on GPU after initial upload.
@@ -628,9 +757,8 @@ int main()
 
 		//Initialize application responsible for the convolution.
 		app_convolution.initializeVulkanFFT(convolution_configuration);
-		//Sample forward FFT command buffer allocation + execution performed on kernel. FFT can also be appended to user defined command buffers.
+		//Sample convolution command buffer allocation + execution performed on buffer with the cached kernel. Convolution can also be appended to user defined command buffers.
 		performVulkanFFT(&app_convolution, 1);
-		//The kernel has been trasnformed.
 
 		float* buffer_output = (float*)malloc(bufferSize);
 		//Transfer data from GPU using staging buffer.
@@ -655,8 +783,9 @@ int main()
 		vkFreeMemory(device, bufferDeviceMemory, NULL);
 		vkDestroyBuffer(device, kernel, NULL);
 		vkFreeMemory(device, kernelDeviceMemory, NULL);
-		app_kernel.deleteVulkanFFT();
+		kernel_cache.deleteConvolutionKernel();
 		app_convolution.deleteVulkanFFT();
+		stagingPool.deleteStagingPool();
 		vkDestroyFence(device, fence, NULL);
 		vkDestroyCommandPool(device, commandPool, NULL);
 		vkDestroyDevice(device, NULL);
@@ -675,7 +804,7 @@ int main()
 		VkFFTApplication app_kernel;
 		//Zeropadding Convolution sample code
 		//Setting up FFT configuration. FFT is performed in-place with no performance loss. 
-		forward_configuration.coalescedMemory = 32;//in bits, for Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher. 
+		forward_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
 		forward_configuration.FFTdim = 3; //FFT dimension, 1D, 2D or 3D (default 1).
 		forward_configuration.size[0] = 256; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z. 
 		forward_configuration.size[1] = 256;
@@ -686,10 +815,11 @@ int main()
 		forward_configuration.performConvolution = false; //Perform convolution with precomputed kernel. As we perform forward FFT to get the kernel, it is set to false.
 		forward_configuration.performR2C = true; //Perform R2C/C2R transform. Can be combined with all other options. Reduces memory requirements by a factor of 2. Requires special input data alignment: for x*y*z system pad x*y plane to (x+2)*y with last 2*y elements reserved, total array dimensions are (x*y+2y)*z. Memory layout after R2C and before C2R can be found on github.
 		forward_configuration.coordinateFeatures = 9; //Specify dimensionality of the input feature vector (default 1). Each component is stored not as a vector, but as a separate system and padded on it's own according to other options (i.e. for x*y system of 3-vector, first x*y elements correspond to the first dimension, then goes x*y for the second, etc).
-		//coordinateFeatures number is an important constant for convolution. If we perform 1x1 convolution, it is equal to number of features, but matrixConvolution should be equal to 1. For matrix convolution, it must be equal to matrixConvolution parameter. If we perform 2x2 convolution, it is equal to 3 for symmetric kernel (stored as xx, xy, yy) and 4 for nonsymmetric (stored as xx, xy, yx, yy). Similarly, 6 (stored as xx, xy, xz, yy, yz, zz) and 9 (stored as xx, xy, xz, yx, yy, yz, zx, zy, zz) for 3x3 convolutions. 
+		//coordinateFeatures number is an important constant for convolution. If we perform 1x1 convolution, it is equal to number of features, but matrixConvolution should be equal to 1. For matrix convolution, it must be equal to matrixConvolution parameter. If we perform 2x2 convolution, it is equal to 3 for symmetric kernel (stored as xx, xy, yy) and 4 for nonsymmetric (stored as xx, xy, yx, yy). Similarly, 6 (stored as xx, xy, xz, yy, yz, zz) and 9 (stored as xx, xy, xz, yx, yy, yz, zx, zy, zz) for 3x3 convolutions. In general, NxN convolution uses N*(N+1)/2 coordinates for symmetric kernel (upper triangle, row-major) and N*N for nonsymmetric (row-major). 
 		forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
 		//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
 		forward_configuration.device = &device;
+		forward_configuration.physicalDeviceProperties = &physicalDeviceProperties;
 		sprintf(forward_configuration.shaderPath, SHADER_DIR);
 		//In this example, we perform a convolution for a real vectorfield (3vector) with a symmetric kernel (6 values). We use forward_configuration to initialize convolution kernel first from real data, then we create convolution_configuration for convolution. The buffer object from forward_configuration is passed to convolution_configuration as kernel object.
 		//1. Kernel forward FFT.
@@ -747,6 +877,7 @@ int main()
 		convolution_configuration = forward_configuration;
 		convolution_configuration.performConvolution = true;
 		convolution_configuration.symmetricKernel = false;//Specify if convolution kernel is symmetric. In this case we only pass upper triangle part of it in the form of: (xx, xy, yy) for 2d and (xx, xy, xz, yy, yz, zz) for 3d.
+		convolution_configuration.performCorrelation = false;//Specify if cross-correlation has to be performed instead of convolution. Kernel is conjugated on the fly, no need to store a conjugated copy of it.
 		convolution_configuration.matrixConvolution = 3; //we do matrix convolution, so kernel is 9 numbers (3x3), but vector dimension is 3
 		convolution_configuration.coordinateFeatures = 3; //equal to matrixConvolution size
 		convolution_configuration.kernel = &kernel;
@@ -814,6 +945,7 @@ int main()
 		vkFreeMemory(device, kernelDeviceMemory, NULL);
 		app_kernel.deleteVulkanFFT();
 		app_convolution.deleteVulkanFFT();
+		stagingPool.deleteStagingPool();
 		vkDestroyFence(device, fence, NULL);
 		vkDestroyCommandPool(device, commandPool, NULL);
 		vkDestroyDevice(device, NULL);
@@ -832,7 +964,7 @@ int main()
 		VkFFTApplication app_kernel;
 		//Convolution sample code
 		//Setting up FFT configuration. FFT is performed in-place with no performance loss. 
-		forward_configuration.coalescedMemory = 32;//in bits, for Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher. 
+		forward_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
 		forward_configuration.FFTdim = 2; //FFT dimension, 1D, 2D or 3D (default 1).
 		forward_configuration.size[0] = 32; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z. 
 		forward_configuration.size[1] = 32;
@@ -840,11 +972,12 @@ int main()
 		forward_configuration.performConvolution = false; //Perform convolution with precomputed kernel. As we perform forward FFT to get the kernel, it is set to false.
 		forward_configuration.performR2C = true; //Perform R2C/C2R transform. Can be combined with all other options. Reduces memory requirements by a factor of 2. Requires special input data alignment: for x*y*z system pad x*y plane to (x+2)*y with last 2*y elements reserved, total array dimensions are (x*y+2y)*z. Memory layout after R2C and before C2R can be found on github.
 		forward_configuration.coordinateFeatures = 3; //Specify dimensionality of the input feature vector (default 1). Each component is stored not as a vector, but as a separate system and padded on it's own according to other options (i.e. for x*y system of 3-vector, first x*y elements correspond to the first dimension, then goes x*y for the second, etc).
-		//coordinateFeatures number is an important constant for convolution. If we perform 1x1 convolution, it is equal to number of features, but matrixConvolution should be equal to 1. For matrix convolution, it must be equal to matrixConvolution parameter. If we perform 2x2 convolution, it is equal to 3 for symmetric kernel (stored as xx, xy, yy) and 4 for nonsymmetric (stored as xx, xy, yx, yy). Similarly, 6 (stored as xx, xy, xz, yy, yz, zz) and 9 (stored as xx, xy, xz, yx, yy, yz, zx, zy, zz) for 3x3 convolutions. 
+		//coordinateFeatures number is an important constant for convolution. If we perform 1x1 convolution, it is equal to number of features, but matrixConvolution should be equal to 1. For matrix convolution, it must be equal to matrixConvolution parameter. If we perform 2x2 convolution, it is equal to 3 for symmetric kernel (stored as xx, xy, yy) and 4 for nonsymmetric (stored as xx, xy, yx, yy). Similarly, 6 (stored as xx, xy, xz, yy, yz, zz) and 9 (stored as xx, xy, xz, yx, yy, yz, zx, zy, zz) for 3x3 convolutions. In general, NxN convolution uses N*(N+1)/2 coordinates for symmetric kernel (upper triangle, row-major) and N*N for nonsymmetric (row-major). 
 		forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
 		forward_configuration.numberBatches = 2;
 		//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
 		forward_configuration.device = &device;
+		forward_configuration.physicalDeviceProperties = &physicalDeviceProperties;
 		sprintf(forward_configuration.shaderPath, SHADER_DIR);
 		//In this example, we perform a convolution for a real vectorfield (3vector) with a symmetric kernel (6 values). We use forward_configuration to initialize convolution kernel first from real data, then we create convolution_configuration for convolution. The buffer object from forward_configuration is passed to convolution_configuration as kernel object.
 		//1. Kernel forward FFT.
@@ -898,6 +1031,7 @@ int main()
 		convolution_configuration = forward_configuration;
 		convolution_configuration.performConvolution = true;
 		convolution_configuration.symmetricKernel = false;//Specify if convolution kernel is symmetric. In this case we only pass upper triangle part of it in the form of: (xx, xy, yy) for 2d and (xx, xy, xz, yy, yz, zz) for 3d.
+		convolution_configuration.performCorrelation = false;//Specify if cross-correlation has to be performed instead of convolution. Kernel is conjugated on the fly, no need to store a conjugated copy of it.
 		convolution_configuration.kernel = &kernel;
 		convolution_configuration.kernelSize = &kernelSize;
 		convolution_configuration.numberBatches = 1;//one batch - numberKernels convolutions
@@ -975,6 +1109,7 @@ int main()
 		vkFreeMemory(device, kernelDeviceMemory, NULL);
 		app_kernel.deleteVulkanFFT();
 		app_convolution.deleteVulkanFFT();
+		stagingPool.deleteStagingPool();
 		vkDestroyFence(device, fence, NULL);
 		vkDestroyCommandPool(device, commandPool, NULL);
 		vkDestroyDevice(device, NULL);
@@ -1001,7 +1136,7 @@ int main()
 				VkFFTApplication app_inverse;
 				//FFT + iFFT sample code. Note that it is only useful for benchmark, as the we don't have transposition step after FFT - data is not unshuffled.
 				//Setting up FFT configuration for forward and inverse FFT.
-				forward_configuration.coalescedMemory = 32;//in bits, for Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher. 
+				forward_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
 				
 				forward_configuration.FFTdim = benchmark_dimensions[n][3]; //FFT dimension, 1D, 2D or 3D (default 1).
 				forward_configuration.size[0] = benchmark_dimensions[n][0]; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z.   
@@ -1020,6 +1155,7 @@ int main()
 				forward_configuration.inverse = false; //Direction of FFT. false - forward, true - inverse.
 				//After this, configuration file contains pointers to Vulkan objects needed to work with the GPU: VkDevice* device - created device, [VkDeviceSize *bufferSize, VkBuffer *buffer, VkDeviceMemory* bufferDeviceMemory] - allocated GPU memory FFT is performed on. [VkDeviceSize *kernelSize, VkBuffer *kernel, VkDeviceMemory* kernelDeviceMemory] - allocated GPU memory, where kernel for convolution is stored.
 				forward_configuration.device = &device;
+				forward_configuration.physicalDeviceProperties = &physicalDeviceProperties;
 				//Custom path to the floder with shaders, default is "shaders/");
 				sprintf(forward_configuration.shaderPath, SHADER_DIR);
 
@@ -1093,6 +1229,690 @@ int main()
 				app_inverse.deleteVulkanFFT();
 			}
 		}
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 5:
+	{
+		//5 - overlap-save streaming convolution of a long 1D signal with a FIR kernel. Latency (one block per submit) and throughput (whole ring buffer per submit) are measured for different block FFT sizes.
+		const uint32_t num_benchmark_samples = 5;
+		const uint32_t num_runs = 5;
+		const uint32_t kernelLength = 129;
+		const uint32_t numberRingBlocks = 64;
+		uint32_t benchmark_dimensions[num_benchmark_samples] = { 256, 512, 1024, 2048, 4096 };
+		for (uint32_t n = 0; n < num_benchmark_samples; n++) {
+			VkFFTConfiguration kernel_configuration;
+			VkFFTConfiguration convolution_configuration;
+			VkFFTApplication app_kernel;
+			VkFFTStreamingConvolution stream;
+			kernel_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
+			kernel_configuration.FFTdim = 1; //Streaming convolution works on 1D C2C blocks.
+			kernel_configuration.size[0] = benchmark_dimensions[n]; //Block FFT size. Each block produces size[0] - kernelLength + 1 new filtered samples.
+			kernel_configuration.performConvolution = false;
+			kernel_configuration.performR2C = false;
+			kernel_configuration.coordinateFeatures = 1;
+			kernel_configuration.inverse = false;
+			kernel_configuration.device = &device;
+			kernel_configuration.physicalDeviceProperties = &physicalDeviceProperties;
+			sprintf(kernel_configuration.shaderPath, SHADER_DIR);
+
+			//1. Kernel forward FFT. Kernel is zeropadded to the block FFT size.
+			VkDeviceSize kernelSize = sizeof(float) * 2 * kernel_configuration.size[0];
+			VkBuffer kernel = {};
+			VkDeviceMemory kernelDeviceMemory = {};
+			allocateFFTBuffer(&kernel, &kernelDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, kernelSize);
+			kernel_configuration.buffer = &kernel;
+			kernel_configuration.inputBuffer = &kernel;
+			kernel_configuration.outputBuffer = &kernel;
+			kernel_configuration.bufferSize = &kernelSize;
+			kernel_configuration.inputBufferSize = &kernelSize;
+			kernel_configuration.outputBufferSize = &kernelSize;
+			float* kernel_taps = (float*)malloc(sizeof(float) * kernelLength);
+			float* kernel_input = (float*)malloc(kernelSize);
+			for (uint32_t i = 0; i < kernelLength; i++)
+				kernel_taps[i] = cos(0.1 * i) / kernelLength;
+			for (uint32_t i = 0; i < kernel_configuration.size[0]; i++) {
+				kernel_input[2 * i] = (i < kernelLength) ? kernel_taps[i] : 0;
+				kernel_input[2 * i + 1] = 0;
+			}
+			transferDataFromCPU(kernel_input, &kernel, kernelSize);
+			app_kernel.initializeVulkanFFT(kernel_configuration);
+			performVulkanFFT(&app_kernel, 1);
+
+			//2. Streaming convolution. Work buffer holds the FFT work area and the overlap tail of the previous block.
+			convolution_configuration = kernel_configuration;
+			convolution_configuration.performConvolution = true;
+			convolution_configuration.kernel = &kernel;
+			convolution_configuration.kernelSize = &kernelSize;
+			VkDeviceSize workSize = sizeof(float) * 2 * (convolution_configuration.size[0] + kernelLength - 1);
+			VkBuffer work = {};
+			VkDeviceMemory workDeviceMemory = {};
+			allocateFFTBuffer(&work, &workDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, workSize);
+			convolution_configuration.buffer = &work;
+			convolution_configuration.bufferSize = &workSize;
+			convolution_configuration.inputBufferSize = &workSize;
+			convolution_configuration.outputBufferSize = &workSize;
+			uint32_t blockLength = convolution_configuration.size[0] - kernelLength + 1;
+			//Ring buffer of input blocks. Filtered blocks are written back to the same slots.
+			VkDeviceSize ringSize = sizeof(float) * 2 * blockLength * numberRingBlocks;
+			VkBuffer ring = {};
+			VkDeviceMemory ringDeviceMemory = {};
+			allocateFFTBuffer(&ring, &ringDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, ringSize);
+			float* ring_input = (float*)malloc(ringSize);
+			for (uint32_t i = 0; i < blockLength * numberRingBlocks; i++) {
+				ring_input[2 * i] = (i % 7) - 3.0;
+				ring_input[2 * i + 1] = (i % 5) - 2.0;
+			}
+			transferDataFromCPU(ring_input, &ring, ringSize);
+			stream.initializeStreamingConvolution(convolution_configuration, kernelLength, &ring, numberRingBlocks);
+
+			//Check one pass over the ring against direct FIR filtering on CPU. Stream starts from zero history.
+			performStreamingConvolution(&stream, numberRingBlocks, true);
+			float* ring_output = (float*)malloc(ringSize);
+			transferDataToCPU(ring_output, &ring, ringSize);
+			double maxError = 0;
+			for (uint32_t i = 0; i < blockLength * numberRingBlocks; i++) {
+				double re = 0;
+				double im = 0;
+				for (uint32_t m = 0; (m < kernelLength) && (m <= i); m++) {
+					re += kernel_taps[m] * ring_input[2 * (i - m)];
+					im += kernel_taps[m] * ring_input[2 * (i - m) + 1];
+				}
+				if (fabs(re - ring_output[2 * i]) > maxError) maxError = fabs(re - ring_output[2 * i]);
+				if (fabs(im - ring_output[2 * i + 1]) > maxError) maxError = fabs(im - ring_output[2 * i + 1]);
+			}
+
+			for (uint32_t r = 0; r < num_runs; r++) {
+				//Latency - one block per submit.
+				float latency = 0;
+				for (uint32_t b = 0; b < numberRingBlocks; b++)
+					latency += performStreamingConvolution(&stream, 1, false);
+				latency /= numberRingBlocks;
+				//Throughput - whole ring buffer per submit.
+				float chunkTime = performStreamingConvolution(&stream, numberRingBlocks, false);
+				printf("Block FFT: %d, kernel: %d, new samples per block: %d, run: %d, latency per block: %0.3f ms, chunk of %d blocks: %0.3f ms, throughput: %0.3f MSamples/s, max error: %e\n", convolution_configuration.size[0], kernelLength, blockLength, r, latency, numberRingBlocks, chunkTime, blockLength * numberRingBlocks / chunkTime / 1000.0, maxError);
+			}
+			free(kernel_taps);
+			free(kernel_input);
+			free(ring_input);
+			free(ring_output);
+			vkDestroyBuffer(device, ring, NULL);
+			vkFreeMemory(device, ringDeviceMemory, NULL);
+			vkDestroyBuffer(device, work, NULL);
+			vkFreeMemory(device, workDeviceMemory, NULL);
+			vkDestroyBuffer(device, kernel, NULL);
+			vkFreeMemory(device, kernelDeviceMemory, NULL);
+			app_kernel.deleteVulkanFFT();
+			stream.deleteStreamingConvolution();
+		}
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 6:
+	{
+		//6 - batched multi-input, multi-kernel convolution benchmark. numberBatches inputs are convolved with numberKernels kernels in one submission. Each input spectrum is read once and multiplied by all kernels in registers. Input batch b convolved with kernel k is stored as output batch b*numberKernels+k.
+		const uint32_t num_benchmark_samples = 4;
+		const uint32_t num_runs = 3;
+		uint32_t benchmark_batches[num_benchmark_samples] = { 1, 2, 4, 8 };
+		uint32_t benchmark_kernels[num_benchmark_samples] = { 1, 2, 4, 8 };
+		for (uint32_t nb = 0; nb < num_benchmark_samples; nb++) {
+			for (uint32_t nk = 0; nk < num_benchmark_samples; nk++) {
+				VkFFTConfiguration convolution_configuration;
+				VkFFTApplication app_convolution;
+				VkFFTConvolutionKernel kernel_cache;
+				convolution_configuration.coalescedMemory = 0;//in bytes, 0 - detected from the device. For Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128. For AMD and Intel use 64. Gonna work regardles, but if specified by user correctly, the performance will be higher.
+				convolution_configuration.FFTdim = 2; //FFT dimension, 1D, 2D or 3D (default 1).
+				convolution_configuration.size[0] = 512; //Multidimensional FFT dimensions sizes (default 1). For best performance (and stability), order dimensions in descendant size order as: x>y>z. 
+				convolution_configuration.size[1] = 512;
+				convolution_configuration.size[2] = 1;
+				convolution_configuration.performConvolution = true;
+				convolution_configuration.performR2C = true;
+				convolution_configuration.coordinateFeatures = 1;
+				convolution_configuration.numberBatches = benchmark_batches[nb];//number of inputs
+				convolution_configuration.numberKernels = benchmark_kernels[nk];//number of kernels each input is convolved with
+				convolution_configuration.device = &device;
+				convolution_configuration.physicalDeviceProperties = &physicalDeviceProperties;
+				sprintf(convolution_configuration.shaderPath, SHADER_DIR);
+
+				//1. Kernel forward FFT. Kernel k is a delta function multiplied by (k + 1).
+				VkDeviceSize kernelSize = kernel_cache.getKernelBufferSize(convolution_configuration);
+				VkBuffer kernel = {};
+				VkDeviceMemory kernelDeviceMemory = {};
+				allocateFFTBuffer(&kernel, &kernelDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, kernelSize);
+				convolution_configuration.kernel = &kernel;
+				convolution_configuration.kernelSize = &kernelSize;
+				uint32_t systemSize = (convolution_configuration.size[0] + 2) * convolution_configuration.size[1] * convolution_configuration.size[2];
+				float* kernel_input = (float*)calloc(kernelSize / sizeof(float), sizeof(float));
+				for (uint32_t f = 0; f < convolution_configuration.numberKernels; f++)
+					kernel_input[f * systemSize] = f + 1;
+				transferDataFromCPU(kernel_input, &kernel, kernelSize);
+				kernel_cache.initializeConvolutionKernel(convolution_configuration);
+				prepareConvolutionKernel(&kernel_cache);
+
+				//2. Input buffer holds numberBatches inputs, output buffer holds numberBatches*numberKernels results. With one kernel convolution is done in-place.
+				VkDeviceSize bufferSize = convolution_configuration.numberBatches * systemSize * sizeof(float);
+				VkBuffer buffer = {};
+				VkDeviceMemory bufferDeviceMemory = {};
+				allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, bufferSize);
+				VkDeviceSize outputBufferSize = convolution_configuration.numberKernels * bufferSize;
+				VkBuffer outputBuffer = {};
+				VkDeviceMemory outputBufferDeviceMemory = {};
+				if (convolution_configuration.numberKernels > 1)
+					allocateFFTBuffer(&outputBuffer, &outputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_HEAP_DEVICE_LOCAL_BIT, outputBufferSize);
+				convolution_configuration.buffer = &buffer;
+				convolution_configuration.inputBuffer = &buffer;
+				convolution_configuration.outputBuffer = (convolution_configuration.numberKernels > 1) ? &outputBuffer : &buffer;
+				convolution_configuration.bufferSize = &bufferSize;
+				convolution_configuration.inputBufferSize = &bufferSize;
+				convolution_configuration.outputBufferSize = (convolution_configuration.numberKernels > 1) ? &outputBufferSize : &bufferSize;
+				//Input batch b is filled with (b + 1).
+				float* buffer_input = (float*)calloc(bufferSize / sizeof(float), sizeof(float));
+				for (uint32_t b = 0; b < convolution_configuration.numberBatches; b++) {
+					for (uint32_t j = 0; j < convolution_configuration.size[1]; j++) {
+						for (uint32_t i = 0; i < convolution_configuration.size[0]; i++) {
+							buffer_input[i + j * convolution_configuration.size[0] + b * systemSize] = b + 1;
+						}
+					}
+				}
+				transferDataFromCPU(buffer_input, &buffer, bufferSize);
+				app_convolution.initializeVulkanFFT(convolution_configuration);
+
+				//Check one submission: output b*numberKernels+k has to be equal to (b + 1) * (k + 1), as the kernel is a scaled delta function and inverse FFT is normalized.
+				performVulkanFFTTimed(&app_convolution, 1);
+				float* buffer_output = (float*)malloc(outputBufferSize);
+				transferDataToCPU(buffer_output, (convolution_configuration.numberKernels > 1) ? &outputBuffer : &buffer, outputBufferSize);
+				double maxError = 0;
+				for (uint32_t b = 0; b < convolution_configuration.numberBatches; b++) {
+					for (uint32_t f = 0; f < convolution_configuration.numberKernels; f++) {
+						double expected = (b + 1.0) * (f + 1.0);
+						for (uint32_t j = 0; j < convolution_configuration.size[1]; j++) {
+							for (uint32_t i = 0; i < convolution_configuration.size[0]; i++) {
+								double error = fabs(buffer_output[i + j * convolution_configuration.size[0] + (b * convolution_configuration.numberKernels + f) * systemSize] - expected) / expected;
+								if (error > maxError) maxError = error;
+							}
+						}
+					}
+				}
+				for (uint32_t r = 0; r < num_runs; r++) {
+					uint32_t batch = 20;
+					float totTime = performVulkanFFTTimed(&app_convolution, batch);
+					printf("System: %dx%d, inputs: %d, kernels: %d, run: %d, time per submission: %0.3f ms, time per output: %0.3f ms, max relative error: %e\n", convolution_configuration.size[0], convolution_configuration.size[1], convolution_configuration.numberBatches, convolution_configuration.numberKernels, r, totTime, totTime / (convolution_configuration.numberBatches * convolution_configuration.numberKernels), maxError);
+				}
+				free(kernel_input);
+				free(buffer_input);
+				free(buffer_output);
+				vkDestroyBuffer(device, buffer, NULL);
+				vkFreeMemory(device, bufferDeviceMemory, NULL);
+				if (convolution_configuration.numberKernels > 1) {
+					vkDestroyBuffer(device, outputBuffer, NULL);
+					vkFreeMemory(device, outputBufferDeviceMemory, NULL);
+				}
+				vkDestroyBuffer(device, kernel, NULL);
+				vkFreeMemory(device, kernelDeviceMemory, NULL);
+				kernel_cache.deleteConvolutionKernel();
+				app_convolution.deleteVulkanFFT();
+			}
+		}
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 7:
+	{
+		//7 - accuracy validation is the VkFFT_validation executable, which is also registered as a CTest test
+		printf("Accuracy validation is built as VkFFT_validation, run it directly or with ctest\n");
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 8:
+	{
+		//8 - chunked streaming FFT. Dataset of 8 chunks is streamed through 3 device buffers: upload of the next chunk, FFT of the current one and download of the previous one overlap. Throughput is compared with the same pipeline without FFT, which is bound by host<->device bandwidth, and, if VKFFT_CPU_BACKEND is defined, the result with the CPU backend run on the same chunks
+		const uint32_t num_systems = 3;
+		const uint32_t num_chunks = 8;
+		uint32_t systems[num_systems][4] = { {1, 4096, 1, 256}, {2, 256, 256, 16}, {2, 1024, 1024, 2} }; //FFTdim, size[0], size[1], batches per chunk
+		for (uint32_t n = 0; n < num_systems; n++) {
+			VkFFTConfiguration configuration;
+			configuration.FFTdim = systems[n][0];
+			configuration.size[0] = systems[n][1];
+			configuration.size[1] = systems[n][2];
+			configuration.numberBatches = systems[n][3];
+			configuration.device = &device;
+			configuration.physicalDevice = &physicalDevice;
+			configuration.queue = &queue;
+			sprintf(configuration.shaderPath, SHADER_DIR);
+			//sample device has one queue - uploads and downloads share it with the FFTs
+			VkFFTStreamingExecutor executor;
+			if (!executor.initializeStreamingExecutor(configuration, queueFamilyIndex, NULL, queueFamilyIndex, 3)) break;
+			uint64_t numberBatches = (uint64_t)num_chunks * configuration.numberBatches;
+			uint64_t count = numberBatches * executor.batchSize / sizeof(float);
+			float* buffer_input = (float*)malloc(count * sizeof(float));
+			float* buffer_output = (float*)malloc(count * sizeof(float));
+			for (uint64_t i = 0; i < count; i++)
+				buffer_input[i] = 2 * ((float)rand()) / RAND_MAX - 1.0;
+			executor.executeStreaming(buffer_input, buffer_output, numberBatches, true); //warmup
+			VkFFTStreamingStatistics transfer = executor.executeStreaming(buffer_input, buffer_output, numberBatches, true);
+			VkFFTStreamingStatistics stream = executor.executeStreaming(buffer_input, buffer_output, numberBatches);
+			executor.deleteStreamingExecutor();
+			printf("System: %dx%d, %llu batches in %llu chunks: %.3f ms, %.2f GB/s streamed, %.2f GB/s without FFT (%.0f%% of transfer bound)", configuration.size[0], configuration.size[1], (unsigned long long)numberBatches, (unsigned long long)stream.numberChunks, stream.time, stream.throughput, transfer.throughput, (transfer.throughput > 0) ? 100 * stream.throughput / transfer.throughput : 0);
+#ifdef VKFFT_CPU_BACKEND
+			float* buffer_cpu = (float*)malloc(count * sizeof(float));
+			configuration.device = NULL; //same chunks on the CPU backend
+			VkFFTStreamingExecutor executor_cpu;
+			executor_cpu.initializeStreamingExecutor(configuration, 0, NULL, 0);
+			executor_cpu.executeStreaming(buffer_input, buffer_cpu, numberBatches);
+			executor_cpu.deleteStreamingExecutor();
+			double maxDifference = 0;
+			double maxValue = 0;
+			for (uint64_t i = 0; i < count; i++) {
+				if (fabs(buffer_output[i] - buffer_cpu[i]) > maxDifference) maxDifference = fabs(buffer_output[i] - buffer_cpu[i]);
+				if (fabs(buffer_cpu[i]) > maxValue) maxValue = fabs(buffer_cpu[i]);
+			}
+			printf(", max relative difference from CPU backend: %.3e", (maxValue > 0) ? maxDifference / maxValue : 0);
+			free(buffer_cpu);
+#endif
+			printf("\n");
+			free(buffer_input);
+			free(buffer_output);
+		}
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 9:
+	{
+		//9 - zero-copy input from host memory. Frames are page-aligned host buffers of real unpadded data, transformed by out-of-place R2C FFT with unpadded input (isInputFormatted). Staging flow - memcpy to the staging pool, device copy, FFT. Imported flow - the frame is imported with VK_EXT_external_memory_host and copied to the device by the GPU, no host memcpy. Direct flow - the imported frame is the inputBuffer of the FFT, read by the shaders over the bus
+		if (!isHostImportSupported)
+			printf("VK_EXT_external_memory_host is not supported by the device\n");
+		const uint32_t num_systems = 3;
+		const uint32_t num_frames = 100;
+		uint32_t systems[num_systems][2] = { {512, 512}, {1024, 1024}, {2048, 2048} };
+		for (uint32_t n = 0; (isHostImportSupported) && (n < num_systems); n++) {
+			VkFFTConfiguration configuration;
+			configuration.FFTdim = 2;
+			configuration.size[0] = systems[n][0];
+			configuration.size[1] = systems[n][1];
+			configuration.performR2C = true;
+			configuration.isInputFormatted = true;
+			configuration.device = &device;
+			configuration.physicalDevice = &physicalDevice;
+			sprintf(configuration.shaderPath, SHADER_DIR);
+			VkDeviceSize alignment = VkFFTGetHostImportAlignment(physicalDevice);
+			VkDeviceSize frameSize = ((VkDeviceSize)sizeof(float) * configuration.size[0] * configuration.size[1] + alignment - 1) / alignment * alignment;
+			VkDeviceSize outputBufferSize = (VkDeviceSize)sizeof(float) * 2 * (configuration.size[0] / 2 + 1) * configuration.size[1];
+			float* frame = (float*)allocateHostFrame(frameSize, alignment);
+			for (uint64_t i = 0; i < frameSize / sizeof(float); i++)
+				frame[i] = 2 * ((float)rand()) / RAND_MAX - 1.0;
+			VkBuffer hostBuffer = {};
+			VkDeviceMemory hostBufferDeviceMemory = {};
+			if (!VkFFTImportHostBuffer(device, physicalDevice, frame, frameSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, &hostBuffer, &hostBufferDeviceMemory)) {
+				freeHostFrame(frame);
+				break;
+			}
+			VkBuffer inputBuffer = {};
+			VkDeviceMemory inputBufferDeviceMemory = {};
+			allocateFFTBuffer(&inputBuffer, &inputBufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frameSize);
+			VkBuffer buffer = {};
+			VkDeviceMemory bufferDeviceMemory = {};
+			allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, outputBufferSize);
+			configuration.buffer = &buffer;
+			configuration.outputBuffer = &buffer;
+			configuration.bufferSize = &outputBufferSize;
+			configuration.outputBufferSize = &outputBufferSize;
+			configuration.inputBufferSize = &frameSize;
+			VkFFTApplication app_device;
+			configuration.inputBuffer = &inputBuffer;
+			app_device.initializeVulkanFFT(configuration);
+			VkFFTApplication app_host;
+			configuration.inputBuffer = &hostBuffer;
+			app_host.initializeVulkanFFT(configuration);
+			VkCommandBuffer commandBuffers[3] = { recordFrame(&app_device, NULL, NULL, 0), recordFrame(&app_device, &hostBuffer, &inputBuffer, frameSize), recordFrame(&app_host, NULL, NULL, 0) };
+			const char* flowNames[3] = { "staging", "imported copy", "imported direct" };
+			float* buffer_output[3];
+			double frameTime[3];
+			for (uint32_t f = 0; f < 3; f++) {
+				buffer_output[f] = (float*)malloc(outputBufferSize);
+				frameTime[f] = 0;
+				for (uint32_t t = 0; t < num_frames + 5; t++) {
+					auto timeStart = std::chrono::steady_clock::now();
+					if (f == 0) transferDataFromCPU(frame, &inputBuffer, frameSize);
+					submitFrame(commandBuffers[f]);
+					auto timeEnd = std::chrono::steady_clock::now();
+					//first 5 frames are a warmup
+					if (t >= 5) frameTime[f] += std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() * 0.001 / num_frames;
+				}
+				transferDataToCPU(buffer_output[f], &buffer, outputBufferSize);
+			}
+			printf("System: %dx%d R2C, %.1f MB per frame\n", configuration.size[0], configuration.size[1], frameSize / 1048576.0);
+			for (uint32_t f = 0; f < 3; f++) {
+				double maxDifference = 0;
+				for (uint64_t i = 0; i < outputBufferSize / sizeof(float); i++)
+					if (fabs(buffer_output[f][i] - buffer_output[0][i]) > maxDifference) maxDifference = fabs(buffer_output[f][i] - buffer_output[0][i]);
+				printf("  %s: %.3f ms per frame (%.0f%% of staging flow), max difference from staging flow: %.3e\n", flowNames[f], frameTime[f], 100 * frameTime[f] / frameTime[0], maxDifference);
+				free(buffer_output[f]);
+			}
+			vkFreeCommandBuffers(device, commandPool, 3, commandBuffers);
+			app_device.deleteVulkanFFT();
+			app_host.deleteVulkanFFT();
+			vkDestroyBuffer(device, buffer, NULL);
+			vkFreeMemory(device, bufferDeviceMemory, NULL);
+			vkDestroyBuffer(device, inputBuffer, NULL);
+			vkFreeMemory(device, inputBufferDeviceMemory, NULL);
+			vkDestroyBuffer(device, hostBuffer, NULL);
+			vkFreeMemory(device, hostBufferDeviceMemory, NULL);
+			freeHostFrame(frame);
+		}
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 10:
+	{
+		//10 - out-of-core 3D FFT. Input volume is a memory-mapped file, result is written to another memory-mapped file. Device memory is limited to slabs of 32MB: 2D FFTs of slabs of z planes, then 1D FFTs along z of slabs of y rows, transposed on the host. Throughput is compared with a sequential read of the input file, result is compared with the CPU backend if VKFFT_CPU_BACKEND is defined
+		const uint32_t num_systems = 2;
+		uint32_t systems[num_systems][3] = { {256, 256, 512}, {512, 512, 256} };
+		const VkDeviceSize maxSlabSize = 32 * 1048576;
+		for (uint32_t n = 0; n < num_systems; n++) {
+			VkFFTConfiguration configuration;
+			configuration.FFTdim = 3;
+			configuration.size[0] = systems[n][0];
+			configuration.size[1] = systems[n][1];
+			configuration.size[2] = systems[n][2];
+			configuration.device = &device;
+			configuration.physicalDevice = &physicalDevice;
+			configuration.queue = &queue;
+			sprintf(configuration.shaderPath, SHADER_DIR);
+			uint64_t count = 2 * (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+			uint64_t volumeSize = count * sizeof(float);
+			float* buffer_input = (float*)mapFile("VkFFT_input.bin", volumeSize, true);
+			float* buffer_output = (float*)mapFile("VkFFT_output.bin", volumeSize, true);
+			if ((buffer_input == NULL) || (buffer_output == NULL)) {
+				printf("Can't map input and output files\n");
+				if (buffer_input) unmapFile(buffer_input, volumeSize);
+				if (buffer_output) unmapFile(buffer_output, volumeSize);
+				break;
+			}
+			for (uint64_t i = 0; i < count; i++)
+				buffer_input[i] = 2 * ((float)rand()) / RAND_MAX - 1.0;
+			unmapFile(buffer_input, volumeSize);
+			buffer_input = (float*)mapFile("VkFFT_input.bin", volumeSize, false);
+			//sequential read of the input file - the bound for one pass over the volume
+			auto timeStart = std::chrono::steady_clock::now();
+			float sum = 0;
+			for (uint64_t i = 0; i < count; i++)
+				sum += buffer_input[i];
+			volatile float checksum = sum; //keeps the read loop from being optimized out
+			(void)checksum;
+			auto timeEnd = std::chrono::steady_clock::now();
+			double readTime = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() * 0.001;
+			VkFFTOutOfCore outOfCore;
+			//sample device has one queue - uploads and downloads share it with the FFTs
+			if (!outOfCore.initializeOutOfCore(configuration, maxSlabSize, queueFamilyIndex, NULL, queueFamilyIndex)) {
+				unmapFile(buffer_input, volumeSize);
+				unmapFile(buffer_output, volumeSize);
+				break;
+			}
+			VkFFTStreamingStatistics statistics = outOfCore.executeOutOfCore(buffer_input, buffer_output);
+			outOfCore.deleteOutOfCore();
+			printf("System: %dx%dx%d, %.0f MB volume, slabs of %llu planes and %llu rows, %llu chunks: %.3f ms, %.2f GB/s of volume (%.0f%% of sequential file read at %.2f GB/s)", configuration.size[0], configuration.size[1], configuration.size[2], volumeSize / 1048576.0, (unsigned long long)outOfCore.planesPerSlab, (unsigned long long)outOfCore.rowsPerSlab, (unsigned long long)statistics.numberChunks, statistics.time, volumeSize / (statistics.time * 1e6), (readTime > 0) ? 100 * readTime / statistics.time : 0, (readTime > 0) ? volumeSize / (readTime * 1e6) : 0);
+#ifdef VKFFT_CPU_BACKEND
+			float* buffer_cpu = (float*)malloc(volumeSize);
+			memcpy(buffer_cpu, buffer_input, volumeSize);
+			configuration.device = NULL; //whole volume on the CPU backend
+			VkFFTApplication app_cpu;
+			app_cpu.initializeVulkanFFT(configuration);
+			app_cpu.executeOnCPU(buffer_cpu);
+			app_cpu.deleteVulkanFFT();
+			double maxDifference = 0;
+			double maxValue = 0;
+			for (uint64_t i = 0; i < count; i++) {
+				if (fabs(buffer_output[i] - buffer_cpu[i]) > maxDifference) maxDifference = fabs(buffer_output[i] - buffer_cpu[i]);
+				if (fabs(buffer_cpu[i]) > maxValue) maxValue = fabs(buffer_cpu[i]);
+			}
+			printf(", max relative difference from CPU backend: %.3e", (maxValue > 0) ? maxDifference / maxValue : 0);
+			free(buffer_cpu);
+#endif
+			printf("\n");
+			unmapFile(buffer_input, volumeSize);
+			unmapFile(buffer_output, volumeSize);
+		}
+		remove("VkFFT_input.bin");
+		remove("VkFFT_output.bin");
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 11:
+	{
+		//11 - thousands of small FFT+iFFT calls, each submitted and waited for separately. Recorded flow - new command buffer with VkFFTAppend every call, as performVulkanFFTiFFT. Secondary flow - forward and inverse are recorded once with VkFFTRecordCommandBuffer, every call records a primary with vkCmdExecuteCommands. Primary flow - one simultaneous use primary recorded once is submitted every call. CPU recording time per call is reported separately from the total time per call
+		const uint32_t num_systems = 3;
+		const uint32_t num_calls = 2000;
+		uint32_t systems[num_systems] = { 64, 256, 1024 };
+		for (uint32_t n = 0; n < num_systems; n++) {
+			VkFFTConfiguration forward_configuration;
+			forward_configuration.FFTdim = 1;
+			forward_configuration.size[0] = systems[n];
+			forward_configuration.numberBatches = 16;
+			forward_configuration.device = &device;
+			forward_configuration.physicalDevice = &physicalDevice;
+			sprintf(forward_configuration.shaderPath, SHADER_DIR);
+			VkDeviceSize bufferSize = (uint64_t)sizeof(float) * 2 * forward_configuration.size[0] * forward_configuration.numberBatches;
+			VkBuffer buffer = {};
+			VkDeviceMemory bufferDeviceMemory = {};
+			allocateFFTBuffer(&buffer, &bufferDeviceMemory, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+			forward_configuration.buffer = &buffer;
+			forward_configuration.inputBuffer = &buffer;
+			forward_configuration.outputBuffer = &buffer;
+			forward_configuration.bufferSize = &bufferSize;
+			forward_configuration.inputBufferSize = &bufferSize;
+			forward_configuration.outputBufferSize = &bufferSize;
+			VkFFTConfiguration inverse_configuration = forward_configuration;
+			inverse_configuration.inverse = true;
+			VkFFTApplication app_forward;
+			VkFFTApplication app_inverse;
+			app_forward.initializeVulkanFFT(forward_configuration);
+			app_inverse.initializeVulkanFFT(inverse_configuration);
+			VkCommandBuffer secondaryCommandBuffers[2] = {};
+			app_forward.VkFFTRecordCommandBuffer(commandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, &secondaryCommandBuffers[0]);
+			app_inverse.VkFFTRecordCommandBuffer(commandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, &secondaryCommandBuffers[1]);
+			//simultaneous use primary with both transforms, recorded once
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+			commandBufferAllocateInfo.commandPool = commandPool;
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			commandBufferAllocateInfo.commandBufferCount = 1;
+			VkCommandBuffer primaryCommandBuffer = {};
+			vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &primaryCommandBuffer);
+			VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+			vkBeginCommandBuffer(primaryCommandBuffer, &commandBufferBeginInfo);
+			vkCmdExecuteCommands(primaryCommandBuffer, 2, secondaryCommandBuffers);
+			vkEndCommandBuffer(primaryCommandBuffer);
+
+			float* buffer_input = (float*)malloc(bufferSize);
+			for (uint64_t i = 0; i < bufferSize / sizeof(float); i++)
+				buffer_input[i] = 2 * ((float)rand()) / RAND_MAX - 1.0;
+			const char* flowNames[3] = { "recorded", "secondary", "primary" };
+			float* buffer_output[3];
+			double recordTime[3];
+			double callTime[3];
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			for (uint32_t f = 0; f < 3; f++) {
+				transferDataFromCPU(buffer_input, &buffer, bufferSize);
+				recordTime[f] = 0;
+				auto timeStart = std::chrono::steady_clock::now();
+				for (uint32_t t = 0; t < num_calls; t++) {
+					auto timeRecord = std::chrono::steady_clock::now();
+					VkCommandBuffer commandBuffer = primaryCommandBuffer;
+					if (f < 2) {
+						vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+						vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+						if (f == 0) {
+							app_forward.VkFFTAppend(commandBuffer);
+							app_inverse.VkFFTAppend(commandBuffer);
+						}
+						else
+							vkCmdExecuteCommands(commandBuffer, 2, secondaryCommandBuffers);
+						vkEndCommandBuffer(commandBuffer);
+					}
+					auto timeRecordEnd = std::chrono::steady_clock::now();
+					recordTime[f] += std::chrono::duration_cast<std::chrono::nanoseconds>(timeRecordEnd - timeRecord).count() * 0.000001 / num_calls;
+					submitFrame(commandBuffer);
+					if (f < 2) vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+				}
+				auto timeEnd = std::chrono::steady_clock::now();
+				callTime[f] = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() * 0.001 / num_calls;
+				buffer_output[f] = (float*)malloc(bufferSize);
+				transferDataToCPU(buffer_output[f], &buffer, bufferSize);
+			}
+			printf("System: %d, batch: %d, %d FFT+iFFT calls\n", forward_configuration.size[0], forward_configuration.numberBatches, num_calls);
+			for (uint32_t f = 0; f < 3; f++) {
+				double maxDifference = 0;
+				for (uint64_t i = 0; i < bufferSize / sizeof(float); i++)
+					if (fabs(buffer_output[f][i] - buffer_output[0][i]) > maxDifference) maxDifference = fabs(buffer_output[f][i] - buffer_output[0][i]);
+				printf("  %s: CPU recording %.4f ms per call, %.4f ms per call in total (%.0f%% of recorded flow), max difference from recorded flow: %.3e\n", flowNames[f], recordTime[f], callTime[f], 100 * callTime[f] / callTime[0], maxDifference);
+				free(buffer_output[f]);
+			}
+			free(buffer_input);
+			vkFreeCommandBuffers(device, commandPool, 1, &primaryCommandBuffer);
+			vkFreeCommandBuffers(device, commandPool, 2, secondaryCommandBuffers);
+			app_forward.deleteVulkanFFT();
+			app_inverse.deleteVulkanFFT();
+			vkDestroyBuffer(device, buffer, NULL);
+			vkFreeMemory(device, bufferDeviceMemory, NULL);
+		}
+		stagingPool.deleteStagingPool();
+		vkDestroyFence(device, fence, NULL);
+		vkDestroyCommandPool(device, commandPool, NULL);
+		vkDestroyDevice(device, NULL);
+		DestroyDebugUtilsMessengerEXT(instance, debugMessenger, NULL);
+		vkDestroyInstance(instance, NULL);
+		break;
+	}
+	case 12:
+	{
+		//12 - independent FFT+iFFT streams spread over all queues of the compute family by VkFFTQueueScheduler. Each stream has its own buffer and a pre-recorded command buffer, its consecutive submissions are chained by timeline semaphore tickets, submissions of different streams are independent and can run concurrently on different queues. Throughput is compared with the same submissions on the first queue only
+#if defined(VK_VERSION_1_2) || defined(VK_KHR_timeline_semaphore)
+		if (!isTimelineSemaphoreSupported)
+			printf("VK_KHR_timeline_semaphore is not supported by the device\n");
+		else
+			printf("Compute queues: %d\n", (uint32_t)computeQueues.size());
+		const uint32_t num_systems = 5;
+		const uint32_t num_submissions = 1000;
+		uint32_t systems[num_systems][3] = { {1, 256, 1}, {1, 4096, 1}, {2, 64, 64}, {2, 256, 256}, {2, 512, 512} }; //FFTdim, size[0], size[1]
+		uint32_t num_streams = 2 * (uint32_t)computeQueues.size();
+		if (num_streams > 8) num_streams = 8;
+		for (uint32_t n = 0; (isTimelineSemaphoreSupported) && (n < num_systems); n++) {
+			VkFFTConfiguration forward_configuration;
+			forward_configuration.FFTdim = systems[n][0];
+			forward_configuration.size[0] = systems[n][1];
+			forward_configuration.size[1] = systems[n][2];
+			forward_configuration.device = &device;
+			forward_configuration.physicalDevice = &physicalDevice;
+			sprintf(forward_configuration.shaderPath, SHADER_DIR);
+			VkDeviceSize bufferSize = (uint64_t)sizeof(float) * 2 * forward_configuration.size[0] * forward_configuration.size[1];
+			std::vector<VkBuffer> buffers(num_streams);
+			std::vector<VkDeviceMemory> bufferDeviceMemory(num_streams);
+			std::vector<VkFFTApplication> apps(2 * num_streams);
+			std::vector<VkCommandBuffer> commandBuffers(3 * num_streams); //forward and inverse secondaries, primary executing both
+			for (uint32_t i = 0; i < num_streams; i++) {
+				allocateFFTBuffer(&buffers[i], &bufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, bufferSize);
+				forward_configuration.buffer = &buffers[i];
+				forward_configuration.inputBuffer = &buffers[i];
+				forward_configuration.outputBuffer = &buffers[i];
+				forward_configuration.bufferSize = &bufferSize;
+				forward_configuration.inputBufferSize = &bufferSize;
+				forward_configuration.outputBufferSize = &bufferSize;
+				VkFFTConfiguration inverse_configuration = forward_configuration;
+				inverse_configuration.inverse = true;
+				apps[2 * i].initializeVulkanFFT(forward_configuration);
+				apps[2 * i + 1].initializeVulkanFFT(inverse_configuration);
+				apps[2 * i].VkFFTRecordCommandBuffer(commandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, &commandBuffers[3 * i]);
+				apps[2 * i + 1].VkFFTRecordCommandBuffer(commandPool, VK_COMMAND_BUFFER_LEVEL_SECONDARY, &commandBuffers[3 * i + 1]);
+				VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+				commandBufferAllocateInfo.commandPool = commandPool;
+				commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				commandBufferAllocateInfo.commandBufferCount = 1;
+				vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffers[3 * i + 2]);
+				VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+				commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+				vkBeginCommandBuffer(commandBuffers[3 * i + 2], &commandBufferBeginInfo);
+				vkCmdExecuteCommands(commandBuffers[3 * i + 2], 2, &commandBuffers[3 * i]);
+				vkEndCommandBuffer(commandBuffers[3 * i + 2]);
+			}
+			float* buffer_input = (float*)malloc(bufferSize);
+			float* buffer_output = (float*)malloc(bufferSize);
+			for (uint64_t i = 0; i < bufferSize / sizeof(float); i++)
+				buffer_input[i] = 2 * ((float)rand()) / RAND_MAX - 1.0;
+			double submissionTime[2];
+			double maxDifference = 0;
+			for (uint32_t f = 0; f < 2; f++) {
+				//f = 0 - first queue only, f = 1 - all queues
+				VkFFTQueueScheduler scheduler;
+				scheduler.initializeQueueScheduler(device, computeQueues.data(), (f == 0) ? 1 : (uint32_t)computeQueues.size());
+				for (uint32_t i = 0; i < num_streams; i++)
+					transferDataFromCPU(buffer_input, &buffers[i], bufferSize);
+				std::vector<VkFFTQueueTicket> tickets(num_streams);
+				auto timeStart = std::chrono::steady_clock::now();
+				for (uint32_t t = 0; t < num_submissions; t++) {
+					uint32_t stream = t % num_streams;
+					tickets[stream] = scheduler.submit(commandBuffers[3 * stream + 2], &tickets[stream], 1);
+				}
+				scheduler.waitQueueScheduler();
+				auto timeEnd = std::chrono::steady_clock::now();
+				submissionTime[f] = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() * 0.001 / num_submissions;
+				scheduler.deleteQueueScheduler();
+				//FFT+iFFT returns the input, up to rounding
+				for (uint32_t i = 0; i < num_streams; i++) {
+					transferDataToCPU(buffer_output, &buffers[i], bufferSize);
+					for (uint64_t j = 0; j < bufferSize / sizeof(float); j++)
+						if (fabs(buffer_output[j] - buffer_input[j]) > maxDifference) maxDifference = fabs(buffer_output[j] - buffer_input[j]);
+				}
+			}
+			printf("System: %dx%d, %d streams, %d FFT+iFFT submissions: one queue %.4f ms, %d queues %.4f ms per submission, throughput gain: %.2fx, max difference from input: %.3e\n", forward_configuration.size[0], forward_configuration.size[1], num_streams, num_submissions, submissionTime[0], (uint32_t)computeQueues.size(), submissionTime[1], (submissionTime[1] > 0) ? submissionTime[0] / submissionTime[1] : 0, maxDifference);
+			free(buffer_input);
+			free(buffer_output);
+			vkFreeCommandBuffers(device, commandPool, 3 * num_streams, commandBuffers.data());
+			for (uint32_t i = 0; i < num_streams; i++) {
+				apps[2 * i].deleteVulkanFFT();
+				apps[2 * i + 1].deleteVulkanFFT();
+				vkDestroyBuffer(device, buffers[i], NULL);
+				vkFreeMemory(device, bufferDeviceMemory[i], NULL);
+			}
+		}
+#else
+		printf("Vulkan headers have no timeline semaphores, VkFFTQueueScheduler is not available\n");
+#endif
+		stagingPool.deleteStagingPool();
 		vkDestroyFence(device, fence, NULL);
 		vkDestroyCommandPool(device, commandPool, NULL);
 		vkDestroyDevice(device, NULL);
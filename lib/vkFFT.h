@@ -1,28 +1,64 @@
 #include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#ifdef VKFFT_CPU_BACKEND //opt-in host execution of plans with executeOnCPU, needs a threads library
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VKFFT_CPU_DISPATCH //default GCC/Clang x86 build - Stockham stages are compiled twice and the AVX2/FMA version is selected at runtime
+#endif
+#endif
 #include <vulkan/vulkan.h>
+#define VKFFT_WISDOM_VERSION 1 //stored in wisdom keys - increase when shaders or the planner change, so that entries tuned for the old code are not loaded
 
 typedef struct {
 	//WHDCN layout
 	uint32_t size[3] = { 1,1,1 }; // WHD -system dimensions 
 	uint32_t coordinateFeatures = 1; // C - coordinate, or dimension of features vector. In matrix convolution - size of vector
-	uint32_t matrixConvolution = 1; //if equal to 2 perform 2x2, if equal to 3 perform 3x3 matrix-vector convolution. Overrides coordinateFeatures
+	uint32_t matrixConvolution = 1; //if bigger than 1 perform NxN matrix-vector convolution, where N = matrixConvolution. Overrides coordinateFeatures
 
 	uint32_t numberBatches = 1;// N - used to perform multiple batches of initial data
-	uint32_t numberKernels = 1;// N - only used in convolution step - specify how many kernels were initialized before. Expands one input to multiple (batched) output
+	uint32_t numberKernels = 1;// N - only used in convolution step - specify how many kernels were initialized before. Expands each input batch to multiple (batched) outputs: input batch b multiplied by kernel k is stored as output batch b*numberKernels+k
 	uint32_t FFTdim = 1; //FFT dimensionality (1, 2 or 3)
 	uint32_t radix = 8; //FFT radix (2, 4 or 8)
 	bool performZeropadding[3] = { false, false, false }; // perform zeropadding (false - off, true - on)
+	uint32_t zeropadInputRange[3][2] = { {0,0}, {0,0}, {0,0} }; // [start, end) of nonzero input data along each zeropadded axis. Reads outside of it are skipped in forward FFT and replaced with zeros. {0,0} - default 2x padding, same as [0, size/2)
+	uint32_t zeropadOutputRange[3][2] = { {0,0}, {0,0}, {0,0} }; // [start, end) of needed output data along each zeropadded axis. Writes outside of it are skipped in inverse FFT. {0,0} - default 2x padding, same as [0, size/2)
+	bool performOutputPruning[3] = { false, false, false }; // store only a window of the final output along the axis (false - off, true - on). Not supported in convolution and for forward R2C x axis. Axes done in more than one upload store the result in four step order, so pruning them fails the initialization
+	uint32_t outputPruningRange[3][2] = { {0,0}, {0,0}, {0,0} }; // [start, end) of output elements to keep along each pruned axis, in natural (frequency) order. Other elements of the output buffer are left untouched. {0,0} - whole axis
 	bool performTranspose[2] = { false, false }; //will be selected automatically
 	bool performConvolution = false; //perform convolution in this application (false - off, true - on)
+	bool performCorrelation = false; //perform cross-correlation in convolution step - multiply by complex conjugate of the kernel (false - off, true - on). Works for 1x1, matrix and multiple kernel convolutions
 	bool performR2C = false; //perform R2C/C2R decomposition (false - off, true - on)
 	bool inverse = false; //perform inverse FFT (false - forward, true - inverse)
-	bool symmetricKernel = false; //specify if kernel in 2x2 or 3x3 matrix convolution is symmetric
-	bool isInputFormatted = false; //specify if input buffer is not padded for R2C if out-of-place mode is selected (only if numberBatches==1 and numberKernels==1) - false - padded, true - not padded
-	bool isOutputFormatted = false; //specify if output buffer is not padded for R2C if out-of-place mode is selected (only if numberBatches==1 and numberKernels==1) - false - padded, true - not padded
-	uint32_t registerBoost = 1; //specify if register file size is bigger than shared memory (on Nvidia 256KB register file can be used instead of 32KB of shared memory, set this constant to 4)
+	bool symmetricKernel = false; //specify if kernel in NxN matrix convolution is symmetric. Symmetric kernel stores only the upper triangle, row-major: N*(N+1)/2 coordinates
+	bool isInputFormatted = false; //specify if input buffer is not padded for R2C if out-of-place mode is selected (only if numberBatches==1 and numberKernels==1) - false - padded, true - not padded. Along zeropadded axes a formatted buffer holds only the input range, R2C y windows start at the even row below the range start
+	bool isOutputFormatted = false; //specify if output buffer is not padded for R2C if out-of-place mode is selected (only if numberBatches==1 and numberKernels==1) - false - padded, true - not padded. Along zeropadded axes a formatted buffer holds only the output range, as for input
+	uint32_t registerBoost = 0; //specify if register file size is bigger than shared memory (on Nvidia 256KB register file can be used instead of 32KB of shared memory, set this constant to 4). 0 - detected from the device: 4 on Nvidia, 1 otherwise
 	char shaderPath[256] = "shaders/"; //path to shaders, can be selected automatically in CMake
-	uint32_t coalescedMemory = 32;//in bits, for Nvidia compute capability >=6.0 is equal to 32, <6.0 and Intel is equal 128. Gonna work regardles, but if specified by user correctly, the performance will be higher. 
-	VkDevice* device;
+	uint32_t coalescedMemory = 0;//in bytes, for Nvidia compute capability >=6.0 is equal to 32, <6.0 is equal 128, AMD and Intel - 64. Gonna work regardles, but if specified by user correctly, the performance will be higher. 0 - detected from the device
+	uint32_t groupedBatch[3] = { 0,0,0 }; //limit on the number of strided sequences merged in one workgroup (axisBlock[0] of strided passes) along each axis. 0 - chosen by the planner
+	bool autotune = false; //time candidate registerBoost, coalescedMemory, radix and groupedBatch values with timestamp queries and keep the fastest. Buffer contents are overwritten during tuning. Needs physicalDevice or physicalDeviceProperties, queue, commandPool and fence
+	char wisdomPath[256] = ""; //file with autotune results keyed by wisdom version, device UUID and problem geometry. Stored result is used instead of tuning, new results are appended. Entries with unsupported registerBoost, coalescedMemory or radix are ignored. Empty - no wisdom file
+#ifdef VKFFT_CPU_BACKEND
+	bool useCPU = false; //run the plan on the host with executeOnCPU instead of VkFFTAppend. Selected automatically if device is not set
+	uint32_t numberCPUThreads = 0; //threads of the CPU backend, 0 - all hardware threads
+#endif
+	VkDevice* device = NULL;
+	VkPhysicalDevice* physicalDevice = NULL; //optional, initializeVulkanFFT queries its properties if physicalDeviceProperties is not set
+	VkPhysicalDeviceProperties* physicalDeviceProperties = NULL; //optional, limits of the device are used by the radix and pass planner. If neither is set - assume 32KB of shared memory and 512 invocations per workgroup
+	VkQueue* queue = NULL; //optional, queue, command pool and fence are only used by autotune to time candidate configurations
+	VkCommandPool* commandPool = NULL;
+	VkFence* fence = NULL;
+	VkQueryPool* timestampQueryPool = NULL; //optional timestamp query pool for per-pass profiling of VkFFTAppend. NULL - no timestamps are written
+	uint32_t timestampQueryCount = 0; //number of queries in timestampQueryPool. One query per VkFFTAppend call and one per pass, passes beyond the capacity are not timed
+	bool externalSynchronization = false; //VkFFTAppend doesn't end with a barrier after its last pass - the caller records the barrier before the result is used. Consecutive VkFFTAppend calls of independent applications can then overlap
+	bool debugLabels = false; //label every pass of VkFFTAppend with its axis, upload, fftDim and radix sequence and name pipelines and buffers for frame debuggers. Needs VK_EXT_debug_utils enabled on the instance, otherwise ignored
 
 	VkDeviceSize* bufferSize;
 	VkDeviceSize* inputBufferSize;
@@ -53,11 +89,20 @@ typedef struct {
 	uint32_t inputOffset;
 	uint32_t outputOffset;
 	uint32_t passID;
+	uint32_t zeropadInputRange[2];
+	uint32_t zeropadOutputRange[2];
+	uint32_t nyquistOffset;
+	VkBool32 pruneOutput;
+	uint32_t matrixConvolution;
+	VkBool32 symmetricKernel;
+	VkBool32 conjugateKernel;
+	uint32_t rowPairShift;
 } VkFFTSpecializationConstantsLayout;
 
 typedef struct {
 	uint32_t coordinate=0;
 	uint32_t batch=0;
+	uint32_t inputBatch=0; //convolution step only: input batch, convolved with all kernels. Its outputs are stored as batches inputBatch*numberKernels...(inputBatch+1)*numberKernels-1
 } VkFFTPushConstantsLayout;
 
 typedef struct {
@@ -69,6 +114,10 @@ typedef struct {
 typedef struct {
 	uint32_t axisBlock[4];
 	uint32_t groupedBatch = 16;
+	uint32_t shaderID = 0; //shader chosen by the planner, see VkFFTGetShaderName
+	uint32_t dispatchGrid[3] = { 0,0,0 }; //workgroup grid and number of dispatches of the pass, filled by a dry run of VkFFTAppend in printPlanJSON
+	uint32_t numDispatches = 0;
+	uint32_t dispatchShift[3] = { 0,0,0 }; //workgroups skipped at the start of the zeropadded y and z ranges, subtracted from the dispatch grid
 	VkFFTSpecializationConstantsLayout specializationConstants;
 	VkFFTPushConstantsLayout pushConstants;
 	VkDescriptorPool descriptorPool;
@@ -76,6 +125,7 @@ typedef struct {
 	VkDescriptorSet descriptorSet;
 	VkPipelineLayout pipelineLayout;
 	VkPipeline pipeline;
+	VkBuffer passBuffers[2] = { VK_NULL_HANDLE, VK_NULL_HANDLE }; //buffers bound as input and output of the pass, covered by the barrier after it
 } VkFFTAxis;
 typedef struct {
 	uint32_t transposeBlock[3];
@@ -87,23 +137,589 @@ typedef struct {
 	VkPipelineLayout pipelineLayout;
 	VkPipeline pipeline;
 } VkFFTTranspose;
+typedef struct {
+	bool isDetected = false; //limits were read from the device, otherwise defaults of a 32KB shared memory GPU are used
+	uint32_t vendorID = 0;
+	uint32_t deviceID = 0;
+	uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+	float timestampPeriod = 1;
+	uint32_t sharedMemorySize = 32768; //shared memory budget of one workgroup in bytes
+	uint32_t maxWorkGroupInvocations = 512;
+	uint32_t maxWorkGroupSize[3] = { 512, 512, 64 };
+	uint32_t subgroupSize = 32; //workgroups with less invocations leave subgroup lanes idle
+	uint32_t registerBoost = 1;
+	uint32_t coalescedMemory = 32; //width of a coalesced memory transaction in bytes
+} VkFFTDeviceLimits;
+typedef struct {
+	bool inverseConvolutionPlan = false; //pass belongs to the inverse plan of the convolution
+	bool supportAxis = false; //pass of the Nx/2+1 support axis of R2C
+	bool convolution = false; //pass with the fused convolution step
+	uint32_t axis = 0; //FFT axis of the pass
+	uint32_t upload = 0;
+	uint32_t fftDim = 0;
+	uint32_t startQuery = 0; //queries of timestampQueryPool around the pass
+	uint32_t endQuery = 0;
+	float time = 0; //execution time in ms, filled by readPassTimestamps
+} VkFFTPassTiming;
+typedef struct {
+	VkDeviceSize bufferSize = 0; //all coordinates and batches of the complex system, R2C rows are padded to size[0]/2+1 complex numbers. Holds numberKernels outputs per input batch in convolution
+	VkDeviceSize inputBufferSize = 0; //smaller than bufferSize for unpadded real input (isInputFormatted) and for convolution input
+	VkDeviceSize outputBufferSize = 0; //smaller than bufferSize for unpadded real output (isOutputFormatted)
+	VkDeviceSize kernelSize = 0; //transformed convolution kernel in the compact layout of VkFFTConvolutionKernel
+	uint64_t bytesRead = 0; //global memory traffic of one VkFFTAppend. Reads skipped by zero padding and uncoalesced access overhead are not included
+	uint64_t bytesWritten = 0;
+	uint32_t numPasses = 0; //number of passes over global memory in one VkFFTAppend, for all coordinates and batches
+} VkFFTMemoryRequirements;
+typedef struct {
+	uint32_t numPasses = 0; //number of uploads the axis is split in
+	uint32_t logSize[5]; //log2 of the FFT length done in each pass
+	uint32_t numStages[5];
+	uint32_t stageRadix[5][2]; //stageRadix[0] is used for all stages but the last one, which uses stageRadix[1]
+	uint32_t groupedBatch[5]; //number of strided FFTs merged in one workgroup, 1 for non-strided passes
+	uint64_t memoryTraffic = 0; //predicted global memory traffic in bytes, including uncoalesced access overhead
+	uint64_t sharedTraffic = 0; //predicted shared memory traffic in bytes
+	uint32_t barrierCount = 0; //predicted number of barriers - one global barrier per pass and one workgroup barrier per radix stage
+	uint64_t cost = 0;
+} VkFFTStagePlan;
 typedef struct {
 	uint32_t numAxisUploads[3];
 	uint32_t numSupportAxisUploads[2];
+	VkFFTStagePlan stagePlan[3];
+	VkFFTStagePlan supportStagePlan[2];
 	VkFFTAxis axes[3][5];
 	VkFFTAxis supportAxes[2][5];//Nx/2+1 for r2c/c2r
 	VkFFTTranspose transpose[2];
 
 } VkFFTPlan;
+#ifdef VKFFT_CPU_BACKEND
+//CPU backend - VKFFT_CPU_LANES sequences are transformed together, one vector holds the same element of all of them. Intrinsics are used if the compiler targets AVX-512 or AVX (-march=native, VKFFT_CPU_NATIVE), FMA only with __FMA__. Default GCC/Clang x86 builds use generic 8 lane vectors and pick AVX2/FMA code at runtime (VKFFT_CPU_DISPATCH), other builds are scalar
+#if defined(__AVX512F__)
+#define VKFFT_CPU_LANES 16
+typedef __m512 VkFFTCPUVector;
+static inline VkFFTCPUVector VkFFTCPULoad(const float* p) { return _mm512_loadu_ps(p); }
+static inline void VkFFTCPUStore(float* p, VkFFTCPUVector a) { _mm512_storeu_ps(p, a); }
+static inline VkFFTCPUVector VkFFTCPUSet(float a) { return _mm512_set1_ps(a); }
+static inline VkFFTCPUVector VkFFTCPUAdd(VkFFTCPUVector a, VkFFTCPUVector b) { return _mm512_add_ps(a, b); }
+static inline VkFFTCPUVector VkFFTCPUSub(VkFFTCPUVector a, VkFFTCPUVector b) { return _mm512_sub_ps(a, b); }
+static inline VkFFTCPUVector VkFFTCPUMul(VkFFTCPUVector a, VkFFTCPUVector b) { return _mm512_mul_ps(a, b); }
+static inline VkFFTCPUVector VkFFTCPUMulAdd(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return _mm512_fmadd_ps(a, b, c); }
+static inline VkFFTCPUVector VkFFTCPUMulSub(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return _mm512_fmsub_ps(a, b, c); }
+#elif defined(__AVX__)
+#define VKFFT_CPU_LANES 8
+typedef __m256 VkFFTCPUVector;
+static inline VkFFTCPUVector VkFFTCPULoad(const float* p) { return _mm256_loadu_ps(p); }
+static inline void VkFFTCPUStore(float* p, VkFFTCPUVector a) { _mm256_storeu_ps(p, a); }
+static inline VkFFTCPUVector VkFFTCPUSet(float a) { return _mm256_set1_ps(a); }
+static inline VkFFTCPUVector VkFFTCPUAdd(VkFFTCPUVector a, VkFFTCPUVector b) { return _mm256_add_ps(a, b); }
+static inline VkFFTCPUVector VkFFTCPUSub(VkFFTCPUVector a, VkFFTCPUVector b) { return _mm256_sub_ps(a, b); }
+static inline VkFFTCPUVector VkFFTCPUMul(VkFFTCPUVector a, VkFFTCPUVector b) { return _mm256_mul_ps(a, b); }
+#if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)) //MSVC /arch:AVX2 has no __FMA__, but allows FMA instructions
+static inline VkFFTCPUVector VkFFTCPUMulAdd(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return _mm256_fmadd_ps(a, b, c); }
+static inline VkFFTCPUVector VkFFTCPUMulSub(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return _mm256_fmsub_ps(a, b, c); }
+#else
+static inline VkFFTCPUVector VkFFTCPUMulAdd(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+static inline VkFFTCPUVector VkFFTCPUMulSub(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return _mm256_sub_ps(_mm256_mul_ps(a, b), c); }
+#endif
+#elif defined(VKFFT_CPU_DISPATCH)
+//GCC vector extension - operations are compiled for the target of the function they are used in, so the same stages become SSE code in VkFFTCPUStockham and AVX2/FMA code in VkFFTCPUStockhamAVX2. Operations are macros, as passing 32 byte vectors to functions is an ABI change without AVX
+#define VKFFT_CPU_LANES 8
+typedef float VkFFTCPUVector __attribute__((vector_size(VKFFT_CPU_LANES * sizeof(float))));
+typedef float VkFFTCPUUnalignedVector __attribute__((vector_size(VKFFT_CPU_LANES * sizeof(float)), aligned(sizeof(float)), may_alias));
+#define VkFFTCPULoad(p) (*(const VkFFTCPUUnalignedVector*)(p))
+#define VkFFTCPUStore(p, a) (*(VkFFTCPUUnalignedVector*)(p) = (a))
+#define VkFFTCPUSet(a) (VkFFTCPUVector{} + (float)(a))
+#define VkFFTCPUAdd(a, b) ((a) + (b))
+#define VkFFTCPUSub(a, b) ((a) - (b))
+#define VkFFTCPUMul(a, b) ((a) * (b))
+#define VkFFTCPUMulAdd(a, b, c) ((a) * (b) + (c))
+#define VkFFTCPUMulSub(a, b, c) ((a) * (b) - (c))
+#else
+#define VKFFT_CPU_LANES 4
+typedef struct { float v[VKFFT_CPU_LANES]; } VkFFTCPUVector;
+static inline VkFFTCPUVector VkFFTCPULoad(const float* p) { VkFFTCPUVector c; for (uint32_t i = 0; i < VKFFT_CPU_LANES; i++) c.v[i] = p[i]; return c; }
+static inline void VkFFTCPUStore(float* p, VkFFTCPUVector a) { for (uint32_t i = 0; i < VKFFT_CPU_LANES; i++) p[i] = a.v[i]; }
+static inline VkFFTCPUVector VkFFTCPUSet(float a) { VkFFTCPUVector c; for (uint32_t i = 0; i < VKFFT_CPU_LANES; i++) c.v[i] = a; return c; }
+static inline VkFFTCPUVector VkFFTCPUAdd(VkFFTCPUVector a, VkFFTCPUVector b) { VkFFTCPUVector c; for (uint32_t i = 0; i < VKFFT_CPU_LANES; i++) c.v[i] = a.v[i] + b.v[i]; return c; }
+static inline VkFFTCPUVector VkFFTCPUSub(VkFFTCPUVector a, VkFFTCPUVector b) { VkFFTCPUVector c; for (uint32_t i = 0; i < VKFFT_CPU_LANES; i++) c.v[i] = a.v[i] - b.v[i]; return c; }
+static inline VkFFTCPUVector VkFFTCPUMul(VkFFTCPUVector a, VkFFTCPUVector b) { VkFFTCPUVector c; for (uint32_t i = 0; i < VKFFT_CPU_LANES; i++) c.v[i] = a.v[i] * b.v[i]; return c; }
+static inline VkFFTCPUVector VkFFTCPUMulAdd(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return VkFFTCPUAdd(VkFFTCPUMul(a, b), c); }
+static inline VkFFTCPUVector VkFFTCPUMulSub(VkFFTCPUVector a, VkFFTCPUVector b, VkFFTCPUVector c) { return VkFFTCPUSub(VkFFTCPUMul(a, b), c); }
+#endif
+#define VKFFT_CPU_MAX_LINE 4096 //longer sequences are done as two passes of the four step FFT, so all lanes of a pass stay in cache
+#define VKFFT_CPU_MIN_FOUR_STEP 256 //sequences from this length are also done as two passes if there are not enough of them to fill all lanes
+
+static inline void VkFFTCPURadix4(VkFFTCPUVector* re, VkFFTCPUVector* im, uint32_t s, const VkFFTCPUVector& sign) {
+	//in-place radix 4 butterfly of elements 0, s, 2s, 3s. sign is +1 for forward and -1 for inverse FFT
+	VkFFTCPUVector t0Re = VkFFTCPUAdd(re[0], re[2 * s]);
+	VkFFTCPUVector t0Im = VkFFTCPUAdd(im[0], im[2 * s]);
+	VkFFTCPUVector t1Re = VkFFTCPUSub(re[0], re[2 * s]);
+	VkFFTCPUVector t1Im = VkFFTCPUSub(im[0], im[2 * s]);
+	VkFFTCPUVector t2Re = VkFFTCPUAdd(re[s], re[3 * s]);
+	VkFFTCPUVector t2Im = VkFFTCPUAdd(im[s], im[3 * s]);
+	VkFFTCPUVector t3Re = VkFFTCPUMul(VkFFTCPUSub(re[s], re[3 * s]), sign);
+	VkFFTCPUVector t3Im = VkFFTCPUMul(VkFFTCPUSub(im[s], im[3 * s]), sign);
+	re[0] = VkFFTCPUAdd(t0Re, t2Re);
+	im[0] = VkFFTCPUAdd(t0Im, t2Im);
+	re[2 * s] = VkFFTCPUSub(t0Re, t2Re);
+	im[2 * s] = VkFFTCPUSub(t0Im, t2Im);
+	re[s] = VkFFTCPUSub(t1Re, t3Im);
+	im[s] = VkFFTCPUAdd(t1Im, t3Re);
+	re[3 * s] = VkFFTCPUAdd(t1Re, t3Im);
+	im[3 * s] = VkFFTCPUSub(t1Im, t3Re);
+}
+static inline void VkFFTCPURadix8(VkFFTCPUVector* re, VkFFTCPUVector* im, const VkFFTCPUVector& sign) {
+	//radix 4 butterflies of even and odd elements, odd ones are multiplied by exp(sign * 2 pi i k / 8) and merged
+	VkFFTCPURadix4(re, im, 2, sign);
+	VkFFTCPURadix4(re + 1, im + 1, 2, sign);
+	VkFFTCPUVector sqrt05 = VkFFTCPUSet(0.70710678118654752440f);
+	VkFFTCPUVector tempRe = VkFFTCPUMul(VkFFTCPUSub(re[3], VkFFTCPUMul(im[3], sign)), sqrt05);
+	im[3] = VkFFTCPUMul(VkFFTCPUAdd(im[3], VkFFTCPUMul(re[3], sign)), sqrt05);
+	re[3] = tempRe;
+	tempRe = VkFFTCPUMul(VkFFTCPUSub(VkFFTCPUSet(0), im[5]), sign);
+	im[5] = VkFFTCPUMul(re[5], sign);
+	re[5] = tempRe;
+	tempRe = VkFFTCPUMul(VkFFTCPUSub(VkFFTCPUSub(VkFFTCPUSet(0), re[7]), VkFFTCPUMul(im[7], sign)), sqrt05);
+	im[7] = VkFFTCPUMul(VkFFTCPUSub(VkFFTCPUMul(re[7], sign), im[7]), sqrt05);
+	re[7] = tempRe;
+	VkFFTCPUVector outRe[8];
+	VkFFTCPUVector outIm[8];
+	for (uint32_t k = 0; k < 4; k++) {
+		outRe[k] = VkFFTCPUAdd(re[2 * k], re[2 * k + 1]);
+		outIm[k] = VkFFTCPUAdd(im[2 * k], im[2 * k + 1]);
+		outRe[k + 4] = VkFFTCPUSub(re[2 * k], re[2 * k + 1]);
+		outIm[k + 4] = VkFFTCPUSub(im[2 * k], im[2 * k + 1]);
+	}
+	for (uint32_t k = 0; k < 8; k++) {
+		re[k] = outRe[k];
+		im[k] = outIm[k];
+	}
+}
+template <uint32_t stageRadix>
+static void VkFFTCPUStockhamStage(const float* re, const float* im, float* outRe, float* outIm, uint32_t fftDim, uint32_t stageSize, const float* twiddles, uint32_t twiddleStride, bool inverse) {
+	//one radix stage: element j + r * fftDim / stageRadix is multiplied by the twiddle of k = j % stageSize, transformed and stored to (j - k) * stageRadix + k + r * stageSize
+	const uint32_t L = VKFFT_CPU_LANES;
+	VkFFTCPUVector sign = VkFFTCPUSet((inverse) ? -1.0f : 1.0f);
+	uint32_t stride = fftDim / stageRadix;
+	uint32_t twiddleStep = stride / stageSize * twiddleStride;
+	for (uint32_t k = 0; k < stageSize; k++) {
+		VkFFTCPUVector wRe[stageRadix];
+		VkFFTCPUVector wIm[stageRadix];
+		for (uint32_t r = 1; r < stageRadix; r++) {
+			uint64_t id = (uint64_t)r * k * twiddleStep;
+			wRe[r] = VkFFTCPUSet(twiddles[2 * id]);
+			wIm[r] = VkFFTCPUSet((inverse) ? -twiddles[2 * id + 1] : twiddles[2 * id + 1]);
+		}
+		for (uint32_t j = k; j < stride; j += stageSize) {
+			VkFFTCPUVector vRe[stageRadix];
+			VkFFTCPUVector vIm[stageRadix];
+			for (uint32_t r = 0; r < stageRadix; r++) {
+				vRe[r] = VkFFTCPULoad(re + (uint64_t)(j + r * stride) * L);
+				vIm[r] = VkFFTCPULoad(im + (uint64_t)(j + r * stride) * L);
+			}
+			if (k > 0) {
+				for (uint32_t r = 1; r < stageRadix; r++) {
+					VkFFTCPUVector temp = VkFFTCPUMulSub(vRe[r], wRe[r], VkFFTCPUMul(vIm[r], wIm[r]));
+					vIm[r] = VkFFTCPUMulAdd(vRe[r], wIm[r], VkFFTCPUMul(vIm[r], wRe[r]));
+					vRe[r] = temp;
+				}
+			}
+			if (stageRadix == 8) VkFFTCPURadix8(vRe, vIm, sign);
+			else if (stageRadix == 4) VkFFTCPURadix4(vRe, vIm, 1, sign);
+			else {
+				VkFFTCPUVector temp = VkFFTCPUSub(vRe[0], vRe[1]);
+				vRe[0] = VkFFTCPUAdd(vRe[0], vRe[1]);
+				vRe[1] = temp;
+				temp = VkFFTCPUSub(vIm[0], vIm[1]);
+				vIm[0] = VkFFTCPUAdd(vIm[0], vIm[1]);
+				vIm[1] = temp;
+			}
+			uint32_t out = (j - k) * stageRadix + k;
+			for (uint32_t r = 0; r < stageRadix; r++) {
+				VkFFTCPUStore(outRe + (uint64_t)(out + r * stageSize) * L, vRe[r]);
+				VkFFTCPUStore(outIm + (uint64_t)(out + r * stageSize) * L, vIm[r]);
+			}
+		}
+	}
+}
+static inline void VkFFTCPUStockhamStages(float** re, float** im, float** tempRe, float** tempIm, uint32_t fftDim, uint32_t radix, const float* twiddles, uint32_t twiddleStride, bool inverse) {
+	//same decomposition as the shaders: radix stages of stageRadix[0] and one last stage of a smaller radix. Element n of lane l is at n * VKFFT_CPU_LANES + l, result is left in re and im
+	for (uint32_t stageSize = 1; stageSize < fftDim;) {
+		uint32_t stageRadix = radix;
+		while (fftDim / stageSize < stageRadix) stageRadix /= 2;
+		if (stageRadix == 8) VkFFTCPUStockhamStage<8>(re[0], im[0], tempRe[0], tempIm[0], fftDim, stageSize, twiddles, twiddleStride, inverse);
+		else if (stageRadix == 4) VkFFTCPUStockhamStage<4>(re[0], im[0], tempRe[0], tempIm[0], fftDim, stageSize, twiddles, twiddleStride, inverse);
+		else VkFFTCPUStockhamStage<2>(re[0], im[0], tempRe[0], tempIm[0], fftDim, stageSize, twiddles, twiddleStride, inverse);
+		float* swap = re[0];
+		re[0] = tempRe[0];
+		tempRe[0] = swap;
+		swap = im[0];
+		im[0] = tempIm[0];
+		tempIm[0] = swap;
+		stageSize *= stageRadix;
+	}
+}
+#if defined(VKFFT_CPU_DISPATCH)
+__attribute__((target("avx2,fma"), flatten)) static void VkFFTCPUStockhamAVX2(float** re, float** im, float** tempRe, float** tempIm, uint32_t fftDim, uint32_t radix, const float* twiddles, uint32_t twiddleStride, bool inverse) {
+	//flatten inlines all stages, so they are compiled for AVX2/FMA here
+	VkFFTCPUStockhamStages(re, im, tempRe, tempIm, fftDim, radix, twiddles, twiddleStride, inverse);
+}
+#endif
+static void VkFFTCPUStockham(float** re, float** im, float** tempRe, float** tempIm, uint32_t fftDim, uint32_t radix, const float* twiddles, uint32_t twiddleStride, bool inverse) {
+#if defined(VKFFT_CPU_DISPATCH)
+	static const bool isAVX2 = (__builtin_cpu_supports("avx2")) && (__builtin_cpu_supports("fma"));
+	if (isAVX2) {
+		VkFFTCPUStockhamAVX2(re, im, tempRe, tempIm, fftDim, radix, twiddles, twiddleStride, inverse);
+		return;
+	}
+#endif
+	VkFFTCPUStockhamStages(re, im, tempRe, tempIm, fftDim, radix, twiddles, twiddleStride, inverse);
+}
+static void VkFFTCPURealProcess(float* re, float* im, uint64_t stride, uint32_t fftDim, const float* twiddles, uint32_t twiddleStride, bool inverse) {
+	//R2C of 2 * fftDim real numbers is a C2C FFT of fftDim complex numbers z[n] = x[2n] + i x[2n+1]. Forward: FFT result Z is turned into X[0..fftDim] in-place (fftDim + 1 elements, stride apart), X[k] = E[k] + exp(2 pi i k / (2 fftDim)) O[k]. Inverse: X[0..fftDim] is turned into Z before the inverse FFT
+	for (uint32_t k = 0; k <= fftDim / 2; k++) {
+		uint32_t kc = fftDim - k;
+		uint64_t id = (uint64_t)k * stride;
+		uint64_t idc = (uint64_t)((inverse) ? kc : kc % fftDim) * stride;
+		double wRe = twiddles[2 * (uint64_t)k * twiddleStride];
+		double wIm = twiddles[2 * (uint64_t)k * twiddleStride + 1];
+		double aRe = re[id];
+		double aIm = im[id];
+		double cRe = re[idc];
+		double cIm = -im[idc];
+		double eRe = 0.5 * (aRe + cRe);
+		double eIm = 0.5 * (aIm + cIm);
+		double oRe, oIm;
+		if (inverse) {
+			//O = (X[k] - conj(X[fftDim - k])) / 2 * exp(-2 pi i k / (2 fftDim)), Z[k] = E + i O and Z[fftDim - k] = conj(E - i O)
+			double dRe = 0.5 * (aRe - cRe);
+			double dIm = 0.5 * (aIm - cIm);
+			oRe = dRe * wRe + dIm * wIm;
+			oIm = dIm * wRe - dRe * wIm;
+			re[id] = (float)(eRe - oIm);
+			im[id] = (float)(eIm + oRe);
+			re[idc] = (float)(eRe + oIm);
+			im[idc] = (float)(oRe - eIm);
+		}
+		else {
+			//O = (Z[k] - conj(Z[fftDim - k])) / 2i, X[k] = E + w O and X[fftDim - k] = conj(E - w O)
+			oRe = 0.5 * (aIm - cIm);
+			oIm = -0.5 * (aRe - cRe);
+			double woRe = wRe * oRe - wIm * oIm;
+			double woIm = wRe * oIm + wIm * oRe;
+			re[id] = (float)(eRe + woRe);
+			im[id] = (float)(eIm + woIm);
+			re[(uint64_t)kc * stride] = (float)(eRe - woRe);
+			im[(uint64_t)kc * stride] = (float)(woIm - eIm);
+		}
+	}
+}
+typedef struct VkFFTCPUThreadPool {
+	//persistent worker threads of the CPU backend. run splits numTasks tasks between the workers and the calling thread and returns when all of them are done
+	uint32_t numThreads = 1; //including the calling thread
+	std::thread* workers = NULL;
+	std::mutex mutex;
+	std::condition_variable startCondition;
+	std::condition_variable doneCondition;
+	void (*task)(void* data, uint32_t taskID, uint32_t threadID) = NULL;
+	void* taskData = NULL;
+	uint32_t numTasks = 0;
+	std::atomic<uint32_t> nextTask;
+	uint32_t numActiveWorkers = 0;
+	uint64_t generation = 0;
+	bool isStopped = false;
+	void initialize(uint32_t inputNumThreads) {
+		numThreads = (inputNumThreads > 0) ? inputNumThreads : 1;
+		nextTask = 0;
+		if (numThreads > 1) {
+			workers = new std::thread[numThreads - 1];
+			for (uint32_t i = 0; i < numThreads - 1; i++)
+				workers[i] = std::thread(&VkFFTCPUThreadPool::workerLoop, this, i + 1);
+		}
+	}
+	void runTasks(uint32_t threadID) {
+		for (uint32_t t = nextTask++; t < numTasks; t = nextTask++)
+			task(taskData, t, threadID);
+	}
+	void workerLoop(uint32_t threadID) {
+		uint64_t doneGeneration = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				startCondition.wait(lock, [&] { return (isStopped) || (generation != doneGeneration); });
+				if (isStopped) return;
+				doneGeneration = generation;
+			}
+			runTasks(threadID);
+			std::unique_lock<std::mutex> lock(mutex);
+			numActiveWorkers--;
+			if (numActiveWorkers == 0) doneCondition.notify_one();
+		}
+	}
+	void run(void (*inputTask)(void*, uint32_t, uint32_t), void* inputTaskData, uint32_t inputNumTasks) {
+		if ((numThreads == 1) || (inputNumTasks == 1)) {
+			for (uint32_t t = 0; t < inputNumTasks; t++)
+				inputTask(inputTaskData, t, 0);
+			return;
+		}
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			task = inputTask;
+			taskData = inputTaskData;
+			numTasks = inputNumTasks;
+			nextTask = 0;
+			numActiveWorkers = numThreads - 1;
+			generation++;
+		}
+		startCondition.notify_all();
+		runTasks(0);
+		std::unique_lock<std::mutex> lock(mutex);
+		doneCondition.wait(lock, [&] { return numActiveWorkers == 0; });
+	}
+	void destroy() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			isStopped = true;
+		}
+		startCondition.notify_all();
+		for (uint32_t i = 0; i + 1 < numThreads; i++)
+			workers[i].join();
+		if (workers != NULL) delete[] workers;
+		workers = NULL;
+	}
+} VkFFTCPUThreadPool;
+typedef struct {
+	//set of equal length FFTs done by the CPU backend. Line t = t0 + lineCount[0] * (t1 + lineCount[1] * t2) starts at inputOffset + t0 * inputLineStride[0] + t1 * inputLineStride[1] + t2 * inputLineStride[2] complex numbers of input, its elements are inputStride apart. Same for output
+	float* input;
+	float* output;
+	uint32_t fftDim;
+	uint32_t realTransform; //0 - C2C, 1 - R2C: fftDim complex numbers are read as 2*fftDim real numbers, fftDim + 1 are stored, 2 - C2R: fftDim + 1 complex numbers are read, 2*fftDim real numbers are stored
+	bool inverse;
+	float scale;
+	uint32_t lineCount[3];
+	uint64_t inputOffset;
+	uint64_t outputOffset;
+	uint64_t inputLineStride[3];
+	uint64_t outputLineStride[3];
+	uint64_t inputStride;
+	uint64_t outputStride;
+	uint64_t inputRange[2]; //real numbers with index 2 * (t0 * maskLineFactor[0] + n * maskElementFactor[0]) (+1 for imaginary part) outside of it are read as zeros
+	uint64_t outputRange[2]; //real numbers with index outside of it are not stored
+	uint64_t maskLineFactor[2];
+	uint64_t maskElementFactor[2];
+	const float* twiddles; //exp(2 pi i j / twiddleSize), twiddleSize has to be a multiple of fftDim
+	uint32_t twiddleSize;
+	uint32_t fourStepDim; //if not 0, output element n of line t0 is multiplied by exp(+-2 pi i t0 n / fourStepDim). Power of two
+	uint32_t radix;
+	uint32_t linesPerTask;
+	float** threadScratch; //4 * VKFFT_CPU_LANES * (fftDim + 1) floats per thread
+} VkFFTCPUPass;
+static void VkFFTCPUPassTask(void* data, uint32_t taskID, uint32_t threadID) {
+	VkFFTCPUPass* pass = (VkFFTCPUPass*)data;
+	const uint32_t L = VKFFT_CPU_LANES;
+	uint32_t fftDim = pass->fftDim;
+	uint32_t inputCount = (pass->realTransform == 2) ? fftDim + 1 : fftDim;
+	uint32_t outputCount = (pass->realTransform == 1) ? fftDim + 1 : fftDim;
+	uint64_t numLines = (uint64_t)pass->lineCount[0] * pass->lineCount[1] * pass->lineCount[2];
+	uint64_t scratchSize = (uint64_t)L * (fftDim + 1);
+	uint64_t lastLine = (uint64_t)(taskID + 1) * pass->linesPerTask;
+	if (lastLine > numLines) lastLine = numLines;
+	bool isInputMasked = (pass->inputRange[0] > 0) || (pass->inputRange[1] != (uint64_t)-1);
+	bool isOutputMasked = (pass->outputRange[0] > 0) || (pass->outputRange[1] != (uint64_t)-1);
+	uint64_t fourStepTwiddleStride = (pass->fourStepDim > 0) ? pass->twiddleSize / pass->fourStepDim : 0;
+	for (uint64_t firstLine = (uint64_t)taskID * pass->linesPerTask; firstLine < lastLine; firstLine += L) {
+		float* re = pass->threadScratch[threadID];
+		float* im = re + scratchSize;
+		float* tempRe = im + scratchSize;
+		float* tempIm = tempRe + scratchSize;
+		uint32_t lanes = (lastLine - firstLine < L) ? (uint32_t)(lastLine - firstLine) : L;
+		uint64_t inputStart[VKFFT_CPU_LANES];
+		uint64_t outputStart[VKFFT_CPU_LANES];
+		uint64_t lineID[VKFFT_CPU_LANES];
+		for (uint32_t l = 0; l < lanes; l++) {
+			uint64_t t = firstLine + l;
+			uint64_t t0 = t % pass->lineCount[0];
+			uint64_t t1 = (t / pass->lineCount[0]) % pass->lineCount[1];
+			uint64_t t2 = t / pass->lineCount[0] / pass->lineCount[1];
+			inputStart[l] = 2 * (pass->inputOffset + t0 * pass->inputLineStride[0] + t1 * pass->inputLineStride[1] + t2 * pass->inputLineStride[2]);
+			outputStart[l] = 2 * (pass->outputOffset + t0 * pass->outputLineStride[0] + t1 * pass->outputLineStride[1] + t2 * pass->outputLineStride[2]);
+			lineID[l] = t0;
+		}
+		//contiguous lines are read one at a time, as lanes that are 4KB apart alias in L1 when interleaved
+		bool isInputLaneOuter = (pass->inputStride == 1);
+		uint32_t inputOuterCount = (isInputLaneOuter) ? lanes : inputCount;
+		uint32_t inputInnerCount = (isInputLaneOuter) ? inputCount : lanes;
+		for (uint32_t a = 0; a < inputOuterCount; a++) {
+			for (uint32_t b = 0; b < inputInnerCount; b++) {
+				uint32_t n = (isInputLaneOuter) ? b : a;
+				uint32_t l = (isInputLaneOuter) ? a : b;
+				const float* src = pass->input + inputStart[l] + 2 * n * pass->inputStride;
+				float valueRe = src[0];
+				float valueIm = src[1];
+				if (isInputMasked) {
+					uint64_t realID = 2 * (lineID[l] * pass->maskLineFactor[0] + n * pass->maskElementFactor[0]);
+					if ((realID < pass->inputRange[0]) || (realID >= pass->inputRange[1])) valueRe = 0;
+					if ((realID + 1 < pass->inputRange[0]) || (realID + 1 >= pass->inputRange[1])) valueIm = 0;
+				}
+				re[(uint64_t)n * L + l] = valueRe;
+				im[(uint64_t)n * L + l] = valueIm;
+			}
+		}
+		if (lanes < L) {
+			for (uint32_t n = 0; n < inputCount; n++) {
+				for (uint32_t l = lanes; l < L; l++) {
+					re[(uint64_t)n * L + l] = 0;
+					im[(uint64_t)n * L + l] = 0;
+				}
+			}
+		}
+		if (pass->realTransform == 2) {
+			for (uint32_t l = 0; l < lanes; l++)
+				VkFFTCPURealProcess(re + l, im + l, L, fftDim, pass->twiddles, pass->twiddleSize / (2 * fftDim), true);
+		}
+		VkFFTCPUStockham(&re, &im, &tempRe, &tempIm, fftDim, pass->radix, pass->twiddles, pass->twiddleSize / fftDim, pass->inverse);
+		if (pass->realTransform == 1) {
+			for (uint32_t l = 0; l < lanes; l++)
+				VkFFTCPURealProcess(re + l, im + l, L, fftDim, pass->twiddles, pass->twiddleSize / (2 * fftDim), false);
+		}
+		bool isOutputLaneOuter = (pass->outputStride == 1);
+		uint32_t outputOuterCount = (isOutputLaneOuter) ? lanes : outputCount;
+		uint32_t outputInnerCount = (isOutputLaneOuter) ? outputCount : lanes;
+		for (uint32_t a = 0; a < outputOuterCount; a++) {
+			for (uint32_t b = 0; b < outputInnerCount; b++) {
+				uint32_t n = (isOutputLaneOuter) ? b : a;
+				uint32_t l = (isOutputLaneOuter) ? a : b;
+				float valueRe = re[(uint64_t)n * L + l] * pass->scale;
+				float valueIm = im[(uint64_t)n * L + l] * pass->scale;
+				if (pass->fourStepDim > 0) {
+					uint64_t id = ((lineID[l] * n) & (pass->fourStepDim - 1)) * fourStepTwiddleStride;
+					float wRe = pass->twiddles[2 * id];
+					float wIm = (pass->inverse) ? -pass->twiddles[2 * id + 1] : pass->twiddles[2 * id + 1];
+					float temp = valueRe * wRe - valueIm * wIm;
+					valueIm = valueRe * wIm + valueIm * wRe;
+					valueRe = temp;
+				}
+				float* dst = pass->output + outputStart[l] + 2 * n * pass->outputStride;
+				if (isOutputMasked) {
+					uint64_t realID = 2 * (lineID[l] * pass->maskLineFactor[1] + n * pass->maskElementFactor[1]);
+					if ((realID >= pass->outputRange[0]) && (realID < pass->outputRange[1])) dst[0] = valueRe;
+					if ((realID + 1 >= pass->outputRange[0]) && (realID + 1 < pass->outputRange[1])) dst[1] = valueIm;
+				}
+				else {
+					dst[0] = valueRe;
+					dst[1] = valueIm;
+				}
+			}
+		}
+	}
+}
+typedef struct {
+	//four step storage order of one axis on the CPU. Forward stores frequency order[s] at index s of every line, inverse puts element s back to frequency order[s] before the transform. Lines are addressed as in VkFFTCPUPass
+	float* data;
+	const uint32_t* order; //NULL - natural order
+	const uint32_t* lastColumnOrder; //order of the lines with t0 = lineCount[0] - 1 - the support column of R2C y and z axes
+	uint32_t fftDim;
+	uint32_t lineCount[3];
+	uint64_t offset;
+	uint64_t lineStride[3];
+	uint64_t stride;
+	bool inverse;
+	uint64_t linesPerTask;
+	float** threadScratch; //2 * fftDim floats per thread
+} VkFFTCPUReorder;
+static void VkFFTCPUReorderTask(void* data, uint32_t taskID, uint32_t threadID) {
+	VkFFTCPUReorder* reorder = (VkFFTCPUReorder*)data;
+	uint64_t numLines = (uint64_t)reorder->lineCount[0] * reorder->lineCount[1] * reorder->lineCount[2];
+	uint64_t lastLine = (uint64_t)(taskID + 1) * reorder->linesPerTask;
+	if (lastLine > numLines) lastLine = numLines;
+	float* line = reorder->threadScratch[threadID];
+	for (uint64_t t = (uint64_t)taskID * reorder->linesPerTask; t < lastLine; t++) {
+		uint64_t t0 = t % reorder->lineCount[0];
+		uint64_t t1 = (t / reorder->lineCount[0]) % reorder->lineCount[1];
+		uint64_t t2 = t / reorder->lineCount[0] / reorder->lineCount[1];
+		const uint32_t* order = ((reorder->lastColumnOrder != NULL) && (t0 == reorder->lineCount[0] - 1)) ? reorder->lastColumnOrder : reorder->order;
+		if (order == NULL) continue;
+		float* start = reorder->data + 2 * (reorder->offset + t0 * reorder->lineStride[0] + t1 * reorder->lineStride[1] + t2 * reorder->lineStride[2]);
+		for (uint32_t n = 0; n < reorder->fftDim; n++) {
+			line[2 * n] = start[2 * n * reorder->stride];
+			line[2 * n + 1] = start[2 * n * reorder->stride + 1];
+		}
+		for (uint32_t n = 0; n < reorder->fftDim; n++) {
+			uint64_t src = (reorder->inverse) ? n : order[n];
+			uint64_t dst = (reorder->inverse) ? order[n] : n;
+			start[2 * dst * reorder->stride] = line[2 * src];
+			start[2 * dst * reorder->stride + 1] = line[2 * src + 1];
+		}
+	}
+}
+typedef struct {
+	//pointwise multiplication of the convolution step on the CPU: output = sum over c of kernel[c] * input[c], kernel is conjugated in cross-correlation
+	float* output;
+	float** input;
+	float** kernel;
+	uint32_t numInputs;
+	uint64_t size; //complex numbers per system
+	uint64_t elementsPerTask;
+	bool conjugateKernel;
+} VkFFTCPUConvolutionStep;
+static void VkFFTCPUConvolutionTask(void* data, uint32_t taskID, uint32_t threadID) {
+	VkFFTCPUConvolutionStep* step = (VkFFTCPUConvolutionStep*)data;
+	float conjugate = (step->conjugateKernel) ? -1.0f : 1.0f;
+	uint64_t last = (uint64_t)(taskID + 1) * step->elementsPerTask;
+	if (last > step->size) last = step->size;
+	for (uint64_t i = (uint64_t)taskID * step->elementsPerTask; i < last; i++) {
+		float resultRe = 0;
+		float resultIm = 0;
+		for (uint32_t c = 0; c < step->numInputs; c++) {
+			float kernelRe = step->kernel[c][2 * i];
+			float kernelIm = conjugate * step->kernel[c][2 * i + 1];
+			float inputRe = step->input[c][2 * i];
+			float inputIm = step->input[c][2 * i + 1];
+			resultRe += kernelRe * inputRe - kernelIm * inputIm;
+			resultIm += kernelRe * inputIm + kernelIm * inputRe;
+		}
+		step->output[2 * i] = resultRe;
+		step->output[2 * i + 1] = resultIm;
+	}
+}
+#endif
 typedef struct VkFFTApplication {
 	VkFFTConfiguration configuration = {};
 	VkFFTPlan localFFTPlan = {};
 	VkFFTPlan localFFTPlan_inverse_convolution = {}; //additional inverse plan for convolution.
+	VkFFTDeviceLimits deviceLimits = {};
+	VkFFTPassTiming* passTimings = NULL; //passes recorded since the last resetPassTimestamps call
+	uint32_t numPassTimings = 0;
+	uint32_t numTimestampQueries = 0;
+	uint32_t lastTimestampQuery = 0;
+	PFN_vkCmdBeginDebugUtilsLabelEXT cmdBeginDebugUtilsLabel = NULL; //loaded only if debugLabels is set and the extension is available
+	PFN_vkCmdEndDebugUtilsLabelEXT cmdEndDebugUtilsLabel = NULL;
+	PFN_vkSetDebugUtilsObjectNameEXT setDebugUtilsObjectName = NULL;
+	bool isPassLabelOpen = false;
+	VkFFTAxis* pendingBarrierAxis = NULL; //pass whose barrier is not recorded yet, see VkFFTPassBarrier
+	bool isDryRun = false; //VkFFTAppend only records dispatch grids of the passes, no commands are written
+	float* hostBuffer = NULL; //with isDryRun, dispatches of C2C passes are also executed on this host copy of the buffer by executeOnHost
+	float* hostSnapshot = NULL;
+	bool isHostRunFailed = false;
+#ifdef VKFFT_CPU_BACKEND
+	bool isCPUBackend = false; //no Vulkan objects are created, the plan is executed on the host by executeOnCPU
+	VkFFTCPUThreadPool* threadPool = NULL;
+	float** threadScratch = NULL;
+	float* twiddleTables[3] = { NULL, NULL, NULL }; //exp(2 pi i j / size[axis]), computed in double precision
+	float** fourStepScratch = NULL; //two lines per thread of axes that are split in two passes. Threads other than the first one only hold lines up to fourStepThreadDim
+	uint32_t fourStepThreadDim = 0; //longest line that is done by one thread, longer ones are done one at a time by all threads
+	VkFFTCPUPass* fourStepPass = NULL;
+	float* convolutionScratch = NULL; //spectrum of all coordinates of one input batch
+	uint32_t* storageOrder[3] = { NULL, NULL, NULL }; //frequency stored at each index of the axes the GPU planner splits in several uploads, NULL - natural order
+	uint32_t* supportStorageOrder[2] = { NULL, NULL }; //same for the last column of R2C y and z axes, which is planned as the support axis
+	float** reorderScratch = NULL; //one line per thread of the longest reordered axis
+#endif
 	uint32_t* VkFFTReadShader(uint32_t& length, const char* filename) {
 
 		FILE* fp = fopen(filename, "rb");
 		if (fp == NULL) {
 			printf("Could not find or open file: %s\n", filename);
+			length = 0;
+			return NULL;
 		}
 
 		// get file size.
@@ -124,579 +740,253 @@ typedef struct VkFFTApplication {
 		length = filesizepadded;
 		return (uint32_t*)str;
 	}
-	void VkFFTInitShader(uint32_t shader_id, VkShaderModule* shaderModule) {
-
-		char filename[256];
+	const char* VkFFTGetShaderName(uint32_t shader_id) {
+		//file name of the precompiled shader, relative to shaderPath
 		switch (shader_id) {
 		case 0:
 			//printf("vkFFT_single_c2c\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c.spv");
-			break;
+			return "vkFFT_single_c2c.spv";
 		case 1:
 			//printf("vkFFT_single_c2r\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2r.spv");
-			break;
+			return "vkFFT_single_c2r.spv";
 		case 2:
 			//printf("vkFFT_single_c2c_strided\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c_strided.spv");
-			break;
+			return "vkFFT_single_c2c_strided.spv";
 		case 3:
 			//printf("vkFFT_single_r2c\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_r2c.spv");
-			break;
+			return "vkFFT_single_r2c.spv";
 		case 4:
 			//printf("vkFFT_single_r2c_zp\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_r2c_zp.spv");
-			break;
+			return "vkFFT_single_r2c_zp.spv";
 		case 5:
 			//printf("vkFFT_single_c2c_afterR2C\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c_afterR2C.spv");
-			break;
+			return "vkFFT_single_c2c_afterR2C.spv";
 		case 6:
 			//printf("vkFFT_single_c2c_beforeC2R\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_c2c_beforeC2R.spv");
-			break;
+			return "vkFFT_single_c2c_beforeC2R.spv";
 		case 7:
 			//printf("vkFFT_grouped_c2c\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_c2c.spv");
-			break;
+			return "vkFFT_grouped_c2c.spv";
 		case 8:
 			//printf("vkFFT_grouped_convolution_1x1\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_1x1.spv");
-			break;
+			return "vkFFT_grouped_convolution_1x1.spv";
 		case 9:
 			//printf("vkFFT_single_convolution_1x1\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_1x1.spv");
-			break;
+			return "vkFFT_single_convolution_1x1.spv";
 		case 10:
 			//printf("vkFFT_single_strided_convolution_1x1\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_strided_convolution_1x1.spv");
-			break;
-		case 11:
-			//printf("vkFFT_grouped_convolution_symmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_symmetric_2x2.spv");
-			break;
-		case 12:
-			//printf("vkFFT_single_convolution_symmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_symmetric_2x2.spv");
-			break;
+			return "vkFFT_single_strided_convolution_1x1.spv";
 		case 13:
 			//printf("vkFFT_single_strided_convolution_symmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_strided_convolution_symmetric_2x2.spv");
-			break;
-		case 14:
-			//printf("vkFFT_grouped_convolution_nonsymmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_nonsymmetric_2x2.spv");
-			break;
-		case 15:
-			//printf("vkFFT_single_convolution_nonsymmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_nonsymmetric_2x2.spv");
-			break;
+			return "vkFFT_single_strided_convolution_symmetric_2x2.spv";
 		case 16:
 			//printf("vkFFT_single_strided_convolution_nonsymmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_strided_convolution_nonsymmetric_2x2.spv");
-			break;
-		case 17:
-			//printf("vkFFT_grouped_convolution_symmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_symmetric_3x3.spv");
-			break;
-		case 18:
-			//printf("vkFFT_single_convolution_symmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_symmetric_3x3.spv");
-			break;
+			return "vkFFT_single_strided_convolution_nonsymmetric_2x2.spv";
 		case 19:
 			//printf("vkFFT_single_strided_convolution_symmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_strided_convolution_symmetric_3x3.spv");
-			break;
-		case 20:
-			//printf("vkFFT_grouped_convolution_nonsymmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_convolution_nonsymmetric_3x3.spv");
-			break;
-		case 21:
-			//printf("vkFFT_single_convolution_nonsymmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_convolution_nonsymmetric_3x3.spv");
-			break;
+			return "vkFFT_single_strided_convolution_symmetric_3x3.spv";
 		case 22:
 			//printf("vkFFT_single_strided_convolution_nonsymmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_single_strided_convolution_nonsymmetric_3x3.spv");
-			break;
+			return "vkFFT_single_strided_convolution_nonsymmetric_3x3.spv";
 		case 23:
 			//printf("vkFFT_single_c2r_8192\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "8192/vkFFT_single_c2r_8192.spv");
-			break;
+			return "8192/vkFFT_single_c2r_8192.spv";
 		case 24:
 			//printf("vkFFT_single_r2c_8192\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "8192/vkFFT_single_r2c_8192.spv");
-			break;
+			return "8192/vkFFT_single_r2c_8192.spv";
 		case 25:
 			//printf("vkFFT_single_c2c_8192\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "8192/vkFFT_single_c2c_8192.spv");
-			break;
+			return "8192/vkFFT_single_c2c_8192.spv";
 		case 26:
 			//printf("vkFFT_grouped_strided_convolution_1x1\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_strided_convolution_1x1.spv");
-			break;
+			return "vkFFT_grouped_strided_convolution_1x1.spv";
 		case 27:
 			//printf("vkFFT_grouped_strided_convolution_symmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_strided_convolution_symmetric_2x2.spv");
-			break;
+			return "vkFFT_grouped_strided_convolution_symmetric_2x2.spv";
 		case 28:
 			//printf("vkFFT_grouped_strided_convolution_nonsymmetric_2x2\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_strided_convolution_nonsymmetric_2x2.spv");
-			break;
+			return "vkFFT_grouped_strided_convolution_nonsymmetric_2x2.spv";
 		case 29:
 			//printf("vkFFT_grouped_strided_convolution_symmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_strided_convolution_symmetric_3x3.spv");
-			break;
+			return "vkFFT_grouped_strided_convolution_symmetric_3x3.spv";
 		case 30:
 			//printf("vkFFT_grouped_strided_convolution_nonsymmetric_3x3\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "vkFFT_grouped_strided_convolution_nonsymmetric_3x3.spv");
-			break;
+			return "vkFFT_grouped_strided_convolution_nonsymmetric_3x3.spv";
 		case 33:
 			//printf("vkFFT_single_c2r_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_c2r_16384.spv");
-			break;
+			return "16384/vkFFT_single_c2r_16384.spv";
 		case 34:
 			//printf("vkFFT_single_r2c_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_r2c_16384.spv");
-			break;
+			return "16384/vkFFT_single_r2c_16384.spv";
 		case 35:
 			//printf("vkFFT_single_c2c_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_c2c_16384.spv");
-			break;
+			return "16384/vkFFT_single_c2c_16384.spv";
 		case 36:
 			//printf("vkFFT_single_c2r_for_transposition_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_c2r_for_transposition_16384.spv");
-			break;
+			return "16384/vkFFT_single_c2r_for_transposition_16384.spv";
 		case 37:
 			//printf("vkFFT_single_r2c_for_transposition_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_r2c_for_transposition_16384.spv");
-			break;
+			return "16384/vkFFT_single_r2c_for_transposition_16384.spv";
 		case 38:
 			//printf("vkFFT_single_c2c_for_transposition_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_c2c_for_transposition_16384.spv");
-			break;
+			return "16384/vkFFT_single_c2c_for_transposition_16384.spv";
 		case 39:
 			//printf("vkFFT_single_c2c_afterR2C_for_transposition_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_c2c_afterR2C_for_transposition_16384.spv");
-			break;
+			return "16384/vkFFT_single_c2c_afterR2C_for_transposition_16384.spv";
 		case 40:
 			//printf("vkFFT_single_c2c_beforeC2R_for_transposition_16384\n");
-			sprintf(filename, "%s%s", configuration.shaderPath, "16384/vkFFT_single_c2c_beforeC2R_for_transposition_16384.spv");
-			break;
+			return "16384/vkFFT_single_c2c_beforeC2R_for_transposition_16384.spv";
+		case 41:
+			return "vkFFT_single_convolution_matrix.spv";
+		case 42:
+			return "vkFFT_grouped_convolution_matrix.spv";
 		}
-
-
+		return "";
+	}
+	VkResult VkFFTInitShader(uint32_t shader_id, VkShaderModule* shaderModule, VkFFTAxis* axis) {
+		axis->shaderID = shader_id;
+		char filename[256];
+		sprintf(filename, "%s%s", configuration.shaderPath, VkFFTGetShaderName(shader_id));
 		uint32_t filelength;
 		uint32_t* code = VkFFTReadShader(filelength, filename);
+		if (code == NULL) return VK_ERROR_INITIALIZATION_FAILED;
 		VkShaderModuleCreateInfo createInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
 		createInfo.pCode = code;
 		createInfo.codeSize = filelength;
-		vkCreateShaderModule(configuration.device[0], &createInfo, NULL, shaderModule);
+		VkResult res = vkCreateShaderModule(configuration.device[0], &createInfo, NULL, shaderModule);
 		free(code);
-
+		return res;
 	}
-	void VkFFTPlanAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, uint32_t axis_upload_id, bool inverse) {
-		//get radix stages
-		VkFFTAxis* axis = &FFTPlan->axes[axis_id][axis_upload_id];
-		
-		if (axis_id == 0) {
-			//configure radix stages
-			uint32_t logSize = log2(configuration.size[axis_id]);
-			uint32_t numPasses[8][8];//4096-8k(256KB)-16k(256KB)-32k-64k - find correct strided FFT configuration - x axis | 256-512-1024-2048(256KB)-4096(256KB)-8k(future?)-16k(future?) - find correct strided FFT configuration
-			for (uint32_t i = 0; i < 8; i++) {
-				for (uint32_t j = 0; j < 8; j++) {
-					numPasses[i][j] = 0;
-				}
-			}
-			uint32_t temp = configuration.size[axis_id];
-			uint32_t startStage = 4096;
-			uint32_t continueStage = 256;
-			uint32_t maxPassId[2] = { 0,0 };
-			uint32_t minPassId[2] = { 0,0 };
-			maxPassId[0] += log2(configuration.registerBoost);
-			uint32_t maxSingleSize = 8 * 4096 / configuration.coalescedMemory;
-			maxPassId[1] = log2(maxSingleSize / 256);
-			minPassId[1] = (maxSingleSize >= 512) ? 1 : 0;
-			//maxPassId[1] += log2(configuration.registerBoost);//in development
-			for (uint32_t i = 0; i < 8; i++) {
-				for (uint32_t j = 0; j < 8; j++) {
-					temp /= startStage;
-					numPasses[i][j]++;
-					while (temp > 1)
-					{
-						temp /= continueStage;
-						numPasses[i][j]++;
-					}
-					continueStage *= 2;
-					temp = configuration.size[axis_id];
-				}
-				continueStage = 256;
-				startStage *= 2;
-			}
-			uint32_t passId[2] = { minPassId[0], minPassId[1] };
-			for (uint32_t i = minPassId[0]; i < maxPassId[0]+1; i++) {
-				for (uint32_t j = minPassId[1]; j < maxPassId[1]+1; j++) {
-					if (numPasses[i][j] < numPasses[passId[0]][passId[1]]) {
-						passId[0] = i;
-						passId[1] = j;
-					}
-				}
-			}
-			FFTPlan->numAxisUploads[axis_id] = numPasses[passId[0]][passId[1]];
-			if (axis_upload_id >= numPasses[passId[0]][passId[1]])
-				return;
-			if (axis_upload_id == 0) {
-				//first pass is non-strided, special case
-				switch (configuration.radix) {
-				case 8: {
-					uint32_t logSize0Pass = (12 + passId[0] < logSize) ? 12 + passId[0] : logSize; //4096 + shift
-					if ((axis_upload_id + 1 == numPasses[passId[0]][passId[1]] - 1) && (logSize - logSize0Pass < 3))
-						logSize0Pass -= (3 - (logSize - logSize0Pass));
-					uint32_t stage8 = logSize0Pass / 3;
-					uint32_t stage4 = 0;
-					uint32_t stage2 = 0;
-					if (logSize0Pass % 3 == 2)
-						stage4 = 1;
-					if (logSize0Pass % 3 == 1)
-						stage2 = 1;
-					uint32_t totNumStages = stage8 + stage4 + stage2;
-
-					axis->specializationConstants.numStages = stage8;
-					axis->specializationConstants.fftDim = pow(8, stage8);
-					axis->specializationConstants.stageRadix[0] = 8;
-					axis->specializationConstants.stageRadix[1] = 8;
-
-					if (stage4 == 1) {
-						axis->specializationConstants.numStages++;
-						axis->specializationConstants.stageRadix[1] = 4;
-						axis->specializationConstants.fftDim *= 4;
-					}
-					if (stage2 == 1) {
-						axis->specializationConstants.numStages++;
-						axis->specializationConstants.stageRadix[1] = 2;
-						axis->specializationConstants.fftDim *= 2;
-					}
-					axis->specializationConstants.stageStartSize = 1;
-					if (configuration.performR2C)
-						axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-					else
-						axis->specializationConstants.fft_dim_x = configuration.size[0];
-
-					break;
-				}
-				case 4: {
-					uint32_t stage4 = logSize / 2;
-					uint32_t stage2 = 0;
-					if (logSize % 2 == 1)
-						stage2 = 1;
-					axis->specializationConstants.numStages = stage4 + stage2;
-
-
-					axis->specializationConstants.stageRadix[0] = 4;
-					axis->specializationConstants.stageRadix[1] = 4;
-					if (logSize % 2 == 1)
-						axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				case 2: {
-					uint32_t stage2 = logSize;
-
-					axis->specializationConstants.numStages = stage2;
-
-
-					axis->specializationConstants.stageRadix[0] = 2;
-					axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				}
-			}
-			else {
-				//passes after first are done similar to strided passes in y and z
-				uint32_t logSizeLaterPass = (logSize - 12 - passId[0]<3) ? 3 : logSize - 12 - passId[0]; //4096 + shift
-				switch (configuration.radix) {
-				case 8: {
-					uint32_t stage8 = logSizeLaterPass / 3;
-					uint32_t stage4 = 0;
-					uint32_t stage2 = 0;
-					if (logSizeLaterPass % 3 == 2)
-						stage4 = 1;
-					if (logSizeLaterPass % 3 == 1)
-						stage2 = 1;
-					uint32_t totNumStages = stage8 + stage4 + stage2;
-					uint32_t locNumStages = 0;
-					if (passId[1] == minPassId[1]) {
-						locNumStages = stage8 / (numPasses[passId[0]][passId[1]] - 1);
-						if (axis_upload_id < stage8 % (numPasses[passId[0]][passId[1]] - 1))
-							locNumStages++;
-						axis->specializationConstants.numStages = locNumStages;
-						axis->specializationConstants.fftDim = pow(8, locNumStages);
-						axis->specializationConstants.stageRadix[0] = 8;
-						axis->specializationConstants.stageRadix[1] = 8;
-
-						if (axis_upload_id == (numPasses[passId[0]][passId[1]] - 1)) {
-							if (stage4 == 1) {
-								axis->specializationConstants.numStages++;
-								axis->specializationConstants.stageRadix[1] = 4;
-								axis->specializationConstants.fftDim *= 4;
-							}
-							if (stage2 == 1) {
-								axis->specializationConstants.numStages++;
-								axis->specializationConstants.stageRadix[1] = 2;
-								axis->specializationConstants.fftDim *= 2;
-							}
-						}
-						axis->specializationConstants.stageStartSize = FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-						if (configuration.performR2C)
-							axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-						else
-							axis->specializationConstants.fft_dim_x = configuration.size[0];
-					}
-					else {
-						if (axis_upload_id < numPasses[passId[0]][passId[1]] - 1) {
-							uint32_t locLogSize = 8 + passId[1];
-							if ((axis_upload_id + 1 == numPasses[passId[0]][passId[1]] - 1) && (logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2) < 3))
-								locLogSize -= (3 - (logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2)));
-							uint32_t locStage8 = locLogSize / 3;
-							uint32_t locStage4 = 0;
-							uint32_t locStage2 = 0;
-							if (locLogSize % 3 == 2)
-								locStage4 = 1;
-							if (locLogSize % 3 == 1)
-								locStage2 = 1;
-							axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-							axis->specializationConstants.fftDim = pow(2, locLogSize);
-							axis->specializationConstants.stageRadix[0] = 8;
-							axis->specializationConstants.stageRadix[1] = 8;
-
-							if (locStage4 == 1) {
-								axis->specializationConstants.stageRadix[1] = 4;
-							}
-							if (locStage2 == 1) {
-								axis->specializationConstants.stageRadix[1] = 2;
-							}
-							axis->specializationConstants.stageStartSize = FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-							if (configuration.performR2C)
-								axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-							else
-								axis->specializationConstants.fft_dim_x = configuration.size[0];
-						}
-						else {
-							uint32_t locLogSize = (logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2) < 3) ? 3 : logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2);
-							uint32_t locStage8 = locLogSize / 3;
-							uint32_t locStage4 = 0;
-							uint32_t locStage2 = 0;
-							if (locLogSize % 3 == 2)
-								locStage4 = 1;
-							if (locLogSize % 3 == 1)
-								locStage2 = 1;
-							axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-							axis->specializationConstants.fftDim = pow(2, locLogSize);
-							axis->specializationConstants.stageRadix[0] = 8;
-							axis->specializationConstants.stageRadix[1] = 8;
-
-							if (locStage4 == 1) {
-								axis->specializationConstants.stageRadix[1] = 4;
-							}
-							if (locStage2 == 1) {
-								axis->specializationConstants.stageRadix[1] = 2;
-							}
-							axis->specializationConstants.stageStartSize = FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-							if (configuration.performR2C)
-								axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-							else
-								axis->specializationConstants.fft_dim_x = configuration.size[0];
-						}
-					}
-
-
-					break;
-				}
-				case 4: {
-					uint32_t stage4 = logSize / 2;
-					uint32_t stage2 = 0;
-					if (logSize % 2 == 1)
-						stage2 = 1;
-					axis->specializationConstants.numStages = stage4 + stage2;
-
-
-					axis->specializationConstants.stageRadix[0] = 4;
-					axis->specializationConstants.stageRadix[1] = 4;
-					if (logSize % 2 == 1)
-						axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				case 2: {
-					uint32_t stage2 = logSize;
-
-					axis->specializationConstants.numStages = stage2;
-
-
-					axis->specializationConstants.stageRadix[0] = 2;
-					axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				}
-			}
-		}else{
-			//configure radix stages
-			uint32_t logSize = log2(configuration.size[axis_id]);
-			uint32_t numPasses[8] = { 0,0,0,0,0,0,0,0 };//256-512-1024-2048(256KB)-4096(256KB)-8k(future?)-16k(future?) - find correct strided FFT configuration
-			uint32_t temp = configuration.size[axis_id];
-			uint32_t startStage = 256;
-			uint32_t maxSingleSize = 8 * 4096 / configuration.coalescedMemory;
-			uint32_t maxPassId = log2(maxSingleSize / 256);
-			uint32_t minPassId = (maxSingleSize >= 512) ? 1 : 0;
-			//maxPassId += log2(configuration.registerBoost);//in development
-			for (uint32_t i = 0; i < 8; i++) {
-				while (temp > 1)
-				{
-					temp /= startStage;
-					numPasses[i]++;
-				}
-				temp = configuration.size[axis_id];
-				startStage *= 2;
-			}
-			uint32_t passId = minPassId;
-			for (uint32_t i = minPassId; i < maxPassId+1; i++) {
-				if (numPasses[i] < numPasses[passId]) {
-					passId = i;
-				}
-			}
-			FFTPlan->numAxisUploads[axis_id] = numPasses[passId];
-			if (axis_upload_id >= numPasses[passId])
-				return;
-			switch (configuration.radix) {
-			case 8: {
-				uint32_t stage8 = logSize / 3;
-				uint32_t stage4 = 0;
-				uint32_t stage2 = 0;
-				if (logSize % 3 == 2)
-					stage4 = 1;
-				if (logSize % 3 == 1)
-					stage2 = 1;
-				uint32_t totNumStages = stage8 + stage4 + stage2;
-				uint32_t locNumStages = 0;
-				if (passId == minPassId) {
-					locNumStages = stage8 / numPasses[passId];
-					if (axis_upload_id < stage8 % numPasses[passId])
-						locNumStages++;
-					axis->specializationConstants.numStages = locNumStages;
-					axis->specializationConstants.fftDim = pow(8, locNumStages);
-					axis->specializationConstants.stageRadix[0] = 8;
-					axis->specializationConstants.stageRadix[1] = 8;
-
-					if (axis_upload_id == numPasses[passId] - 1) {
-						if (stage4 == 1) {
-							axis->specializationConstants.numStages++;
-							axis->specializationConstants.stageRadix[1] = 4;
-							axis->specializationConstants.fftDim *= 4;
-						}
-						if (stage2 == 1) {
-							axis->specializationConstants.numStages++;
-							axis->specializationConstants.stageRadix[1] = 2;
-							axis->specializationConstants.fftDim *= 2;
-						}
-					}
-					axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-					if (configuration.performR2C)
-						axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-					else
-						axis->specializationConstants.fft_dim_x = configuration.size[0];
-				}
-				else {
-					if (axis_upload_id < numPasses[passId] - 1) {
-
-						uint32_t locLogSize = 8 + passId;
-						if ((axis_upload_id + 1 == numPasses[passId] - 1) && (logSize - (8 + passId) * (numPasses[passId] - 1) < 3))
-							locLogSize -= (3 - (logSize - (8 + passId) * (numPasses[passId] - 1)));
-						uint32_t locStage8 = locLogSize / 3;
-						uint32_t locStage4 = 0;
-						uint32_t locStage2 = 0;
-						if (locLogSize % 3 == 2)
-							locStage4 = 1;
-						if (locLogSize % 3 == 1)
-							locStage2 = 1;
-						axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-						axis->specializationConstants.fftDim = pow(2, locLogSize);
-						axis->specializationConstants.stageRadix[0] = 8;
-						axis->specializationConstants.stageRadix[1] = 8;
-
-						if (locStage4 == 1) {
-							axis->specializationConstants.stageRadix[1] = 4;
-						}
-						if (locStage2 == 1) {
-							axis->specializationConstants.stageRadix[1] = 2;
-						}
-						axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-						if (configuration.performR2C)
-							axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-						else
-							axis->specializationConstants.fft_dim_x = configuration.size[0];
-					}
-					else {
-						uint32_t locLogSize = (logSize - (8 + passId)*(numPasses[passId] - 1)<3) ? 3 : logSize - (8 + passId) * (numPasses[passId] - 1);
-						uint32_t locStage8 = locLogSize / 3;
-						uint32_t locStage4 = 0;
-						uint32_t locStage2 = 0;
-						if (locLogSize % 3 == 2)
-							locStage4 = 1;
-						if (locLogSize % 3 == 1)
-							locStage2 = 1;
-						axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-						axis->specializationConstants.fftDim = pow(2, locLogSize);
-						axis->specializationConstants.stageRadix[0] = 8;
-						axis->specializationConstants.stageRadix[1] = 8;
-
-						if (locStage4 == 1) {
-							axis->specializationConstants.stageRadix[1] = 4;
-						}
-						if (locStage2 == 1) {
-							axis->specializationConstants.stageRadix[1] = 2;
-						}
-						axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-						if (configuration.performR2C)
-							axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-						else
-							axis->specializationConstants.fft_dim_x = configuration.size[0];
+	uint64_t VkFFTPlanPass(VkFFTStagePlan* stagePlan, uint32_t pass, uint32_t passLogSize, bool strided, uint32_t contiguousRun, uint32_t maxGroupedBatch, uint64_t systemSize) {
+		//score one pass of passLogSize, returns 0 if it can't be done within the device limits
+		uint32_t sharedMemorySize = deviceLimits.sharedMemorySize;
+		uint32_t maxInvocations = deviceLimits.maxWorkGroupInvocations;
+		uint32_t* maxWorkGroupSize = deviceLimits.maxWorkGroupSize;
+		//radix sequence - shaders do stageRadix[0] stages and finish with one stageRadix[1] stage, pick the one with the least stages
+		uint32_t numStages = 0;
+		uint32_t stageRadix[2] = { configuration.radix, configuration.radix };
+		if (passLogSize > 0) {
+			numStages = 0xFFFFFFFF;
+			for (uint32_t radix0 = configuration.radix; radix0 > 1; radix0 /= 2) {
+				for (uint32_t radix1 = configuration.radix; radix1 > 1; radix1 /= 2) {
+					uint32_t logRadix0 = log2(radix0);
+					uint32_t logRadix1 = log2(radix1);
+					if ((passLogSize < logRadix1) || ((passLogSize - logRadix1) % logRadix0 != 0)) continue;
+					if ((passLogSize - logRadix1) / logRadix0 + 1 < numStages) {
+						numStages = (passLogSize - logRadix1) / logRadix0 + 1;
+						stageRadix[0] = radix0;
+						stageRadix[1] = radix1;
 					}
 				}
-
-
-				break;
-			}
-			case 4: {
-				uint32_t stage4 = logSize / 2;
-				uint32_t stage2 = 0;
-				if (logSize % 2 == 1)
-					stage2 = 1;
-				axis->specializationConstants.numStages = stage4 + stage2;
-
-
-				axis->specializationConstants.stageRadix[0] = 4;
-				axis->specializationConstants.stageRadix[1] = 4;
-				if (logSize % 2 == 1)
-					axis->specializationConstants.stageRadix[1] = 2;
-				break;
-			}
-			case 2: {
-				uint32_t stage2 = logSize;
-
-				axis->specializationConstants.numStages = stage2;
-
-
-				axis->specializationConstants.stageRadix[0] = 2;
-				axis->specializationConstants.stageRadix[1] = 2;
-				break;
 			}
+			if (numStages == 0xFFFFFFFF) return 0;
+		}
+		uint32_t fftDim = 1 << passLogSize;
+		uint32_t threads = (fftDim / 8 > 1) ? fftDim / 8 : 1;
+		uint32_t groupedBatch = 1;
+		uint64_t memoryTraffic = 2 * systemSize * 8;
+		if (!strided) {
+			//8192 and 16384 sequences are done by register-boosted shaders with 512 threads
+			if (((passLogSize == 13) && (configuration.registerBoost >= 2)) || ((passLogSize == 14) && (configuration.registerBoost >= 4))) {
+				if (fftDim * 8 > sharedMemorySize * configuration.registerBoost) return 0;
+				threads = 512;
 			}
+			else if (fftDim * 8 > sharedMemorySize) return 0;
+			if ((threads > maxInvocations) || (threads > maxWorkGroupSize[0])) return 0;
+		}
+		else {
+			if ((fftDim * 8 > sharedMemorySize) || (threads > maxInvocations) || (threads > maxWorkGroupSize[1])) return 0;
+			//merge as many strided sequences in one workgroup as fit, reads of rows shorter than coalescedMemory waste bandwidth
+			while ((groupedBatch * 2 <= contiguousRun) && ((maxGroupedBatch == 0) || (groupedBatch * 2 <= maxGroupedBatch)) && (groupedBatch * 2 * fftDim * 8 <= sharedMemorySize) && (groupedBatch * 2 * threads <= maxInvocations) && (groupedBatch * 2 <= maxWorkGroupSize[0]))
+				groupedBatch *= 2;
+			if (groupedBatch * 8 < configuration.coalescedMemory)
+				memoryTraffic = memoryTraffic * configuration.coalescedMemory / (groupedBatch * 8);
 		}
+		stagePlan->logSize[pass] = passLogSize;
+		stagePlan->numStages[pass] = numStages;
+		stagePlan->stageRadix[pass][0] = stageRadix[0];
+		stagePlan->stageRadix[pass][1] = stageRadix[1];
+		stagePlan->groupedBatch[pass] = groupedBatch;
+		stagePlan->memoryTraffic += memoryTraffic;
+		stagePlan->sharedTraffic += numStages * 2 * systemSize * 8;
+		stagePlan->barrierCount += 1 + numStages;
+		//shared memory is assumed to be 8 times faster than global memory, global barrier between passes costs as much as 64KB of traffic. Workgroups smaller than a subgroup leave lanes idle during radix stages
+		uint64_t sharedCost = numStages * 2 * systemSize;
+		if (groupedBatch * threads < deviceLimits.subgroupSize)
+			sharedCost = sharedCost * deviceLimits.subgroupSize / (groupedBatch * threads);
+		return memoryTraffic + sharedCost + 65536;
+	}
+	void VkFFTEnumeratePasses(VkFFTStagePlan* currentPlan, VkFFTStagePlan* bestPlan, uint32_t pass, uint32_t numPasses, uint32_t remainingLogSize, uint32_t doneLogSize, bool stridedFirstPass, uint32_t contiguousRun, uint32_t maxGroupedBatch, uint64_t systemSize) {
+		if (pass == numPasses - 1) {
+			//last pass takes the rest of the sequence
+			if ((numPasses > 1) && (remainingLogSize < 3)) return;
+			VkFFTStagePlan plan = *currentPlan;
+			uint64_t passCost = VkFFTPlanPass(&plan, pass, remainingLogSize, (pass > 0) || stridedFirstPass, (stridedFirstPass) ? contiguousRun : (1 << doneLogSize), maxGroupedBatch, systemSize);
+			if (passCost == 0) return;
+			plan.cost += passCost;
+			plan.numPasses = numPasses;
+			if ((bestPlan->numPasses == 0) || (plan.cost < bestPlan->cost))
+				*bestPlan = plan;
+			return;
+		}
+		//passes before the last one - larger passes first, all passes of multi-upload sequences are at least 8 long
+		for (uint32_t passLogSize = remainingLogSize - 3 * (numPasses - 1 - pass); passLogSize >= 3; passLogSize--) {
+			VkFFTStagePlan plan = *currentPlan;
+			uint64_t passCost = VkFFTPlanPass(&plan, pass, passLogSize, (pass > 0) || stridedFirstPass, (stridedFirstPass) ? contiguousRun : (1 << doneLogSize), maxGroupedBatch, systemSize);
+			if (passCost == 0) continue;
+			plan.cost += passCost;
+			if ((bestPlan->numPasses > 0) && (plan.cost >= bestPlan->cost)) continue;
+			VkFFTEnumeratePasses(&plan, bestPlan, pass + 1, numPasses, remainingLogSize - passLogSize, doneLogSize + passLogSize, stridedFirstPass, contiguousRun, maxGroupedBatch, systemSize);
+		}
+	}
+	void VkFFTPlanStages(VkFFTStagePlan* stagePlan, uint32_t logSize, bool stridedFirstPass, uint32_t contiguousRun, uint32_t maxGroupedBatch) {
+		//enumerate splits of the sequence in passes, radix sequence and groupedBatch of each pass and keep the one with the lowest predicted memory traffic and barrier count. Enumeration order is fixed, so the planning is deterministic
+		uint64_t systemSize = (uint64_t)configuration.size[0] * configuration.size[1] * configuration.size[2];
+		VkFFTStagePlan currentPlan = {};
+		*stagePlan = {};
+		uint32_t firstLegalNumPasses = 0;
+		for (uint32_t numPasses = 1; numPasses <= 5; numPasses++) {
+			if ((firstLegalNumPasses > 0) && (numPasses > firstLegalNumPasses + 1)) break;
+			if ((numPasses > 1) && (logSize < 3 * numPasses)) break;
+			VkFFTEnumeratePasses(&currentPlan, stagePlan, 0, numPasses, logSize, 0, stridedFirstPass, contiguousRun, maxGroupedBatch, systemSize);
+			if ((firstLegalNumPasses == 0) && (stagePlan->numPasses > 0)) firstLegalNumPasses = numPasses;
+		}
+		if (stagePlan->numPasses == 0)
+			printf("Sequence of size %d can't be done in 5 passes within the device limits\n", 1 << logSize);
+	}
+	VkResult VkFFTPlanAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, uint32_t axis_upload_id, bool inverse) {
+		//get radix stages
+		VkFFTAxis* axis = &FFTPlan->axes[axis_id][axis_upload_id];
+		
+		//configure radix stages
+		VkFFTStagePlan* stagePlan = &FFTPlan->stagePlan[axis_id];
+		if (axis_upload_id == 0) {
+			//first pass of x axis is non-strided, y and z axes merge groupedBatch sequences along x in one workgroup
+			uint32_t contiguousRun = (configuration.performR2C) ? configuration.size[0] / 2 : configuration.size[0];
+			VkFFTPlanStages(stagePlan, log2(configuration.size[axis_id]), (axis_id > 0), contiguousRun, configuration.groupedBatch[axis_id]);
+		}
+		FFTPlan->numAxisUploads[axis_id] = stagePlan->numPasses;
+		if (stagePlan->numPasses == 0)
+			return VK_ERROR_INITIALIZATION_FAILED;
+		if ((stagePlan->numPasses > 1) && (configuration.performOutputPruning[axis_id])) {
+			printf("Output pruning of axis %d is not supported, the axis is done in %d uploads and its result is stored in four step order\n", axis_id, stagePlan->numPasses);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		if (axis_upload_id >= stagePlan->numPasses)
+			return VK_SUCCESS;
+		axis->specializationConstants.numStages = stagePlan->numStages[axis_upload_id];
+		axis->specializationConstants.fftDim = 1 << stagePlan->logSize[axis_upload_id];
+		axis->specializationConstants.stageRadix[0] = stagePlan->stageRadix[axis_upload_id][0];
+		axis->specializationConstants.stageRadix[1] = stagePlan->stageRadix[axis_upload_id][1];
+		axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
+		if (configuration.performR2C)
+			axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
+		else
+			axis->specializationConstants.fft_dim_x = configuration.size[0];
 
-		//axis->groupedBatch = (4096 / axis->specializationConstants.fftDim >= configuration.coalescedMemory / 8) ? 4096 / axis->specializationConstants.fftDim : configuration.coalescedMemory / 8;
 		axis->specializationConstants.passID = FFTPlan->numAxisUploads[axis_id] - 1 - axis_upload_id;
 		axis->specializationConstants.fft_dim_full = configuration.size[axis_id];
-		axis->groupedBatch = (4096 / axis->specializationConstants.fftDim >= configuration.coalescedMemory / 8) ? 4096 / axis->specializationConstants.fftDim : configuration.coalescedMemory / 8;
-		//axis->groupedBatch = ((axis_upload_id > 0) && (axis->groupedBatch > axis->specializationConstants.stageStartSize)) ? axis->specializationConstants.stageStartSize : axis->groupedBatch;
+		axis->groupedBatch = stagePlan->groupedBatch[axis_upload_id];
 		/*if (4096 / configuration.size[1] > configuration.coalescedMemory / 16) {
 			configuration.performTranspose[0] = false;
 			FFTPlan->groupedBatch = 4096 / configuration.size[1];
@@ -712,6 +1002,11 @@ typedef struct VkFFTApplication {
 		else {
 			configuration.performTranspose[1] = true;
 		}*/
+		//zeropadded y and z ranges are dispatched from their start, skipped rows and planes are added to the offsets below. R2C x axis passes process rows in pairs, so their first row is even
+		uint32_t rangeStart[3] = { 0, 0, 0 };
+		for (uint32_t i = 1; i < configuration.FFTdim; i++)
+			if (configuration.performZeropadding[i]) rangeStart[i] = (inverse) ? configuration.zeropadOutputRange[i][0] : configuration.zeropadInputRange[i][0];
+		if (configuration.performR2C) rangeStart[1] -= rangeStart[1] % 2;
 		//configure strides
 		if (configuration.performR2C)
 		{
@@ -765,29 +1060,29 @@ typedef struct VkFFTApplication {
 			if (axis_id == 0) {
 				if ((axis_upload_id==0)&&(configuration.isInputFormatted) && (!inverse)) {
 					if (configuration.performZeropadding[0])
-						axis->specializationConstants.inputStride[1] = configuration.size[0] / 2;
+						axis->specializationConstants.inputStride[1] = configuration.zeropadInputRange[0][1] - configuration.zeropadInputRange[0][0];
 
 					if (configuration.performZeropadding[1])
-						axis->specializationConstants.inputStride[2] = axis->specializationConstants.inputStride[1] * configuration.size[1] / 4;
+						axis->specializationConstants.inputStride[2] = axis->specializationConstants.inputStride[1] * (configuration.zeropadInputRange[1][1] - rangeStart[1]) / 2;
 					else
 						axis->specializationConstants.inputStride[2] = axis->specializationConstants.inputStride[1] * configuration.size[1] / 2;
 
 					if (configuration.performZeropadding[2])
-						axis->specializationConstants.inputStride[3] = axis->specializationConstants.inputStride[2] * configuration.size[2] / 2;
+						axis->specializationConstants.inputStride[3] = axis->specializationConstants.inputStride[2] * (configuration.zeropadInputRange[2][1] - rangeStart[2]);
 					else
 						axis->specializationConstants.inputStride[3] = axis->specializationConstants.inputStride[2] * configuration.size[2];
 				}
 				if ((axis_upload_id == FFTPlan->numAxisUploads[axis_id]-1) && (configuration.isOutputFormatted) && ((inverse) || ((configuration.performConvolution) && (configuration.FFTdim == 1)))) {
 					if (configuration.performZeropadding[0])
-						axis->specializationConstants.outputStride[1] = configuration.size[0] / 2;
+						axis->specializationConstants.outputStride[1] = configuration.zeropadOutputRange[0][1] - configuration.zeropadOutputRange[0][0];
 
 					if (configuration.performZeropadding[1])
-						axis->specializationConstants.outputStride[2] = axis->specializationConstants.outputStride[1] * configuration.size[1] / 4;
+						axis->specializationConstants.outputStride[2] = axis->specializationConstants.outputStride[1] * (configuration.zeropadOutputRange[1][1] - rangeStart[1]) / 2;
 					else
 						axis->specializationConstants.outputStride[2] = axis->specializationConstants.outputStride[1] * configuration.size[1] / 2;
 
 					if (configuration.performZeropadding[2])
-						axis->specializationConstants.outputStride[3] = axis->specializationConstants.outputStride[2] * configuration.size[2] / 2;
+						axis->specializationConstants.outputStride[3] = axis->specializationConstants.outputStride[2] * (configuration.zeropadOutputRange[2][1] - rangeStart[2]);
 					else
 						axis->specializationConstants.outputStride[3] = axis->specializationConstants.outputStride[2] * configuration.size[2];
 				}
@@ -844,29 +1139,29 @@ typedef struct VkFFTApplication {
 			if (axis_id == 0) {
 				if ((axis_upload_id == 0) && (configuration.isInputFormatted) && (!inverse)) {
 					if (configuration.performZeropadding[0])
-						axis->specializationConstants.inputStride[1] = configuration.size[0] / 2;
+						axis->specializationConstants.inputStride[1] = configuration.zeropadInputRange[0][1] - configuration.zeropadInputRange[0][0];
 
 					if (configuration.performZeropadding[1])
-						axis->specializationConstants.inputStride[2] = axis->specializationConstants.inputStride[1] * configuration.size[1] / 2;
+						axis->specializationConstants.inputStride[2] = axis->specializationConstants.inputStride[1] * (configuration.zeropadInputRange[1][1] - rangeStart[1]);
 					else
 						axis->specializationConstants.inputStride[2] = axis->specializationConstants.inputStride[1] * configuration.size[1];
 
 					if (configuration.performZeropadding[2])
-						axis->specializationConstants.inputStride[3] = axis->specializationConstants.inputStride[2] * configuration.size[2] / 2;
+						axis->specializationConstants.inputStride[3] = axis->specializationConstants.inputStride[2] * (configuration.zeropadInputRange[2][1] - rangeStart[2]);
 					else
 						axis->specializationConstants.inputStride[3] = axis->specializationConstants.inputStride[2] * configuration.size[2];
 				}
 				if ((axis_upload_id == FFTPlan->numAxisUploads[axis_id]-1) && (configuration.isOutputFormatted) && ((inverse) || ((configuration.performConvolution) && (configuration.FFTdim == 1)))) {
 					if (configuration.performZeropadding[0])
-						axis->specializationConstants.outputStride[1] = configuration.size[0] / 2;
+						axis->specializationConstants.outputStride[1] = configuration.zeropadOutputRange[0][1] - configuration.zeropadOutputRange[0][0];
 
 					if (configuration.performZeropadding[1])
-						axis->specializationConstants.outputStride[2] = axis->specializationConstants.outputStride[1] * configuration.size[1] / 2;
+						axis->specializationConstants.outputStride[2] = axis->specializationConstants.outputStride[1] * (configuration.zeropadOutputRange[1][1] - rangeStart[1]);
 					else
 						axis->specializationConstants.outputStride[2] = axis->specializationConstants.outputStride[1] * configuration.size[1];
 
 					if (configuration.performZeropadding[2])
-						axis->specializationConstants.outputStride[3] = axis->specializationConstants.outputStride[2] * configuration.size[2] / 2;
+						axis->specializationConstants.outputStride[3] = axis->specializationConstants.outputStride[2] * (configuration.zeropadOutputRange[2][1] - rangeStart[2]);
 					else
 						axis->specializationConstants.outputStride[3] = axis->specializationConstants.outputStride[2] * configuration.size[2];
 				}
@@ -881,6 +1176,26 @@ typedef struct VkFFTApplication {
 			axis->specializationConstants.zeropad[1] = configuration.performZeropadding[axis_id + 1];
 		else
 			axis->specializationConstants.zeropad[1] = false;
+		axis->specializationConstants.zeropadInputRange[0] = configuration.zeropadInputRange[axis_id][0];
+		axis->specializationConstants.zeropadInputRange[1] = configuration.zeropadInputRange[axis_id][1];
+		axis->specializationConstants.zeropadOutputRange[0] = configuration.zeropadOutputRange[axis_id][0];
+		axis->specializationConstants.zeropadOutputRange[1] = configuration.zeropadOutputRange[axis_id][1];
+		axis->specializationConstants.nyquistOffset = configuration.size[1] / 2; //position of the packed N/2+1 element in R2C layout, doesn't depend on the dispatched zeropadded range
+		axis->specializationConstants.pruneOutput = false;
+		axis->specializationConstants.matrixConvolution = configuration.matrixConvolution;
+		axis->specializationConstants.symmetricKernel = configuration.symmetricKernel;
+		axis->specializationConstants.conjugateKernel = configuration.performCorrelation;
+		if ((axis_upload_id == ((inverse) ? FFTPlan->numAxisUploads[axis_id] - 1 : 0)) && (configuration.performOutputPruning[axis_id])) {
+			//last pass of the axis writes final output (inverse uploads are executed in reverse order) - store only bins in the intersection of the pruning window and the zeropadded output range
+			axis->specializationConstants.pruneOutput = true;
+			if (!((inverse) && (configuration.performZeropadding[axis_id]))) {
+				axis->specializationConstants.zeropadOutputRange[0] = 0;
+				axis->specializationConstants.zeropadOutputRange[1] = configuration.size[axis_id];
+			}
+			if (axis->specializationConstants.zeropadOutputRange[0] < configuration.outputPruningRange[axis_id][0]) axis->specializationConstants.zeropadOutputRange[0] = configuration.outputPruningRange[axis_id][0];
+			if (axis->specializationConstants.zeropadOutputRange[1] > configuration.outputPruningRange[axis_id][1]) axis->specializationConstants.zeropadOutputRange[1] = configuration.outputPruningRange[axis_id][1];
+			if (axis->specializationConstants.zeropadOutputRange[0] > axis->specializationConstants.zeropadOutputRange[1]) axis->specializationConstants.zeropadOutputRange[0] = axis->specializationConstants.zeropadOutputRange[1];
+		}
 		//not needed anymore as we don't transpose
 		if (!inverse) {
 			switch (axis_id) {
@@ -1076,6 +1391,41 @@ typedef struct VkFFTApplication {
 		}
 		axis->specializationConstants.inputOffset = 0;
 		axis->specializationConstants.outputOffset = 0;
+		axis->specializationConstants.rowPairShift = 0;
+		axis->dispatchShift[1] = 0;
+		axis->dispatchShift[2] = 0;
+		if (axis_id == 0) {
+			//formatted buffers store only the window of the zeropadded range - shift by the window start, the uint arithmetic of the shaders wraps
+			bool isFormattedInput = (axis_upload_id == 0) && (configuration.isInputFormatted) && (!inverse);
+			bool isFormattedOutput = (axis_upload_id == FFTPlan->numAxisUploads[axis_id] - 1) && (configuration.isOutputFormatted) && ((inverse) || ((configuration.performConvolution) && (configuration.FFTdim == 1)));
+			uint32_t formattedInputOffset = (configuration.performZeropadding[0]) ? 0 - configuration.zeropadInputRange[0][0] : 0;
+			uint32_t formattedOutputOffset = (configuration.performZeropadding[0]) ? 0 - configuration.zeropadOutputRange[0][0] : 0;
+			if (configuration.performR2C) {
+				//rows are addressed by their pair index in the R2C shaders, as the nyquist row pair is stored at the end of the plane
+				axis->specializationConstants.rowPairShift = rangeStart[1] / 2;
+				axis->dispatchShift[1] = rangeStart[1] / 2;
+				axis->dispatchShift[2] = rangeStart[2];
+				if (inverse) {
+					axis->specializationConstants.inputOffset = rangeStart[2] * axis->specializationConstants.inputStride[2];
+					axis->specializationConstants.outputOffset = (isFormattedOutput) ? formattedOutputOffset - rangeStart[1] * axis->specializationConstants.outputStride[1] : 2 * rangeStart[2] * axis->specializationConstants.outputStride[2];
+				}
+				else {
+					axis->specializationConstants.inputOffset = (isFormattedInput) ? formattedInputOffset - rangeStart[1] * axis->specializationConstants.inputStride[1] : 2 * rangeStart[2] * axis->specializationConstants.inputStride[2];
+					axis->specializationConstants.outputOffset = rangeStart[2] * axis->specializationConstants.outputStride[2];
+				}
+			}
+			else {
+				axis->dispatchShift[1] = rangeStart[1];
+				axis->dispatchShift[2] = rangeStart[2];
+				axis->specializationConstants.inputOffset = (isFormattedInput) ? formattedInputOffset : rangeStart[1] * axis->specializationConstants.inputStride[1] + rangeStart[2] * axis->specializationConstants.inputStride[2];
+				axis->specializationConstants.outputOffset = (isFormattedOutput) ? formattedOutputOffset : rangeStart[1] * axis->specializationConstants.outputStride[1] + rangeStart[2] * axis->specializationConstants.outputStride[2];
+			}
+		}
+		if (axis_id == 1) {
+			axis->dispatchShift[2] = rangeStart[2];
+			axis->specializationConstants.inputOffset = rangeStart[2] * axis->specializationConstants.inputStride[2];
+			axis->specializationConstants.outputOffset = rangeStart[2] * axis->specializationConstants.outputStride[2];
+		}
 
 		VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
 		descriptorPoolSize.descriptorCount = 2;
@@ -1125,7 +1475,8 @@ typedef struct VkFFTApplication {
 					descriptorBufferInfo.range = configuration.inputBufferSize[0];
 				}
 				else {
-					if ((axis_upload_id == 0) && (configuration.numberKernels > 1) && (inverse) && (!configuration.performConvolution)) {
+					if (((axis_upload_id == 0) && (configuration.numberKernels > 1) && (inverse) && (!configuration.performConvolution)) || ((configuration.numberKernels > 1) && (inverse) && (configuration.performConvolution))) {
+						//inverse FFT after convolution with multiple kernels continues on the expanded output
 						descriptorBufferInfo.buffer = configuration.outputBuffer[0];
 						descriptorBufferInfo.range = configuration.outputBufferSize[0];
 					}
@@ -1160,6 +1511,7 @@ typedef struct VkFFTApplication {
 				descriptorBufferInfo.offset = 0;
 				descriptorBufferInfo.range = configuration.kernelSize[0];
 			}
+			if (i < 2) axis->passBuffers[i] = descriptorBufferInfo.buffer;
 			VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
 			writeDescriptorSet.dstSet = axis->descriptorSet;
 			writeDescriptorSet.dstBinding = i;
@@ -1189,7 +1541,7 @@ typedef struct VkFFTApplication {
 					
 					if (axis_upload_id == 0) {
 						axis->axisBlock[0] = (axis->specializationConstants.fftDim / 8 > 1) ? axis->specializationConstants.fftDim / 8 : 1;
-						if (axis->axisBlock[0] > 512) axis->axisBlock[0] = 512;
+						if ((configuration.registerBoost > 1) && (axis->axisBlock[0] > 512)) axis->axisBlock[0] = 512; //register-boosted 8192 and 16384 shaders use 512 threads
 
 						axis->axisBlock[1] = 1;
 						axis->axisBlock[2] = 1;
@@ -1211,8 +1563,10 @@ typedef struct VkFFTApplication {
 
 					if (configuration.performR2C) {
 						if (axis_upload_id == 0) {
-							for (uint32_t i = 0; i < 8; i++)
-								VkFFTPlanSupportAxis(FFTPlan, 1, i, inverse);
+							for (uint32_t i = 0; i < 8; i++) {
+								VkResult res = VkFFTPlanSupportAxis(FFTPlan, 1, i, inverse);
+								if (res != VK_SUCCESS) return res;
+							}
 						}
 						axis->axisBlock[0] = (configuration.size[0] / 2 > axis->groupedBatch) ? axis->groupedBatch : configuration.size[0] / 2;
 						/*if (axis->axisBlock[0] * axis->axisBlock[1] < 64)
@@ -1239,8 +1593,10 @@ typedef struct VkFFTApplication {
 
 					if (configuration.performR2C) {
 						if (axis_upload_id == 0) {
-							for (uint32_t i = 0; i < 8; i++)
-								VkFFTPlanSupportAxis(FFTPlan, 2, i, inverse);
+							for (uint32_t i = 0; i < 8; i++) {
+								VkResult res = VkFFTPlanSupportAxis(FFTPlan, 2, i, inverse);
+								if (res != VK_SUCCESS) return res;
+							}
 						}
 						axis->axisBlock[0] = (configuration.size[0] / 2 > axis->groupedBatch) ? axis->groupedBatch : configuration.size[0] / 2;
 						/*if (axis->axisBlock[0] * axis->axisBlock[1] < 64)
@@ -1265,7 +1621,7 @@ typedef struct VkFFTApplication {
 				if (axis_id == 0) {
 					if (axis_upload_id == 0) {
 						axis->axisBlock[0] = (axis->specializationConstants.fftDim / 8 > 1) ? axis->specializationConstants.fftDim / 8 : 1;
-						if (axis->axisBlock[0] > 512) axis->axisBlock[0] = 512;
+						if ((configuration.registerBoost > 1) && (axis->axisBlock[0] > 512)) axis->axisBlock[0] = 512; //register-boosted 8192 and 16384 shaders use 512 threads
 
 						axis->axisBlock[1] = 1;
 						axis->axisBlock[2] = 1;
@@ -1286,8 +1642,10 @@ typedef struct VkFFTApplication {
 
 					if (configuration.performR2C) {
 						if (axis_upload_id == 0) {
-							for (uint32_t i = 0; i < 8; i++)
-								VkFFTPlanSupportAxis(FFTPlan, 1, i, inverse);
+							for (uint32_t i = 0; i < 8; i++) {
+								VkResult res = VkFFTPlanSupportAxis(FFTPlan, 1, i, inverse);
+								if (res != VK_SUCCESS) return res;
+							}
 						}
 						axis->axisBlock[0] = (configuration.size[0] / 2 > axis->groupedBatch) ? axis->groupedBatch : configuration.size[0] / 2;
 						/*if (axis->axisBlock[0] * axis->axisBlock[1] < 64)
@@ -1314,8 +1672,10 @@ typedef struct VkFFTApplication {
 
 					if (configuration.performR2C) {
 						if (axis_upload_id == 0) {
-							for (uint32_t i = 0; i < 8; i++)
-								VkFFTPlanSupportAxis(FFTPlan, 2, i, inverse);
+							for (uint32_t i = 0; i < 8; i++) {
+								VkResult res = VkFFTPlanSupportAxis(FFTPlan, 2, i, inverse);
+								if (res != VK_SUCCESS) return res;
+							}
 						}
 						axis->axisBlock[0] = (configuration.size[0] / 2 > axis->groupedBatch) ? axis->groupedBatch : configuration.size[0] / 2;
 						/*if (axis->axisBlock[0] * axis->axisBlock[1] < 64)
@@ -1338,15 +1698,15 @@ typedef struct VkFFTApplication {
 				}
 
 			}
-			VkSpecializationMapEntry specializationMapEntries[30] = { {} };
-			for (uint32_t i = 0; i < 30; i++) {
+			VkSpecializationMapEntry specializationMapEntries[40] = { {} };
+			for (uint32_t i = 0; i < 40; i++) {
 				specializationMapEntries[i].constantID = i + 1;
 				specializationMapEntries[i].size = sizeof(uint32_t);
 				specializationMapEntries[i].offset = i * sizeof(uint32_t);
 			}
 			VkSpecializationInfo specializationInfo = {};
-			specializationInfo.dataSize = 30 * sizeof(uint32_t);
-			specializationInfo.mapEntryCount = 30;
+			specializationInfo.dataSize = 40 * sizeof(uint32_t);
+			specializationInfo.mapEntryCount = 40;
 			specializationInfo.pMapEntries = specializationMapEntries;
 			axis->specializationConstants.localSize[0] = axis->axisBlock[0];
 			axis->specializationConstants.localSize[1] = axis->axisBlock[1];
@@ -1358,23 +1718,24 @@ typedef struct VkFFTApplication {
 
 
 			pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+			VkResult res = VK_SUCCESS;
 			if (configuration.performR2C) {
 				if (axis_id == 0) {
 					if (inverse) {
 						switch (configuration.registerBoost) {
 						case 1:
 						{
-							VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 						case 2:
 						{
 							switch (axis->specializationConstants.fftDim) {
 							case 8192:
-								VkFFTInitShader(23, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(23, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							default:
-								VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 							break;
@@ -1383,13 +1744,13 @@ typedef struct VkFFTApplication {
 						{
 							switch (axis->specializationConstants.fftDim) {
 							case 8192:
-								VkFFTInitShader(23, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(23, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							case 16384:
-								VkFFTInitShader(33, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(33, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							default:
-								VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(1, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 							break;
@@ -1400,17 +1761,17 @@ typedef struct VkFFTApplication {
 						switch (configuration.registerBoost) {
 						case 1:
 						{
-							VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 						case 2:
 						{
 							switch (axis->specializationConstants.fftDim) {
 							case 8192:
-								VkFFTInitShader(24, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(24, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							default:
-								VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 							break;
@@ -1419,13 +1780,13 @@ typedef struct VkFFTApplication {
 						{
 							switch (axis->specializationConstants.fftDim) {
 							case 8192:
-								VkFFTInitShader(24, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(24, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							case 16384:
-								VkFFTInitShader(34, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(34, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							default:
-								VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(3, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 							break;
@@ -1441,25 +1802,16 @@ typedef struct VkFFTApplication {
 
 							switch (configuration.matrixConvolution) {
 							case 1:
-								VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module, axis);
 								break;
-							case 2:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
-								break;
-							case 3:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+							default:
+								res = VkFFTInitShader(42, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 						
 					}
 					else {
-						VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+						res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module, axis);
 					}
 
 				}
@@ -1469,26 +1821,17 @@ typedef struct VkFFTApplication {
 						
 							switch (configuration.matrixConvolution) {
 							case 1:
-								VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module, axis);
 								break;
-							case 2:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
-								break;
-							case 3:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+							default:
+								res = VkFFTInitShader(42, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 						
 					}
 					else {
 						
-							VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module, axis);
 					}
 				}
 			}
@@ -1498,38 +1841,29 @@ typedef struct VkFFTApplication {
 						if (axis_upload_id == 0) {
 							switch (configuration.matrixConvolution) {
 							case 1:
-								VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module, axis);
 								break;
-							case 2:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
-								break;
-							case 3:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
+							default:
+								res = VkFFTInitShader(41, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 						}
 						else {
 							switch (configuration.matrixConvolution) {
 							case 1:
-								VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							case 2:
 								if (configuration.symmetricKernel)
-									VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module, axis);
 								else
-									VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							case 3:
 								if (configuration.symmetricKernel)
-									VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module, axis);
 								else
-									VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 						}
@@ -1539,22 +1873,22 @@ typedef struct VkFFTApplication {
 						case 1:
 						{
 							if (axis_upload_id == 0)
-								VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 							else
-								VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 						case 2:
 						{
 							switch (axis->specializationConstants.fftDim) {
 							case 8192:
-								VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							default:
 								if (axis_upload_id == 0)
-									VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 								else
-									VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 							break;
@@ -1563,16 +1897,16 @@ typedef struct VkFFTApplication {
 						{
 							switch (axis->specializationConstants.fftDim) {
 							case 8192:
-								VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							case 16384:
-								VkFFTInitShader(35, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(35, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							default:
 								if (axis_upload_id == 0)
-									VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 								else
-									VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+									res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 							break;
@@ -1586,25 +1920,16 @@ typedef struct VkFFTApplication {
 						
 							switch (configuration.matrixConvolution) {
 							case 1:
-								VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module, axis);
 								break;
-							case 2:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
-								break;
-							case 3:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+							default:
+								res = VkFFTInitShader(42, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 						
 					}
 					else {
-							VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module, axis);
 						
 					}
 
@@ -1615,29 +1940,21 @@ typedef struct VkFFTApplication {
 						
 							switch (configuration.matrixConvolution) {
 							case 1:
-								VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module, axis);
 								break;
-							case 2:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
-								break;
-							case 3:
-								if (configuration.symmetricKernel)
-									VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
-								else
-									VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+							default:
+								res = VkFFTInitShader(42, &pipelineShaderStageCreateInfo.module, axis);
 								break;
 							}
 						
 					}
 					else {
-						VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+						res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module, axis);
 					}
 				}
 			}
 
+			if (res != VK_SUCCESS) return res;
 			pipelineShaderStageCreateInfo.pName = "main";
 			pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
 			computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
@@ -1650,426 +1967,61 @@ typedef struct VkFFTApplication {
 		}
 
 
+		return VK_SUCCESS;
 	}
-	void VkFFTPlanSupportAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, uint32_t axis_upload_id, bool inverse) {
+	VkResult VkFFTPlanSupportAxis(VkFFTPlan* FFTPlan, uint32_t axis_id, uint32_t axis_upload_id, bool inverse) {
 		//get radix stages
 		VkFFTAxis* axis = &FFTPlan->supportAxes[axis_id - 1][axis_upload_id];
-		if (axis_id == 1) {
-			//configure radix stages
-			uint32_t logSize = log2(configuration.size[axis_id]);
-			uint32_t numPasses[8][8];//4096-8k(256KB)-16k(256KB)-32k-64k - find correct strided FFT configuration - x axis | 256-512-1024-2048(256KB)-4096(256KB)-8k(future?)-16k(future?) - find correct strided FFT configuration
-			for (uint32_t i = 0; i < 8; i++) {
-				for (uint32_t j = 0; j < 8; j++) {
-					numPasses[i][j] = 0;
-				}
-			}
-			uint32_t temp = configuration.size[axis_id];
-			uint32_t startStage = 4096;
-			uint32_t continueStage = 256;
-			uint32_t maxPassId[2] = { 0,0 };
-			uint32_t minPassId[2] = { 0,0 };
-			maxPassId[0] += log2(configuration.registerBoost);
-			uint32_t maxSingleSize = 8 * 4096 / configuration.coalescedMemory;
-			maxPassId[1] = log2(maxSingleSize / 256);
-			minPassId[1] = (maxSingleSize >= 512) ? 1 : 0;
-			//maxPassId[1] += log2(configuration.registerBoost);//in development
-			for (uint32_t i = 0; i < 8; i++) {
-				for (uint32_t j = 0; j < 8; j++) {
-					temp /= startStage;
-					numPasses[i][j]++;
-					while (temp > 1)
-					{
-						temp /= continueStage;
-						numPasses[i][j]++;
-					}
-					continueStage *= 2;
-					temp = configuration.size[axis_id];
-				}
-				continueStage = 256;
-				startStage *= 2;
-			}
-			uint32_t passId[2] = { minPassId[0], minPassId[1] };
-			for (uint32_t i = minPassId[0]; i < maxPassId[0]+1; i++) {
-				for (uint32_t j = minPassId[1]; j < maxPassId[1]+1; j++) {
-					if (numPasses[i][j] < numPasses[passId[0]][passId[1]]) {
-						passId[0] = i;
-						passId[1] = j;
-					}
-				}
-			}
-			FFTPlan->numSupportAxisUploads[axis_id - 1] = numPasses[passId[0]][passId[1]];
-			if (axis_upload_id >= numPasses[passId[0]][passId[1]])
-				return;
-			if (axis_upload_id == 0) {
-				//first pass is non-strided, special case
-				switch (configuration.radix) {
-				case 8: {
-					uint32_t logSize0Pass = (12 + passId[0] < logSize) ? 12 + passId[0] : logSize; //4096 + shift
-					if ((axis_upload_id + 1 == numPasses[passId[0]][passId[1]] - 1) && (logSize - logSize0Pass < 3))
-						logSize0Pass -= (3 - (logSize - logSize0Pass));
-					uint32_t stage8 = logSize0Pass / 3;
-					uint32_t stage4 = 0;
-					uint32_t stage2 = 0;
-					if (logSize0Pass % 3 == 2)
-						stage4 = 1;
-					if (logSize0Pass % 3 == 1)
-						stage2 = 1;
-					uint32_t totNumStages = stage8 + stage4 + stage2;
-
-					axis->specializationConstants.numStages = stage8;
-					axis->specializationConstants.fftDim = pow(8, stage8);
-					axis->specializationConstants.stageRadix[0] = 8;
-					axis->specializationConstants.stageRadix[1] = 8;
-
-					if (stage4 == 1) {
-						axis->specializationConstants.numStages++;
-						axis->specializationConstants.stageRadix[1] = 4;
-						axis->specializationConstants.fftDim *= 4;
-					}
-					if (stage2 == 1) {
-						axis->specializationConstants.numStages++;
-						axis->specializationConstants.stageRadix[1] = 2;
-						axis->specializationConstants.fftDim *= 2;
-					}
-					axis->specializationConstants.stageStartSize = 1;
-					if (configuration.performR2C)
-						axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-					else
-						axis->specializationConstants.fft_dim_x = configuration.size[0];
+		//configure radix stages
+		VkFFTStagePlan* stagePlan = &FFTPlan->supportStagePlan[axis_id - 1];
+		if (axis_upload_id == 0) {
+			//first pass of y support axis is non-strided, z support axis merges groupedBatch sequences along y in one workgroup
+			VkFFTPlanStages(stagePlan, log2(configuration.size[axis_id]), (axis_id > 1), configuration.size[1], configuration.groupedBatch[axis_id]);
+		}
+		FFTPlan->numSupportAxisUploads[axis_id - 1] = stagePlan->numPasses;
+		if (stagePlan->numPasses == 0)
+			return VK_ERROR_INITIALIZATION_FAILED;
+		if ((stagePlan->numPasses > 1) && (configuration.performOutputPruning[axis_id])) {
+			printf("Output pruning of axis %d is not supported, the axis is done in %d uploads and its result is stored in four step order\n", axis_id, stagePlan->numPasses);
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		if (axis_upload_id >= stagePlan->numPasses)
+			return VK_SUCCESS;
+		axis->specializationConstants.numStages = stagePlan->numStages[axis_upload_id];
+		axis->specializationConstants.fftDim = 1 << stagePlan->logSize[axis_upload_id];
+		axis->specializationConstants.stageRadix[0] = stagePlan->stageRadix[axis_upload_id][0];
+		axis->specializationConstants.stageRadix[1] = stagePlan->stageRadix[axis_upload_id][1];
+		axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.fftDim;
+		axis->specializationConstants.fft_dim_x = configuration.size[1];
+		axis->specializationConstants.passID = FFTPlan->numSupportAxisUploads[axis_id - 1] - 1 - axis_upload_id;
+		axis->specializationConstants.fft_dim_full = configuration.size[axis_id];
+		axis->groupedBatch = stagePlan->groupedBatch[axis_upload_id];
+		//configure strides
+		//perform r2c
+		axis->specializationConstants.inputStride[0] = 1;
+		axis->specializationConstants.inputStride[3] = (configuration.size[0] / 2 + 1) * configuration.size[1] * configuration.size[2];
 
-					break;
-				}
-				case 4: {
-					uint32_t stage4 = logSize / 2;
-					uint32_t stage2 = 0;
-					if (logSize % 2 == 1)
-						stage2 = 1;
-					axis->specializationConstants.numStages = stage4 + stage2;
+		if (axis_id == 1)
+		{
 
+			//don't transpose 0-1
+			axis->specializationConstants.inputStride[1] = configuration.size[1];
+			axis->specializationConstants.inputStride[2] = (configuration.size[0] / 2 + 1) * configuration.size[1];
+			axis->specializationConstants.inputStride[3] = (configuration.size[0] / 2 + 1) * configuration.size[1] * configuration.size[2];
+		}
+		if (axis_id == 2)
+		{
 
-					axis->specializationConstants.stageRadix[0] = 4;
-					axis->specializationConstants.stageRadix[1] = 4;
-					if (logSize % 2 == 1)
-						axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				case 2: {
-					uint32_t stage2 = logSize;
+			//don't transpose 0-1, don't transpose 1-2
+			axis->specializationConstants.inputStride[1] = (configuration.size[0] / 2 + 1) * configuration.size[1];
+			axis->specializationConstants.inputStride[2] = configuration.size[1];
 
-					axis->specializationConstants.numStages = stage2;
+		}
 
-
-					axis->specializationConstants.stageRadix[0] = 2;
-					axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				}
-			}
-			else {
-				//passes after first are done similar to strided passes in y and z
-				uint32_t logSizeLaterPass = (logSize - 12 - passId[0] < 3) ? 3 : logSize - 12 - passId[0]; //4096 + shift
-				switch (configuration.radix) {
-				case 8: {
-					uint32_t stage8 = logSizeLaterPass / 3;
-					uint32_t stage4 = 0;
-					uint32_t stage2 = 0;
-					if (logSizeLaterPass % 3 == 2)
-						stage4 = 1;
-					if (logSizeLaterPass % 3 == 1)
-						stage2 = 1;
-					uint32_t totNumStages = stage8 + stage4 + stage2;
-					uint32_t locNumStages = 0;
-					if (passId[1] == minPassId[1]) {
-						locNumStages = stage8 / (numPasses[passId[0]][passId[1]] - 1);
-						if (axis_upload_id < stage8 % (numPasses[passId[0]][passId[1]] - 1))
-							locNumStages++;
-						axis->specializationConstants.numStages = locNumStages;
-						axis->specializationConstants.fftDim = pow(8, locNumStages);
-						axis->specializationConstants.stageRadix[0] = 8;
-						axis->specializationConstants.stageRadix[1] = 8;
-
-						if (axis_upload_id == (numPasses[passId[0]][passId[1]] - 1)) {
-							if (stage4 == 1) {
-								axis->specializationConstants.numStages++;
-								axis->specializationConstants.stageRadix[1] = 4;
-								axis->specializationConstants.fftDim *= 4;
-							}
-							if (stage2 == 1) {
-								axis->specializationConstants.numStages++;
-								axis->specializationConstants.stageRadix[1] = 2;
-								axis->specializationConstants.fftDim *= 2;
-							}
-						}
-						axis->specializationConstants.stageStartSize = FFTPlan->supportAxes[axis_id-1][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.fftDim;
-						axis->specializationConstants.fft_dim_x = configuration.size[1];
-					}
-					else {
-						if (axis_upload_id < numPasses[passId[0]][passId[1]] - 1) {
-							uint32_t locLogSize = 8 + passId[1];
-							if ((axis_upload_id + 1 == numPasses[passId[0]][passId[1]] - 1) && (logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2) < 3))
-								locLogSize -= (3 - (logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2)));
-							uint32_t locStage8 = locLogSize / 3;
-							uint32_t locStage4 = 0;
-							uint32_t locStage2 = 0;
-							if (locLogSize % 3 == 2)
-								locStage4 = 1;
-							if (locLogSize % 3 == 1)
-								locStage2 = 1;
-							axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-							axis->specializationConstants.fftDim = pow(2, locLogSize);
-							axis->specializationConstants.stageRadix[0] = 8;
-							axis->specializationConstants.stageRadix[1] = 8;
-
-							if (locStage4 == 1) {
-								axis->specializationConstants.stageRadix[1] = 4;
-							}
-							if (locStage2 == 1) {
-								axis->specializationConstants.stageRadix[1] = 2;
-							}
-							axis->specializationConstants.stageStartSize = FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.fftDim;
-							if (configuration.performR2C)
-								axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-							else
-								axis->specializationConstants.fft_dim_x = configuration.size[0];
-						}
-						else {
-							uint32_t locLogSize = (logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2) < 3) ? 3 : logSizeLaterPass - (8 + passId[1]) * (numPasses[passId[0]][passId[1]] - 2);
-							uint32_t locStage8 = locLogSize / 3;
-							uint32_t locStage4 = 0;
-							uint32_t locStage2 = 0;
-							if (locLogSize % 3 == 2)
-								locStage4 = 1;
-							if (locLogSize % 3 == 1)
-								locStage2 = 1;
-							axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-							axis->specializationConstants.fftDim = pow(2, locLogSize);
-							axis->specializationConstants.stageRadix[0] = 8;
-							axis->specializationConstants.stageRadix[1] = 8;
-
-							if (locStage4 == 1) {
-								axis->specializationConstants.stageRadix[1] = 4;
-							}
-							if (locStage2 == 1) {
-								axis->specializationConstants.stageRadix[1] = 2;
-							}
-							axis->specializationConstants.stageStartSize = FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.fftDim;
-							if (configuration.performR2C)
-								axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-							else
-								axis->specializationConstants.fft_dim_x = configuration.size[0];
-						}
-					}
-
-
-					break;
-				}
-				case 4: {
-					uint32_t stage4 = logSize / 2;
-					uint32_t stage2 = 0;
-					if (logSize % 2 == 1)
-						stage2 = 1;
-					axis->specializationConstants.numStages = stage4 + stage2;
-
-
-					axis->specializationConstants.stageRadix[0] = 4;
-					axis->specializationConstants.stageRadix[1] = 4;
-					if (logSize % 2 == 1)
-						axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				case 2: {
-					uint32_t stage2 = logSize;
-
-					axis->specializationConstants.numStages = stage2;
-
-
-					axis->specializationConstants.stageRadix[0] = 2;
-					axis->specializationConstants.stageRadix[1] = 2;
-					break;
-				}
-				}
-			}
-		}
-		else {
-			//configure radix stages
-			uint32_t logSize = log2(configuration.size[axis_id]);
-			uint32_t numPasses[8] = { 0,0,0,0,0,0,0,0 };//256-512-1024-2048(256KB)-4096(256KB)-8k(future?)-16k(future?) - find correct strided FFT configuration
-			uint32_t temp = configuration.size[axis_id];
-			uint32_t startStage = 256;
-			uint32_t maxSingleSize = 8 * 4096 / configuration.coalescedMemory;
-			uint32_t maxPassId = log2(maxSingleSize / 256);
-			uint32_t minPassId = (maxSingleSize >= 512) ? 1 : 0;
-			//maxPassId += log2(configuration.registerBoost); //in development
-			for (uint32_t i = 0; i < 8; i++) {
-				while (temp > 1)
-				{
-					temp /= startStage;
-					numPasses[i]++;
-				}
-				temp = configuration.size[axis_id];
-				startStage *= 2;
-			}
-			uint32_t passId = minPassId;
-			for (uint32_t i = minPassId; i < maxPassId+1; i++) {
-				if (numPasses[i] < numPasses[passId]) {
-					passId = i;
-				}
-			}
-			FFTPlan->numSupportAxisUploads[axis_id-1] = numPasses[passId];
-			if (axis_upload_id >= numPasses[passId])
-				return;
-			switch (configuration.radix) {
-			case 8: {
-				uint32_t stage8 = logSize / 3;
-				uint32_t stage4 = 0;
-				uint32_t stage2 = 0;
-				if (logSize % 3 == 2)
-					stage4 = 1;
-				if (logSize % 3 == 1)
-					stage2 = 1;
-				uint32_t totNumStages = stage8 + stage4 + stage2;
-				uint32_t locNumStages = 0;
-				if (passId == minPassId) {
-					locNumStages = stage8 / numPasses[passId];
-					if (axis_upload_id < stage8 % numPasses[passId])
-						locNumStages++;
-					axis->specializationConstants.numStages = locNumStages;
-					axis->specializationConstants.fftDim = pow(8, locNumStages);
-					axis->specializationConstants.stageRadix[0] = 8;
-					axis->specializationConstants.stageRadix[1] = 8;
-
-					if (axis_upload_id == numPasses[passId] - 1) {
-						if (stage4 == 1) {
-							axis->specializationConstants.numStages++;
-							axis->specializationConstants.stageRadix[1] = 4;
-							axis->specializationConstants.fftDim *= 4;
-						}
-						if (stage2 == 1) {
-							axis->specializationConstants.numStages++;
-							axis->specializationConstants.stageRadix[1] = 2;
-							axis->specializationConstants.fftDim *= 2;
-						}
-					}
-					axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->supportAxes[axis_id - 1][axis_upload_id - 1].specializationConstants.fftDim;
-					axis->specializationConstants.fft_dim_x = configuration.size[1];
-				}
-				else {
-					if (axis_upload_id < numPasses[passId] - 1) {
-
-						uint32_t locLogSize = 8 + passId;
-						if ((axis_upload_id + 1 == numPasses[passId] - 1) && (logSize - (8 + passId) * (numPasses[passId] - 1) < 3))
-							locLogSize -= (3 - (logSize - (8 + passId) * (numPasses[passId] - 1)));
-						uint32_t locStage8 = locLogSize / 3;
-						uint32_t locStage4 = 0;
-						uint32_t locStage2 = 0;
-						if (locLogSize % 3 == 2)
-							locStage4 = 1;
-						if (locLogSize % 3 == 1)
-							locStage2 = 1;
-						axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-						axis->specializationConstants.fftDim = pow(2, locLogSize);
-						axis->specializationConstants.stageRadix[0] = 8;
-						axis->specializationConstants.stageRadix[1] = 8;
-
-						if (locStage4 == 1) {
-							axis->specializationConstants.stageRadix[1] = 4;
-						}
-						if (locStage2 == 1) {
-							axis->specializationConstants.stageRadix[1] = 2;
-						}
-						axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-						if (configuration.performR2C)
-							axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-						else
-							axis->specializationConstants.fft_dim_x = configuration.size[0];
-					}
-					else {
-						uint32_t locLogSize = (logSize - (8 + passId) * (numPasses[passId] - 1) < 3) ? 3 : logSize - (8 + passId) * (numPasses[passId] - 1);
-						uint32_t locStage8 = locLogSize / 3;
-						uint32_t locStage4 = 0;
-						uint32_t locStage2 = 0;
-						if (locLogSize % 3 == 2)
-							locStage4 = 1;
-						if (locLogSize % 3 == 1)
-							locStage2 = 1;
-						axis->specializationConstants.numStages = locStage8 + locStage4 + locStage2;
-						axis->specializationConstants.fftDim = pow(2, locLogSize);
-						axis->specializationConstants.stageRadix[0] = 8;
-						axis->specializationConstants.stageRadix[1] = 8;
-
-						if (locStage4 == 1) {
-							axis->specializationConstants.stageRadix[1] = 4;
-						}
-						if (locStage2 == 1) {
-							axis->specializationConstants.stageRadix[1] = 2;
-						}
-						axis->specializationConstants.stageStartSize = (axis_upload_id == 0) ? 1 : FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.stageStartSize * FFTPlan->axes[axis_id][axis_upload_id - 1].specializationConstants.fftDim;
-						if (configuration.performR2C)
-							axis->specializationConstants.fft_dim_x = configuration.size[0] / 2;
-						else
-							axis->specializationConstants.fft_dim_x = configuration.size[0];
-					}
-				}
-
-
-				break;
-			}
-			case 4: {
-				uint32_t stage4 = logSize / 2;
-				uint32_t stage2 = 0;
-				if (logSize % 2 == 1)
-					stage2 = 1;
-				axis->specializationConstants.numStages = stage4 + stage2;
-
-
-				axis->specializationConstants.stageRadix[0] = 4;
-				axis->specializationConstants.stageRadix[1] = 4;
-				if (logSize % 2 == 1)
-					axis->specializationConstants.stageRadix[1] = 2;
-				break;
-			}
-			case 2: {
-				uint32_t stage2 = logSize;
-
-				axis->specializationConstants.numStages = stage2;
-
-
-				axis->specializationConstants.stageRadix[0] = 2;
-				axis->specializationConstants.stageRadix[1] = 2;
-				break;
-			}
-			}
-		}
-		axis->specializationConstants.passID = FFTPlan->numSupportAxisUploads[axis_id - 1] - 1 - axis_upload_id;
-		axis->specializationConstants.fft_dim_full = configuration.size[axis_id];
-		axis->groupedBatch = (4096 / axis->specializationConstants.fftDim >= configuration.coalescedMemory / 8) ? 4096 / axis->specializationConstants.fftDim : configuration.coalescedMemory / 8;
-		//axis->groupedBatch = ((axis_upload_id>0)&&(axis->groupedBatch > axis->specializationConstants.stageStartSize)) ? axis->specializationConstants.stageStartSize : axis->groupedBatch;
-		//configure strides
-		//perform r2c
-		axis->specializationConstants.inputStride[0] = 1;
-		axis->specializationConstants.inputStride[3] = (configuration.size[0] / 2 + 1) * configuration.size[1] * configuration.size[2];
-
-		if (axis_id == 1)
-		{
-
-			//don't transpose 0-1
-			axis->specializationConstants.inputStride[1] = configuration.size[1];
-			axis->specializationConstants.inputStride[2] = (configuration.size[0] / 2 + 1) * configuration.size[1];
-			axis->specializationConstants.inputStride[3] = (configuration.size[0] / 2 + 1) * configuration.size[1] * configuration.size[2];
-		}
-		if (axis_id == 2)
-		{
-
-			//don't transpose 0-1, don't transpose 1-2
-			axis->specializationConstants.inputStride[1] = (configuration.size[0] / 2 + 1) * configuration.size[1];
-			axis->specializationConstants.inputStride[2] = configuration.size[1];
-
-		}
-
-		axis->specializationConstants.outputStride[0] = axis->specializationConstants.inputStride[0];
-		axis->specializationConstants.outputStride[1] = axis->specializationConstants.inputStride[1];
-		axis->specializationConstants.outputStride[2] = axis->specializationConstants.inputStride[2];
-		axis->specializationConstants.outputStride[3] = axis->specializationConstants.inputStride[3];
+		axis->specializationConstants.outputStride[0] = axis->specializationConstants.inputStride[0];
+		axis->specializationConstants.outputStride[1] = axis->specializationConstants.inputStride[1];
+		axis->specializationConstants.outputStride[2] = axis->specializationConstants.inputStride[2];
+		axis->specializationConstants.outputStride[3] = axis->specializationConstants.inputStride[3];
 
 		axis->specializationConstants.inputStride[4] = axis->specializationConstants.inputStride[3] * configuration.coordinateFeatures;
 		axis->specializationConstants.outputStride[4] = axis->specializationConstants.outputStride[3] * configuration.coordinateFeatures;
@@ -2077,12 +2029,40 @@ typedef struct VkFFTApplication {
 		axis->specializationConstants.inverse = inverse;
 		axis->specializationConstants.zeropad[0] = configuration.performZeropadding[axis_id];
 		axis->specializationConstants.zeropad[1] = false;
+		axis->specializationConstants.zeropadInputRange[0] = configuration.zeropadInputRange[axis_id][0];
+		axis->specializationConstants.zeropadInputRange[1] = configuration.zeropadInputRange[axis_id][1];
+		axis->specializationConstants.zeropadOutputRange[0] = configuration.zeropadOutputRange[axis_id][0];
+		axis->specializationConstants.zeropadOutputRange[1] = configuration.zeropadOutputRange[axis_id][1];
+		axis->specializationConstants.nyquistOffset = configuration.size[1] / 2;
+		axis->specializationConstants.pruneOutput = false;
+		axis->specializationConstants.matrixConvolution = configuration.matrixConvolution;
+		axis->specializationConstants.symmetricKernel = configuration.symmetricKernel;
+		axis->specializationConstants.conjugateKernel = configuration.performCorrelation;
+		if ((axis_upload_id == 0) && (configuration.performOutputPruning[axis_id])) {
+			axis->specializationConstants.pruneOutput = true;
+			if (!((inverse) && (configuration.performZeropadding[axis_id]))) {
+				axis->specializationConstants.zeropadOutputRange[0] = 0;
+				axis->specializationConstants.zeropadOutputRange[1] = configuration.size[axis_id];
+			}
+			if (axis->specializationConstants.zeropadOutputRange[0] < configuration.outputPruningRange[axis_id][0]) axis->specializationConstants.zeropadOutputRange[0] = configuration.outputPruningRange[axis_id][0];
+			if (axis->specializationConstants.zeropadOutputRange[1] > configuration.outputPruningRange[axis_id][1]) axis->specializationConstants.zeropadOutputRange[1] = configuration.outputPruningRange[axis_id][1];
+			if (axis->specializationConstants.zeropadOutputRange[0] > axis->specializationConstants.zeropadOutputRange[1]) axis->specializationConstants.zeropadOutputRange[0] = axis->specializationConstants.zeropadOutputRange[1];
+		}
 		axis->specializationConstants.ratio[0] = configuration.size[axis_id - 1] / configuration.size[axis_id];
 		axis->specializationConstants.ratio[1] = configuration.size[axis_id - 1] / configuration.size[axis_id];
 		axis->specializationConstants.ratioDirection[0] = false;
 		axis->specializationConstants.ratioDirection[1] = true;
 		axis->specializationConstants.inputOffset = configuration.size[0] * configuration.size[1] / 2;
 		axis->specializationConstants.outputOffset = configuration.size[0] * configuration.size[1] / 2;
+		axis->specializationConstants.rowPairShift = 0;
+		axis->dispatchShift[1] = 0;
+		axis->dispatchShift[2] = 0;
+		if ((axis_id == 1) && (configuration.FFTdim > 2) && (configuration.performZeropadding[2])) {
+			//zeropadded z range is dispatched from its start, as in the main y axis
+			axis->dispatchShift[2] = (inverse) ? configuration.zeropadOutputRange[2][0] : configuration.zeropadInputRange[2][0];
+			axis->specializationConstants.inputOffset += axis->dispatchShift[2] * axis->specializationConstants.inputStride[2];
+			axis->specializationConstants.outputOffset += axis->dispatchShift[2] * axis->specializationConstants.outputStride[2];
+		}
 
 		VkDescriptorPoolSize descriptorPoolSize = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
 		descriptorPoolSize.descriptorCount = 2;
@@ -2169,6 +2149,7 @@ typedef struct VkFFTApplication {
 				descriptorBufferInfo.offset = 0;
 				descriptorBufferInfo.range = configuration.kernelSize[0];
 			}
+			if (i < 2) axis->passBuffers[i] = descriptorBufferInfo.buffer;
 			VkWriteDescriptorSet writeDescriptorSet = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
 			writeDescriptorSet.dstSet = axis->descriptorSet;
 			writeDescriptorSet.dstBinding = i;
@@ -2197,7 +2178,7 @@ typedef struct VkFFTApplication {
 			if (axis_id == 1) {
 				if (axis_upload_id == 0) {
 					axis->axisBlock[0] = (axis->specializationConstants.fftDim / 8 > 1) ? axis->specializationConstants.fftDim / 8 : 1;
-					if (axis->axisBlock[0] > 512) axis->axisBlock[0] = 512;
+					if ((configuration.registerBoost > 1) && (axis->axisBlock[0] > 512)) axis->axisBlock[0] = 512; //register-boosted 8192 and 16384 shaders use 512 threads
 					axis->axisBlock[1] = 1;
 					axis->axisBlock[2] = 1;
 					axis->axisBlock[3] = axis->specializationConstants.fftDim;
@@ -2224,15 +2205,15 @@ typedef struct VkFFTApplication {
 				axis->axisBlock[3] = axis->specializationConstants.fftDim;
 			}
 			
-			VkSpecializationMapEntry specializationMapEntries[30] = { {} };
-			for (uint32_t i = 0; i < 30; i++) {
+			VkSpecializationMapEntry specializationMapEntries[40] = { {} };
+			for (uint32_t i = 0; i < 40; i++) {
 				specializationMapEntries[i].constantID = i + 1;
 				specializationMapEntries[i].size = sizeof(uint32_t);
 				specializationMapEntries[i].offset = i * sizeof(uint32_t);
 			}
 			VkSpecializationInfo specializationInfo = {};
-			specializationInfo.dataSize = 30 * sizeof(uint32_t);
-			specializationInfo.mapEntryCount = 30;
+			specializationInfo.dataSize = 40 * sizeof(uint32_t);
+			specializationInfo.mapEntryCount = 40;
 			specializationInfo.pMapEntries = specializationMapEntries;
 			axis->specializationConstants.localSize[0] = axis->axisBlock[0];
 			axis->specializationConstants.localSize[1] = axis->axisBlock[1];
@@ -2244,6 +2225,7 @@ typedef struct VkFFTApplication {
 
 
 			pipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+			VkResult res = VK_SUCCESS;
 
 
 			if (axis_id == 1) {
@@ -2252,38 +2234,29 @@ typedef struct VkFFTApplication {
 					if (axis_upload_id == 0) {
 						switch (configuration.matrixConvolution) {
 						case 1:
-							VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module);
-							break;
-						case 2:
-							if (configuration.symmetricKernel)
-								VkFFTInitShader(12, &pipelineShaderStageCreateInfo.module);
-							else
-								VkFFTInitShader(15, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(9, &pipelineShaderStageCreateInfo.module, axis);
 							break;
-						case 3:
-							if (configuration.symmetricKernel)
-								VkFFTInitShader(18, &pipelineShaderStageCreateInfo.module);
-							else
-								VkFFTInitShader(21, &pipelineShaderStageCreateInfo.module);
+						default:
+							res = VkFFTInitShader(41, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 					}
 					else {
 						switch (configuration.matrixConvolution) {
 						case 1:
-							VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(10, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						case 2:
 							if (configuration.symmetricKernel)
-								VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(13, &pipelineShaderStageCreateInfo.module, axis);
 							else
-								VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(16, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						case 3:
 							if (configuration.symmetricKernel)
-								VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(19, &pipelineShaderStageCreateInfo.module, axis);
 							else
-								VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(22, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 					}
@@ -2291,29 +2264,29 @@ typedef struct VkFFTApplication {
 				}
 				else {
 					/*if (axis_upload_id == 0)
-						VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+						res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 					else
-						VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);*/
+						VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);*/
 					switch (configuration.registerBoost) {
 					case 1:
 					{
 						if (axis_upload_id == 0)
-							VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 						else
-							VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);
 						break;
 					}
 					case 2:
 					{
 						switch (axis->specializationConstants.fftDim) {
 						case 8192:
-							VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						default:
 							if (axis_upload_id == 0)
-								VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 							else
-								VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 						break;
@@ -2322,16 +2295,16 @@ typedef struct VkFFTApplication {
 					{
 						switch (axis->specializationConstants.fftDim){
 						case 8192:
-							VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(25, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						case 16384:
-							VkFFTInitShader(35, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(35, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						default:
 							if (axis_upload_id == 0)
-								VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(0, &pipelineShaderStageCreateInfo.module, axis);
 							else
-								VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module);
+								res = VkFFTInitShader(2, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 						break;
@@ -2345,28 +2318,20 @@ typedef struct VkFFTApplication {
 				if ((configuration.FFTdim == 3) && (configuration.performConvolution) && (axis_upload_id == 0)) {
 						switch (configuration.matrixConvolution) {
 						case 1:
-							VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module);
+							res = VkFFTInitShader(8, &pipelineShaderStageCreateInfo.module, axis);
 							break;
-						case 2:
-							if (configuration.symmetricKernel)
-								VkFFTInitShader(11, &pipelineShaderStageCreateInfo.module);
-							else
-								VkFFTInitShader(14, &pipelineShaderStageCreateInfo.module);
-							break;
-						case 3:
-							if (configuration.symmetricKernel)
-								VkFFTInitShader(17, &pipelineShaderStageCreateInfo.module);
-							else
-								VkFFTInitShader(20, &pipelineShaderStageCreateInfo.module);
+						default:
+							res = VkFFTInitShader(42, &pipelineShaderStageCreateInfo.module, axis);
 							break;
 						}
 					
 				}
 				else {
-					VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module);
+					res = VkFFTInitShader(7, &pipelineShaderStageCreateInfo.module, axis);
 				}
 			}
 
+			if (res != VK_SUCCESS) return res;
 			pipelineShaderStageCreateInfo.pName = "main";
 			pipelineShaderStageCreateInfo.pSpecializationInfo = &specializationInfo;
 			computePipelineCreateInfo.stage = pipelineShaderStageCreateInfo;
@@ -2379,6 +2344,7 @@ typedef struct VkFFTApplication {
 		}
 
 
+		return VK_SUCCESS;
 	}
 	void VkFFTPlanTranspose(VkFFTPlan* FFTPlan, uint32_t axis_id, bool inverse) {
 		if (axis_id == 0) {
@@ -2577,72 +2543,1205 @@ typedef struct VkFFTApplication {
 
 
 	}
-	void initializeVulkanFFT(VkFFTConfiguration inputLaunchConfiguration) {
+	void VkFFTDetectDeviceLimits() {
+		//shared memory budget and workgroup shape come from the device limits, coalescing width, subgroup size and register file size from the vendor
+		deviceLimits = {};
+		VkPhysicalDeviceProperties properties;
+		VkPhysicalDeviceProperties* deviceProperties = configuration.physicalDeviceProperties;
+		if ((deviceProperties == NULL) && (configuration.physicalDevice != NULL)) {
+			vkGetPhysicalDeviceProperties(configuration.physicalDevice[0], &properties);
+			deviceProperties = &properties;
+		}
+		if (deviceProperties != NULL) {
+			deviceLimits.isDetected = true;
+			deviceLimits.vendorID = deviceProperties->vendorID;
+			deviceLimits.deviceID = deviceProperties->deviceID;
+			memcpy(deviceLimits.pipelineCacheUUID, deviceProperties->pipelineCacheUUID, VK_UUID_SIZE);
+			deviceLimits.timestampPeriod = deviceProperties->limits.timestampPeriod;
+			deviceLimits.sharedMemorySize = deviceProperties->limits.maxComputeSharedMemorySize;
+			deviceLimits.maxWorkGroupInvocations = deviceProperties->limits.maxComputeWorkGroupInvocations;
+			for (uint32_t i = 0; i < 3; i++)
+				deviceLimits.maxWorkGroupSize[i] = deviceProperties->limits.maxComputeWorkGroupSize[i];
+			switch (deviceProperties->vendorID) {
+			case 0x10DE://Nvidia - 256KB register file per SM
+				deviceLimits.subgroupSize = 32;
+				deviceLimits.registerBoost = 4;
+				deviceLimits.coalescedMemory = 32;
+				break;
+			case 0x1002://AMD
+				deviceLimits.subgroupSize = 64;
+				deviceLimits.registerBoost = 1;
+				deviceLimits.coalescedMemory = 64;
+				break;
+			case 0x8086://Intel
+				deviceLimits.subgroupSize = 16;
+				deviceLimits.registerBoost = 1;
+				deviceLimits.coalescedMemory = 64;
+				break;
+			}
+		}
+		if (configuration.registerBoost == 0) configuration.registerBoost = deviceLimits.registerBoost;
+		if (configuration.coalescedMemory == 0) configuration.coalescedMemory = deviceLimits.coalescedMemory;
+	}
+	void VkFFTGetWisdomKey(char* key) {
+		//wisdom version + device UUID + problem geometry + everything that selects different shaders or dispatches. pipelineCacheUUID is the Vulkan 1.0 device and driver identifier, so driver updates retune
+		char uuid[2 * VK_UUID_SIZE + 1] = "";
+		for (uint32_t i = 0; i < VK_UUID_SIZE; i++)
+			sprintf(uuid + 2 * i, "%02x", deviceLimits.pipelineCacheUUID[i]);
+		int length = sprintf(key, "v%d %s %x %x %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d", VKFFT_WISDOM_VERSION, uuid, deviceLimits.vendorID, deviceLimits.deviceID, configuration.size[0], configuration.size[1], configuration.size[2], configuration.FFTdim, configuration.performR2C, configuration.inverse, configuration.performConvolution, configuration.coordinateFeatures, configuration.matrixConvolution, configuration.numberBatches, configuration.numberKernels, configuration.symmetricKernel, configuration.performCorrelation, configuration.isInputFormatted, configuration.isOutputFormatted);
+		for (uint32_t i = 0; i < 3; i++) {
+			//ranges are already resolved by initializeVulkanFFT, so default and explicit ranges of the same window share the entry
+			length += sprintf(key + length, " z%d %d-%d %d-%d p%d %d-%d", configuration.performZeropadding[i], configuration.zeropadInputRange[i][0], configuration.zeropadInputRange[i][1], configuration.zeropadOutputRange[i][0], configuration.zeropadOutputRange[i][1], configuration.performOutputPruning[i], configuration.outputPruningRange[i][0], configuration.outputPruningRange[i][1]);
+		}
+	}
+	bool VkFFTLoadWisdom(const char* key) {
+		//wisdom file line: key : registerBoost coalescedMemory radix groupedBatch[0] groupedBatch[1] groupedBatch[2]
+		FILE* fp = fopen(configuration.wisdomPath, "r");
+		if (fp == NULL) return false;
+		char line[1024];
+		bool found = false;
+		while ((!found) && (fgets(line, 1024, fp) != NULL)) {
+			char* separator = strstr(line, " : ");
+			if ((separator == NULL) || (separator - line != (long)strlen(key)) || (strncmp(line, key, strlen(key)) != 0)) continue;
+			uint32_t tuned[6];
+			if (sscanf(separator + 3, "%u %u %u %u %u %u", &tuned[0], &tuned[1], &tuned[2], &tuned[3], &tuned[4], &tuned[5]) != 6) continue;
+			//edited or corrupted entries are skipped - the planner only supports these values
+			if ((tuned[0] != 1) && (tuned[0] != 2) && (tuned[0] != 4)) continue;
+			if (tuned[1] == 0) continue;
+			if ((tuned[2] != 2) && (tuned[2] != 4) && (tuned[2] != 8)) continue;
+			configuration.registerBoost = tuned[0];
+			configuration.coalescedMemory = tuned[1];
+			configuration.radix = tuned[2];
+			for (uint32_t i = 0; i < 3; i++)
+				configuration.groupedBatch[i] = tuned[3 + i];
+			found = true;
+		}
+		fclose(fp);
+		return found;
+	}
+	float VkFFTMeasureConfiguration(VkFFTConfiguration tuneConfiguration, VkQueryPool queryPool) {
+		//time of one VkFFTAppend in ms, averaged over 10 runs after a warmup run
+		configuration = tuneConfiguration;
+		configuration.timestampQueryPool = NULL;
+		if (VkFFTPlanApplication() != VK_SUCCESS) {
+			//candidate can't be planned - it is never picked
+			deleteVulkanFFT();
+			localFFTPlan = {};
+			localFFTPlan_inverse_convolution = {};
+			return 1e30f;
+		}
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = configuration.commandPool[0];
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+		VkCommandBuffer commandBuffer = {};
+		vkAllocateCommandBuffers(configuration.device[0], &commandBufferAllocateInfo, &commandBuffer);
+		VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+		vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+		VkFFTAppend(commandBuffer);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+		for (uint32_t i = 0; i < 10; i++)
+			VkFFTAppend(commandBuffer);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+		vkEndCommandBuffer(commandBuffer);
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		vkQueueSubmit(configuration.queue[0], 1, &submitInfo, configuration.fence[0]);
+		vkWaitForFences(configuration.device[0], 1, configuration.fence, VK_TRUE, 100000000000);
+		vkResetFences(configuration.device[0], 1, configuration.fence);
+		vkFreeCommandBuffers(configuration.device[0], configuration.commandPool[0], 1, &commandBuffer);
+		uint64_t timestamps[2] = { 0,0 };
+		vkGetQueryPoolResults(configuration.device[0], queryPool, 0, 2, sizeof(uint64_t) * 2, timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+		deleteVulkanFFT();
+		localFFTPlan = {};
+		localFFTPlan_inverse_convolution = {};
+		return (timestamps[1] - timestamps[0]) * deviceLimits.timestampPeriod * 0.000001f / 10;
+	}
+	void VkFFTAutotune() {
+		//use wisdom file entry if it exists, otherwise greedily tune one parameter at a time, starting from the user configuration
+		if (!deviceLimits.isDetected) {
+			printf("Autotune and wisdom file need physicalDevice or physicalDeviceProperties, using the configuration as is\n");
+			return;
+		}
+		char key[512];
+		VkFFTGetWisdomKey(key);
+		if ((configuration.wisdomPath[0] != 0) && (VkFFTLoadWisdom(key))) return;
+		if (!configuration.autotune) return;
+		if ((configuration.queue == NULL) || (configuration.commandPool == NULL) || (configuration.fence == NULL)) {
+			printf("Autotune needs queue, commandPool and fence, using the configuration as is\n");
+			return;
+		}
+		VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = 2;
+		VkQueryPool queryPool = {};
+		vkCreateQueryPool(configuration.device[0], &queryPoolCreateInfo, NULL, &queryPool);
+
+		const uint32_t registerBoostCandidates[3] = { 1, 2, 4 };
+		const uint32_t coalescedMemoryCandidates[3] = { 32, 64, 128 };
+		const uint32_t radixCandidates[3] = { 8, 4, 2 };
+		const uint32_t groupedBatchCandidates[5] = { 0, 32, 16, 8, 4 };
+		VkFFTConfiguration bestConfiguration = configuration;
+		float bestTime = VkFFTMeasureConfiguration(bestConfiguration, queryPool);
+		for (uint32_t p = 0; p < 3 + configuration.FFTdim; p++) {
+			uint32_t numCandidates = (p < 3) ? 3 : 5;
+			for (uint32_t i = 0; i < numCandidates; i++) {
+				VkFFTConfiguration candidate = bestConfiguration;
+				uint32_t* parameter = (p == 0) ? &candidate.registerBoost : (p == 1) ? &candidate.coalescedMemory : (p == 2) ? &candidate.radix : &candidate.groupedBatch[p - 3];
+				uint32_t value = (p == 0) ? registerBoostCandidates[i] : (p == 1) ? coalescedMemoryCandidates[i] : (p == 2) ? radixCandidates[i] : groupedBatchCandidates[i];
+				if (*parameter == value) continue;
+				//register-boosted shaders only change x axis sequences of 8192 and more
+				if ((p == 0) && (candidate.size[0] < 8192)) continue;
+				*parameter = value;
+				float time = VkFFTMeasureConfiguration(candidate, queryPool);
+				if (time < bestTime) {
+					bestTime = time;
+					bestConfiguration = candidate;
+				}
+			}
+		}
+		vkDestroyQueryPool(configuration.device[0], queryPool, NULL);
+		configuration = bestConfiguration;
+		printf("Autotune: registerBoost %d coalescedMemory %d radix %d groupedBatch %d %d %d - %0.3f ms\n", configuration.registerBoost, configuration.coalescedMemory, configuration.radix, configuration.groupedBatch[0], configuration.groupedBatch[1], configuration.groupedBatch[2], bestTime);
+		if (configuration.wisdomPath[0] != 0) {
+			FILE* fp = fopen(configuration.wisdomPath, "a");
+			if (fp == NULL) {
+				printf("Could not open wisdom file: %s\n", configuration.wisdomPath);
+				return;
+			}
+			fprintf(fp, "%s : %d %d %d %d %d %d\n", key, configuration.registerBoost, configuration.coalescedMemory, configuration.radix, configuration.groupedBatch[0], configuration.groupedBatch[1], configuration.groupedBatch[2]);
+			fclose(fp);
+		}
+	}
+	VkFFTMemoryRequirements getMemoryRequirements(VkFFTConfiguration inputLaunchConfiguration) {
+		//buffer sizes expected by the configuration and memory traffic of one VkFFTAppend, before any allocation. Pass counts come from the planner with the limits of the device set in the configuration
+		VkFFTMemoryRequirements requirements = {};
+		VkFFTApplication planner = {};
+		planner.configuration = inputLaunchConfiguration;
+		VkFFTConfiguration* config = &planner.configuration;
+		if (config->matrixConvolution > 1) config->coordinateFeatures = config->matrixConvolution;
+		planner.VkFFTDetectDeviceLimits();
+		uint64_t rowLength = (config->performR2C) ? config->size[0] / 2 + 1 : config->size[0];
+		uint64_t systemSize = rowLength * config->size[1] * config->size[2] * 2 * sizeof(float);
+		uint64_t realSystemSize = (uint64_t)config->size[0] * config->size[1] * config->size[2] * sizeof(float);
+		uint32_t outputsPerBatch = ((config->performConvolution) && (config->matrixConvolution == 1)) ? config->numberKernels : 1;
+		requirements.inputBufferSize = config->numberBatches * config->coordinateFeatures * ((config->performR2C && config->isInputFormatted) ? realSystemSize : systemSize);
+		requirements.outputBufferSize = config->numberBatches * outputsPerBatch * config->coordinateFeatures * ((config->performR2C && config->isOutputFormatted) ? realSystemSize : systemSize);
+		requirements.bufferSize = config->numberBatches * outputsPerBatch * config->coordinateFeatures * systemSize;
+		if (config->performConvolution) {
+			uint32_t N = config->matrixConvolution;
+			uint32_t kernelCoordinates = (N > 1) ? ((config->symmetricKernel) ? N * (N + 1) / 2 : N * N) : config->coordinateFeatures;
+			uint32_t numberKernels = (N > 1) ? 1 : config->numberKernels;
+			requirements.kernelSize = numberKernels * kernelCoordinates * systemSize;
+		}
+		//every pass reads and writes its part of the system once. R2C main axes work on size[0]/2 complex numbers per row, support axes on the remaining one
+		uint64_t mainSystemSize = ((config->performR2C) ? config->size[0] / 2 : config->size[0]) * (uint64_t)config->size[1] * config->size[2] * 2 * sizeof(float);
+		uint64_t supportSystemSize = (uint64_t)config->size[1] * config->size[2] * 2 * sizeof(float);
+		uint32_t numPlans = (config->performConvolution) ? 2 : 1;
+		for (uint32_t p = 0; p < numPlans; p++) {
+			//inverse plan of the convolution transforms all numberKernels outputs of each input batch
+			uint64_t systems = (uint64_t)config->coordinateFeatures * config->numberBatches * ((p == 1) ? outputsPerBatch : 1);
+			for (uint32_t i = 0; i < config->FFTdim; i++) {
+				VkFFTStagePlan stagePlan;
+				planner.VkFFTPlanStages(&stagePlan, log2(config->size[i]), (i > 0), (config->performR2C) ? config->size[0] / 2 : config->size[0], config->groupedBatch[i]);
+				uint32_t numPasses = stagePlan.numPasses;
+				uint32_t numSupportPasses = 0;
+				if ((i > 0) && (config->performR2C)) {
+					planner.VkFFTPlanStages(&stagePlan, log2(config->size[i]), (i > 1), config->size[1], config->groupedBatch[i]);
+					numSupportPasses = stagePlan.numPasses;
+				}
+				requirements.numPasses += numPasses + numSupportPasses;
+				requirements.bytesRead += systems * (numPasses * mainSystemSize + numSupportPasses * supportSystemSize);
+				requirements.bytesWritten += systems * (numPasses * mainSystemSize + numSupportPasses * supportSystemSize);
+			}
+		}
+		if (config->performConvolution) {
+			//convolution pass reads the kernel once per input batch and stores outputsPerBatch results instead of one
+			requirements.bytesRead += config->numberBatches * requirements.kernelSize;
+			requirements.bytesWritten += (uint64_t)(outputsPerBatch - 1) * config->numberBatches * config->coordinateFeatures * systemSize;
+		}
+		return requirements;
+	}
+	VkResult initializeVulkanFFT(VkFFTConfiguration inputLaunchConfiguration) {
+		//returns VK_ERROR_INITIALIZATION_FAILED if a shader can't be loaded or a sequence can't be planned within the device limits
 		configuration = inputLaunchConfiguration;
 		if (configuration.matrixConvolution > 1) configuration.coordinateFeatures = configuration.matrixConvolution;
+		for (uint32_t i = 0; i < 3; i++) {
+			//resolve zeropadding ranges - default is the old 2x padding, where upper half of the system is zero
+			if (configuration.performZeropadding[i]) {
+				if (configuration.zeropadInputRange[i][1] == 0) {
+					configuration.zeropadInputRange[i][0] = 0;
+					configuration.zeropadInputRange[i][1] = configuration.size[i] / 2;
+				}
+				if (configuration.zeropadOutputRange[i][1] == 0) {
+					configuration.zeropadOutputRange[i][0] = 0;
+					configuration.zeropadOutputRange[i][1] = configuration.size[i] / 2;
+				}
+				if (configuration.zeropadInputRange[i][1] > configuration.size[i]) configuration.zeropadInputRange[i][1] = configuration.size[i];
+				if (configuration.zeropadOutputRange[i][1] > configuration.size[i]) configuration.zeropadOutputRange[i][1] = configuration.size[i];
+				if (configuration.zeropadInputRange[i][0] > configuration.zeropadInputRange[i][1]) configuration.zeropadInputRange[i][0] = configuration.zeropadInputRange[i][1];
+				if (configuration.zeropadOutputRange[i][0] > configuration.zeropadOutputRange[i][1]) configuration.zeropadOutputRange[i][0] = configuration.zeropadOutputRange[i][1];
+			}
+			else {
+				configuration.zeropadInputRange[i][0] = 0;
+				configuration.zeropadInputRange[i][1] = configuration.size[i];
+				configuration.zeropadOutputRange[i][0] = 0;
+				configuration.zeropadOutputRange[i][1] = configuration.size[i];
+			}
+			if (configuration.performOutputPruning[i]) {
+				if (configuration.outputPruningRange[i][1] == 0) configuration.outputPruningRange[i][1] = configuration.size[i];
+				if (configuration.outputPruningRange[i][1] > configuration.size[i]) configuration.outputPruningRange[i][1] = configuration.size[i];
+				if (configuration.outputPruningRange[i][0] > configuration.outputPruningRange[i][1]) configuration.outputPruningRange[i][0] = configuration.outputPruningRange[i][1];
+				if (configuration.performConvolution) {
+					printf("Output pruning is not supported in convolution, axis %d will be fully stored\n", i);
+					configuration.performOutputPruning[i] = false;
+				}
+				if ((i == 0) && (configuration.performR2C) && (!configuration.inverse)) {
+					printf("Output pruning is not supported for forward R2C x axis, it will be fully stored\n");
+					configuration.performOutputPruning[i] = false;
+				}
+			}
+		}
 
+#ifdef VKFFT_CPU_BACKEND
+		if ((configuration.useCPU) || (configuration.device == NULL))
+			return VkFFTInitializeCPU();
+#else
+		if (configuration.device == NULL) {
+			printf("Application needs a Vulkan device, host execution without it needs VKFFT_CPU_BACKEND to be defined\n");
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+#endif
+		VkFFTDetectDeviceLimits();
+		if ((configuration.autotune) || (configuration.wisdomPath[0] != 0))
+			VkFFTAutotune();
+		VkResult res = VkFFTPlanApplication();
+		if (res != VK_SUCCESS) return res;
+		if ((configuration.timestampQueryPool != NULL) && (configuration.timestampQueryCount > 1))
+			passTimings = (VkFFTPassTiming*)malloc((configuration.timestampQueryCount - 1) * sizeof(VkFFTPassTiming));
+		if (configuration.debugLabels) VkFFTSetDebugNames();
+		return VK_SUCCESS;
+	}
+	VkResult VkFFTPlanApplication() {
 		if (configuration.performConvolution) {
 			
 			configuration.inverse = false;
 			for (uint32_t i = 0; i < configuration.FFTdim; i++) {
-				for (uint32_t j =0; j<8; j++)
-					VkFFTPlanAxis(&localFFTPlan_inverse_convolution, i, j, true);
+				for (uint32_t j = 0; j < 8; j++) {
+					VkResult res = VkFFTPlanAxis(&localFFTPlan_inverse_convolution, i, j, true);
+					if (res != VK_SUCCESS) return res;
+				}
 			}
 			
 		}
 		for (uint32_t i = 0; i < configuration.FFTdim; i++) {
-			for (uint32_t j = 0; j < 8; j++)
-				VkFFTPlanAxis(&localFFTPlan, i, j, configuration.inverse);
+			for (uint32_t j = 0; j < 8; j++) {
+				VkResult res = VkFFTPlanAxis(&localFFTPlan, i, j, configuration.inverse);
+				if (res != VK_SUCCESS) return res;
+			}
 		}
-
+		return VK_SUCCESS;
+	}
+	void VkFFTDescribePass(VkFFTAxis* axis, VkFFTPassTiming* pass) {
+		//find the plan, axis and upload the pass belongs to
+		*pass = {};
+		for (uint32_t p = 0; p < 2; p++) {
+			VkFFTPlan* plan = (p == 0) ? &localFFTPlan : &localFFTPlan_inverse_convolution;
+			for (uint32_t i = 0; i < 3; i++) {
+				for (uint32_t j = 0; j < 5; j++) {
+					if (axis == &plan->axes[i][j]) {
+						pass->inverseConvolutionPlan = (p == 1);
+						pass->axis = i;
+						pass->upload = j;
+					}
+					if ((i < 2) && (axis == &plan->supportAxes[i][j])) {
+						pass->inverseConvolutionPlan = (p == 1);
+						pass->supportAxis = true;
+						pass->axis = i + 1;
+						pass->upload = j;
+					}
+				}
+			}
+		}
+		pass->convolution = (configuration.performConvolution) && (!pass->inverseConvolutionPlan) && (pass->upload == 0) && (pass->axis == configuration.FFTdim - 1);
+		pass->fftDim = axis->specializationConstants.fftDim;
+	}
+	void VkFFTGetPassName(VkFFTAxis* axis, char* name) {
+		//"VkFFT FFT axis 0 upload 1 fftDim 2048 radix 8x8x8x4" - used for debug labels and object names
+		VkFFTPassTiming pass;
+		VkFFTDescribePass(axis, &pass);
+		char radixSequence[64] = "";
+		for (uint32_t i = 0; (i < axis->specializationConstants.numStages) && (i < 16); i++)
+			sprintf(radixSequence + strlen(radixSequence), (i == 0) ? "%d" : "x%d", (i < axis->specializationConstants.numStages - 1) ? axis->specializationConstants.stageRadix[0] : axis->specializationConstants.stageRadix[1]);
+		sprintf(name, "VkFFT %s%s axis %d upload %d fftDim %d radix %s%s", (pass.inverseConvolutionPlan) ? "inverse convolution " : "", (pass.supportAxis) ? "support" : "FFT", pass.axis, pass.upload, pass.fftDim, radixSequence, (pass.convolution) ? " + convolution" : "");
+	}
+	void VkFFTSetObjectName(VkObjectType objectType, uint64_t objectHandle, const char* name) {
+		if (setDebugUtilsObjectName == NULL) return;
+		VkDebugUtilsObjectNameInfoEXT nameInfo = { VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT };
+		nameInfo.objectType = objectType;
+		nameInfo.objectHandle = objectHandle;
+		nameInfo.pObjectName = name;
+		setDebugUtilsObjectName(configuration.device[0], &nameInfo);
+	}
+	void VkFFTSetDebugNames() {
+		//load VK_EXT_debug_utils entry points and name all pipelines and buffers of the application. Without the extension all labeling is skipped
+		cmdBeginDebugUtilsLabel = (PFN_vkCmdBeginDebugUtilsLabelEXT)vkGetDeviceProcAddr(configuration.device[0], "vkCmdBeginDebugUtilsLabelEXT");
+		cmdEndDebugUtilsLabel = (PFN_vkCmdEndDebugUtilsLabelEXT)vkGetDeviceProcAddr(configuration.device[0], "vkCmdEndDebugUtilsLabelEXT");
+		setDebugUtilsObjectName = (PFN_vkSetDebugUtilsObjectNameEXT)vkGetDeviceProcAddr(configuration.device[0], "vkSetDebugUtilsObjectNameEXT");
+		if ((cmdBeginDebugUtilsLabel == NULL) || (cmdEndDebugUtilsLabel == NULL)) {
+			printf("VK_EXT_debug_utils is not enabled, debug labels are skipped\n");
+			cmdBeginDebugUtilsLabel = NULL;
+			cmdEndDebugUtilsLabel = NULL;
+			return;
+		}
+		char name[256];
+		for (uint32_t p = 0; p < 2; p++) {
+			if ((p == 1) && (!configuration.performConvolution)) continue;
+			VkFFTPlan* plan = (p == 0) ? &localFFTPlan : &localFFTPlan_inverse_convolution;
+			for (uint32_t i = 0; i < configuration.FFTdim; i++) {
+				for (uint32_t j = 0; j < plan->numAxisUploads[i]; j++) {
+					VkFFTGetPassName(&plan->axes[i][j], name);
+					VkFFTSetObjectName(VK_OBJECT_TYPE_PIPELINE, (uint64_t)plan->axes[i][j].pipeline, name);
+				}
+			}
+			for (uint32_t i = 0; i < configuration.FFTdim - 1; i++) {
+				if (configuration.performTranspose[i]) continue;
+				for (uint32_t j = 0; j < plan->numSupportAxisUploads[i]; j++) {
+					VkFFTGetPassName(&plan->supportAxes[i][j], name);
+					VkFFTSetObjectName(VK_OBJECT_TYPE_PIPELINE, (uint64_t)plan->supportAxes[i][j].pipeline, name);
+				}
+			}
+		}
+		if (configuration.buffer != NULL) VkFFTSetObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t)configuration.buffer[0], "VkFFT buffer");
+		if ((configuration.inputBuffer != NULL) && (configuration.inputBuffer != configuration.buffer)) VkFFTSetObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t)configuration.inputBuffer[0], "VkFFT input buffer");
+		if ((configuration.outputBuffer != NULL) && (configuration.outputBuffer != configuration.buffer)) VkFFTSetObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t)configuration.outputBuffer[0], "VkFFT output buffer");
+		if ((configuration.performConvolution) && (configuration.kernel != NULL)) VkFFTSetObjectName(VK_OBJECT_TYPE_BUFFER, (uint64_t)configuration.kernel[0], "VkFFT kernel");
+	}
+	void VkFFTBindPass(VkCommandBuffer commandBuffer, VkFFTAxis* axis) {
+		//push constants and bind pipeline and descriptors of the pass. With debug labels, the first bind of a pass opens a label that is closed by VkFFTEndPass
+		if (isDryRun) return;
+		if (pendingBarrierAxis == axis)
+			pendingBarrierAxis = NULL;
+		else
+			VkFFTRecordBarrier(commandBuffer);
+		vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
+		if ((cmdBeginDebugUtilsLabel != NULL) && (!isPassLabelOpen)) {
+			char name[256];
+			VkFFTGetPassName(axis, name);
+			VkDebugUtilsLabelEXT label = { VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT };
+			label.pLabelName = name;
+			cmdBeginDebugUtilsLabel(commandBuffer, &label);
+			isPassLabelOpen = true;
+		}
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+	}
+	void VkFFTDispatch(VkCommandBuffer commandBuffer, VkFFTAxis* axis, uint32_t x, uint32_t y, uint32_t z) {
+		//dispatch sites pass the end of the zeropadded range, the pass starts at its beginning
+		y -= axis->dispatchShift[1];
+		z -= axis->dispatchShift[2];
+		if (isDryRun) {
+			axis->dispatchGrid[0] = x;
+			axis->dispatchGrid[1] = y;
+			axis->dispatchGrid[2] = z;
+			axis->numDispatches++;
+			if (hostBuffer != NULL) VkFFTExecutePassOnHost(axis, x, y, z);
+			return;
+		}
+		vkCmdDispatch(commandBuffer, x, y, z);
+	}
+	void VkFFTRecordBarrier(VkCommandBuffer commandBuffer) {
+		//barrier on the buffers of pendingBarrierAxis only - other buffers and applications in the command buffer keep their caches
+		if (pendingBarrierAxis == NULL) return;
+		VkBufferMemoryBarrier buffer_barriers[2];
+		uint32_t numBufferBarriers = 0;
+		for (uint32_t i = 0; i < 2; i++) {
+			VkBuffer buffer = pendingBarrierAxis->passBuffers[i];
+			if ((buffer == VK_NULL_HANDLE) || ((i == 1) && (buffer == pendingBarrierAxis->passBuffers[0]))) continue;
+			VkBufferMemoryBarrier buffer_barrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
+			buffer_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			buffer_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+			buffer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			buffer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			buffer_barrier.buffer = buffer;
+			buffer_barrier.offset = 0;
+			buffer_barrier.size = VK_WHOLE_SIZE;
+			buffer_barriers[numBufferBarriers] = buffer_barrier;
+			numBufferBarriers++;
+		}
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, NULL, numBufferBarriers, buffer_barriers, 0, NULL);
+		pendingBarrierAxis = NULL;
+	}
+	void VkFFTEndPass(VkCommandBuffer commandBuffer, VkFFTAxis* axis) {
+		//end of a pass without a barrier after it. With profiling enabled, the pass is closed with a timestamp and labeled with the plan, axis and upload it belongs to. An open debug label of the pass is closed
+		if (isDryRun) return;
+		if ((configuration.timestampQueryPool != NULL) && (passTimings != NULL) && (numTimestampQueries < configuration.timestampQueryCount)) {
+			VkFFTPassTiming* timing = &passTimings[numPassTimings];
+			VkFFTDescribePass(axis, timing);
+			timing->startQuery = lastTimestampQuery;
+			timing->endQuery = numTimestampQueries;
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, configuration.timestampQueryPool[0], numTimestampQueries);
+			lastTimestampQuery = numTimestampQueries;
+			numTimestampQueries++;
+			numPassTimings++;
+		}
+		if (isPassLabelOpen) {
+			cmdEndDebugUtilsLabel(commandBuffer);
+			isPassLabelOpen = false;
+		}
+	}
+	void VkFFTPassBarrier(VkCommandBuffer commandBuffer, VkFFTAxis* axis) {
+		//end of a pass. Its barrier is recorded by the next VkFFTBindPass, and dropped if the next pass is the same axis and upload for another batch - batches work on separate parts of the buffers, so they run concurrently. With profiling enabled, the barrier is recorded right away to keep passes apart
+		if (isDryRun) return;
+		VkFFTEndPass(commandBuffer, axis);
+		pendingBarrierAxis = axis;
+		if (configuration.timestampQueryPool != NULL) VkFFTRecordBarrier(commandBuffer);
+	}
+	void resetPassTimestamps(VkCommandBuffer commandBuffer) {
+		//record before the first VkFFTAppend to be profiled. Following VkFFTAppend calls add their passes until the next reset
+		if (configuration.timestampQueryPool == NULL) return;
+		vkCmdResetQueryPool(commandBuffer, configuration.timestampQueryPool[0], 0, configuration.timestampQueryCount);
+		numPassTimings = 0;
+		numTimestampQueries = 0;
+		lastTimestampQuery = 0;
+	}
+	uint32_t readPassTimestamps() {
+		//call after the command buffer has finished execution. Fills time of the recorded passes and returns their number
+		if ((configuration.timestampQueryPool == NULL) || (numTimestampQueries == 0)) return 0;
+		uint64_t* timestamps = (uint64_t*)malloc(numTimestampQueries * sizeof(uint64_t));
+		vkGetQueryPoolResults(configuration.device[0], configuration.timestampQueryPool[0], 0, numTimestampQueries, numTimestampQueries * sizeof(uint64_t), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+		for (uint32_t i = 0; i < numPassTimings; i++)
+			passTimings[i].time = (timestamps[passTimings[i].endQuery] - timestamps[passTimings[i].startQuery]) * deviceLimits.timestampPeriod * 0.000001f;
+		free(timestamps);
+		return numPassTimings;
+	}
+	void printPassTimestamps() {
+		uint32_t numPasses = readPassTimestamps();
+		float totTime = 0;
+		for (uint32_t i = 0; i < numPasses; i++) {
+			VkFFTPassTiming* timing = &passTimings[i];
+			printf("%s%s axis %d upload %d fftDim %d%s: %0.3f ms\n", (timing->inverseConvolutionPlan) ? "inverse convolution plan, " : "", (timing->supportAxis) ? "support" : "FFT", timing->axis, timing->upload, timing->fftDim, (timing->convolution) ? " + convolution" : "", timing->time);
+			totTime += timing->time;
+		}
+		if (numPasses > 0) printf("Total GPU time of %d passes: %0.3f ms\n", numPasses, totTime);
+	}
+	void VkFFTPrintPassJSON(FILE* fp, VkFFTAxis* axis, bool isLast) {
+		VkFFTPassTiming pass;
+		VkFFTDescribePass(axis, &pass);
+		VkFFTSpecializationConstantsLayout* sc = &axis->specializationConstants;
+		//each workgroup reads and writes its sequences once, boosted shaders handle one sequence with less than fftDim/8 threads
+		uint64_t sequencesPerWorkGroup = (uint64_t)axis->axisBlock[0] * axis->axisBlock[1] * axis->axisBlock[2] * 8 / sc->fftDim;
+		if (sequencesPerWorkGroup == 0) sequencesPerWorkGroup = 1;
+		uint64_t bytesMoved = 2 * 8 * sequencesPerWorkGroup * sc->fftDim * axis->dispatchGrid[0] * axis->dispatchGrid[1] * axis->dispatchGrid[2] * axis->numDispatches;
+		fprintf(fp, "\t\t\t{ \"axis\": %d, \"supportAxis\": %s, \"upload\": %d, \"convolution\": %s, \"shader\": \"%s\", \"fftDim\": %d, \"numStages\": %d, \"stageRadix\": [%d, %d], \"passID\": %d, ", pass.axis, (pass.supportAxis) ? "true" : "false", pass.upload, (pass.convolution) ? "true" : "false", VkFFTGetShaderName(axis->shaderID), sc->fftDim, sc->numStages, sc->stageRadix[0], sc->stageRadix[1], sc->passID);
+		fprintf(fp, "\"inputStride\": [%d, %d, %d, %d, %d], \"outputStride\": [%d, %d, %d, %d, %d], ", sc->inputStride[0], sc->inputStride[1], sc->inputStride[2], sc->inputStride[3], sc->inputStride[4], sc->outputStride[0], sc->outputStride[1], sc->outputStride[2], sc->outputStride[3], sc->outputStride[4]);
+		fprintf(fp, "\"axisBlock\": [%d, %d, %d, %d], \"groupedBatch\": %d, \"dispatchGrid\": [%d, %d, %d], \"numDispatches\": %d, \"bytesMoved\": %llu }%s\n", axis->axisBlock[0], axis->axisBlock[1], axis->axisBlock[2], axis->axisBlock[3], axis->groupedBatch, axis->dispatchGrid[0], axis->dispatchGrid[1], axis->dispatchGrid[2], axis->numDispatches, (unsigned long long)bytesMoved, (isLast) ? "" : ",");
+	}
+	void printPlanJSON(FILE* fp) {
+		//dump passes of localFFTPlan and localFFTPlan_inverse_convolution in the order VkFFTAppend records them. Dispatch grids come from a dry run of VkFFTAppend, bytesMoved is the estimated global memory traffic of one VkFFTAppend
+		VkFFTPlan* plans[2] = { &localFFTPlan, &localFFTPlan_inverse_convolution };
+		for (uint32_t p = 0; p < 2; p++) {
+			for (uint32_t i = 0; i < 3; i++) {
+				for (uint32_t j = 0; j < 5; j++) {
+					plans[p]->axes[i][j].numDispatches = 0;
+					if (i < 2) plans[p]->supportAxes[i][j].numDispatches = 0;
+				}
+			}
+		}
+		isDryRun = true;
+		VkFFTAppend(VK_NULL_HANDLE);
+		isDryRun = false;
+		fprintf(fp, "{\n\t\"size\": [%d, %d, %d], \"FFTdim\": %d, \"coordinateFeatures\": %d, \"numberBatches\": %d, \"R2C\": %s, \"inverse\": %s, \"convolution\": %s,\n", configuration.size[0], configuration.size[1], configuration.size[2], configuration.FFTdim, configuration.coordinateFeatures, configuration.numberBatches, (configuration.performR2C) ? "true" : "false", (configuration.inverse) ? "true" : "false", (configuration.performConvolution) ? "true" : "false");
+		fprintf(fp, "\t\"registerBoost\": %d, \"coalescedMemory\": %d, \"radix\": %d, \"sharedMemorySize\": %d,\n\t\"plans\": [\n", configuration.registerBoost, configuration.coalescedMemory, configuration.radix, deviceLimits.sharedMemorySize);
+		uint32_t numPlans = (configuration.performConvolution) ? 2 : 1;
+		for (uint32_t p = 0; p < numPlans; p++) {
+			VkFFTPlan* plan = plans[p];
+			fprintf(fp, "\t\t{ \"name\": \"%s\", \"passes\": [\n", (p == 0) ? "localFFTPlan" : "localFFTPlan_inverse_convolution");
+			uint32_t numPasses = 0;
+			uint32_t printedPasses = 0;
+			for (uint32_t i = 0; i < configuration.FFTdim; i++) {
+				numPasses += plan->numAxisUploads[i];
+				if ((i > 0) && (!configuration.performTranspose[i - 1])) numPasses += plan->numSupportAxisUploads[i - 1];
+			}
+			for (uint32_t i = 0; i < configuration.FFTdim; i++) {
+				for (uint32_t j = 0; j < plan->numAxisUploads[i]; j++) {
+					printedPasses++;
+					VkFFTPrintPassJSON(fp, &plan->axes[i][j], printedPasses == numPasses);
+				}
+				if ((i > 0) && (!configuration.performTranspose[i - 1])) {
+					for (uint32_t j = 0; j < plan->numSupportAxisUploads[i - 1]; j++) {
+						printedPasses++;
+						VkFFTPrintPassJSON(fp, &plan->supportAxes[i - 1][j], printedPasses == numPasses);
+					}
+				}
+			}
+			fprintf(fp, "\t\t] }%s\n", (p == numPlans - 1) ? "" : ",");
+		}
+		fprintf(fp, "\t]\n}\n");
+	}
+	void VkFFTExecutePassOnHost(VkFFTAxis* axis, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+		//interprets one dispatch of a C2C pass like the shader does: every sequence of the workgroup grid is read with the strides, offsets and zeropad ranges of the specialization constants, multiplied by the four step twiddles of passID, transformed with the planned radix stages in double precision and stored back. Reads come from a snapshot of the buffer taken before the dispatch
+		VkFFTSpecializationConstantsLayout* sc = &axis->specializationConstants;
+		bool isSingle = (axis->shaderID == 0) || (axis->shaderID == 25) || (axis->shaderID == 35);
+		bool isStrided = (axis->shaderID == 2);
+		bool isGrouped = (axis->shaderID == 7);
+		char name[256];
+		VkFFTGetPassName(axis, name);
+		if ((!isSingle) && (!isStrided) && (!isGrouped)) {
+			printf("%s: %s can't be executed on host, only C2C passes are supported\n", name, VkFFTGetShaderName(axis->shaderID));
+			isHostRunFailed = true;
+			return;
+		}
+		uint32_t fftDim = sc->fftDim;
+		uint32_t stagesSize = 1;
+		for (uint32_t n = 0; n < sc->numStages; n++)
+			stagesSize *= (n < sc->numStages - 1) ? sc->stageRadix[0] : sc->stageRadix[1];
+		if (stagesSize != fftDim) {
+			printf("%s: radix stages cover %d elements instead of fftDim %d\n", name, stagesSize, fftDim);
+			isHostRunFailed = true;
+			return;
+		}
+		uint64_t bufferLength = configuration.bufferSize[0] / (2 * sizeof(float)); //complex numbers
+		memcpy(hostSnapshot, hostBuffer, bufferLength * 2 * sizeof(float));
+		//single shaders merge localSize[1] sequences (one for register-boosted ones), strided and grouped shaders merge localSize[0] sequences
+		uint32_t sequencesPerGroup = (isSingle) ? ((axis->shaderID == 0) ? sc->localSize[1] : 1) : sc->localSize[0];
+		double sign = (sc->inverse) ? -1.0 : 1.0;
+		double* data = (double*)malloc(2 * sizeof(double) * fftDim);
+		double* stageOutput = (double*)malloc(2 * sizeof(double) * fftDim);
+		uint64_t* index = (uint64_t*)malloc(sizeof(uint64_t) * fftDim);
+		uint32_t* position = (uint32_t*)malloc(sizeof(uint32_t) * fftDim);
+		bool isOutOfBounds = false;
+		for (uint32_t z = 0; z < groupCountZ * sc->localSize[2]; z++) {
+			for (uint32_t y = 0; y < groupCountY; y++) {
+				for (uint32_t x = 0; x < groupCountX * sequencesPerGroup; x++) {
+					//position of each element along the axis and twiddle index of the sequence, as computed by the shader
+					uint32_t twiddleID = 0;
+					uint32_t index_x = 0;
+					for (uint32_t n = 0; n < fftDim; n++) {
+						if (isSingle) {
+							twiddleID = x;
+							position[n] = n + twiddleID * fftDim;
+						}
+						if (isStrided) {
+							twiddleID = x;
+							position[n] = x % sc->stageStartSize + sc->stageStartSize * n + (x / sc->stageStartSize) * (sc->stageStartSize * fftDim);
+						}
+						if (isGrouped) {
+							twiddleID = x / sc->fft_dim_x;
+							index_x = x % sc->fft_dim_x;
+							position[n] = sc->stageStartSize * n + twiddleID % sc->stageStartSize + (twiddleID / sc->stageStartSize) * (sc->stageStartSize * fftDim);
+						}
+					}
+					//read - indices wrap like the uint arithmetic of the shaders, offsets of formatted buffers rely on it
+					for (uint32_t n = 0; n < fftDim; n++) {
+						if (isGrouped)
+							index[n] = (uint32_t)(sc->inputOffset + (uint64_t)index_x * sc->inputStride[0] + (uint64_t)position[n] * sc->inputStride[1] + (uint64_t)z * sc->inputStride[2] + (uint64_t)axis->pushConstants.coordinate * sc->inputStride[3] + (uint64_t)axis->pushConstants.batch * sc->inputStride[4]);
+						else
+							index[n] = (uint32_t)(sc->inputOffset + (uint64_t)position[n] * sc->inputStride[0] + (uint64_t)y * sc->inputStride[1] + (uint64_t)z * sc->inputStride[2] + (uint64_t)axis->pushConstants.coordinate * sc->inputStride[3] + (uint64_t)axis->pushConstants.batch * sc->inputStride[4]);
+						bool isRead = (!sc->zeropad[0]) || (sc->inverse) || ((position[n] >= sc->zeropadInputRange[0]) && (position[n] < sc->zeropadInputRange[1]));
+						if ((isRead) && (index[n] >= bufferLength)) {
+							isOutOfBounds = true;
+							isRead = false;
+						}
+						data[2 * n] = (isRead) ? hostSnapshot[2 * index[n]] : 0;
+						data[2 * n + 1] = (isRead) ? hostSnapshot[2 * index[n] + 1] : 0;
+					}
+					//four step twiddles of the forward transform are applied before the stages
+					if ((sc->passID > 0) && (!sc->inverse)) {
+						for (uint32_t n = 0; n < fftDim; n++) {
+							double angle = 2 * M_PI * (((uint64_t)twiddleID * n) / (double)sc->fft_dim_full);
+							double re = data[2 * n] * cos(angle) - data[2 * n + 1] * sin(angle);
+							double im = data[2 * n + 1] * cos(angle) + data[2 * n] * sin(angle);
+							data[2 * n] = re;
+							data[2 * n + 1] = im;
+						}
+					}
+					//Stockham radix stages. Invocation j reads elements j + r*fftDim/radix, twiddles them by r*stageInvocationID/(radix*stageSize) of the full turn and writes the radix point DFT with stride stageSize. Inverse stages are normalized by 1/radix
+					uint32_t stageSize = 1;
+					for (uint32_t n = 0; n < sc->numStages; n++) {
+						uint32_t radix = (n < sc->numStages - 1) ? sc->stageRadix[0] : sc->stageRadix[1];
+						double stageNormalization = (sc->inverse) ? 1.0 / radix : 1.0;
+						for (uint32_t j = 0; j < fftDim / radix; j++) {
+							uint32_t stageInvocationID = j & (stageSize - 1);
+							uint32_t outputIndex = stageInvocationID + (j - stageInvocationID) * radix;
+							for (uint32_t k = 0; k < radix; k++) {
+								double re = 0;
+								double im = 0;
+								for (uint32_t r = 0; r < radix; r++) {
+									double angle = sign * 2 * M_PI * ((double)r * stageInvocationID / (radix * stageSize) + (double)r * k / radix);
+									double v_re = data[2 * (j + r * fftDim / radix)];
+									double v_im = data[2 * (j + r * fftDim / radix) + 1];
+									re += v_re * cos(angle) - v_im * sin(angle);
+									im += v_im * cos(angle) + v_re * sin(angle);
+								}
+								stageOutput[2 * (outputIndex + k * stageSize)] = re * stageNormalization;
+								stageOutput[2 * (outputIndex + k * stageSize) + 1] = im * stageNormalization;
+							}
+						}
+						double* swap = data;
+						data = stageOutput;
+						stageOutput = swap;
+						stageSize *= radix;
+					}
+					//inverse four step twiddles are applied after the stages
+					if ((sc->passID > 0) && (sc->inverse)) {
+						for (uint32_t n = 0; n < fftDim; n++) {
+							double angle = -2 * M_PI * (((uint64_t)twiddleID * n) / (double)sc->fft_dim_full);
+							double re = data[2 * n] * cos(angle) - data[2 * n + 1] * sin(angle);
+							double im = data[2 * n + 1] * cos(angle) + data[2 * n] * sin(angle);
+							data[2 * n] = re;
+							data[2 * n + 1] = im;
+						}
+					}
+					//write
+					for (uint32_t n = 0; n < fftDim; n++) {
+						if (isGrouped)
+							index[n] = (uint32_t)(sc->outputOffset + (uint64_t)index_x * sc->outputStride[0] + (uint64_t)position[n] * sc->outputStride[1] + (uint64_t)z * sc->outputStride[2] + (uint64_t)axis->pushConstants.coordinate * sc->outputStride[3] + (uint64_t)axis->pushConstants.batch * sc->outputStride[4]);
+						else
+							index[n] = (uint32_t)(sc->outputOffset + (uint64_t)position[n] * sc->outputStride[0] + (uint64_t)y * sc->outputStride[1] + (uint64_t)z * sc->outputStride[2] + (uint64_t)axis->pushConstants.coordinate * sc->outputStride[3] + (uint64_t)axis->pushConstants.batch * sc->outputStride[4]);
+						bool isWritten = (((!sc->zeropad[0]) || (!sc->inverse)) && (!sc->pruneOutput)) || ((position[n] >= sc->zeropadOutputRange[0]) && (position[n] < sc->zeropadOutputRange[1]));
+						if ((isWritten) && (index[n] >= bufferLength)) {
+							isOutOfBounds = true;
+							isWritten = false;
+						}
+						if (isWritten) {
+							hostBuffer[2 * index[n]] = (float)data[2 * n];
+							hostBuffer[2 * index[n] + 1] = (float)data[2 * n + 1];
+						}
+					}
+				}
+			}
+		}
+		if (isOutOfBounds) {
+			printf("%s: grid %dx%dx%d accesses elements outside of the buffer\n", name, groupCountX, groupCountY, groupCountZ);
+			isHostRunFailed = true;
+		}
+		free(data);
+		free(stageOutput);
+		free(index);
+		free(position);
+	}
+	bool executeOnHost(float* buffer) {
+		//runs the passes VkFFTAppend would record on a host copy of configuration.buffer (bufferSize bytes, same layout), in the same order and with the same dispatch grids, push constants and specialization constants. Used to debug planner changes without a GPU and as a reference for the GPU result, including multi-upload plans in four step order. Only in-place C2C plans without convolution are supported
+		if ((configuration.performR2C) || (configuration.performConvolution)) {
+			printf("Host execution supports only C2C plans without convolution\n");
+			return false;
+		}
+		if ((configuration.inputBuffer[0] != configuration.buffer[0]) || (configuration.outputBuffer[0] != configuration.buffer[0])) {
+			printf("Host execution supports only in-place plans\n");
+			return false;
+		}
+		hostBuffer = buffer;
+		hostSnapshot = (float*)malloc(configuration.bufferSize[0]);
+		isHostRunFailed = false;
+		isDryRun = true;
+		VkFFTAppend(VK_NULL_HANDLE);
+		isDryRun = false;
+		free(hostSnapshot);
+		hostSnapshot = NULL;
+		hostBuffer = NULL;
+		return !isHostRunFailed;
+	}
+#ifdef VKFFT_CPU_BACKEND
+	uint64_t VkFFTCPUSystemSize() {
+		//floats in one coordinate of one batch, R2C x-y planes are padded to size[0]/2+1 complex numbers per row
+		uint64_t rowLength = (configuration.performR2C) ? configuration.size[0] / 2 + 1 : configuration.size[0];
+		return 2 * rowLength * configuration.size[1] * configuration.size[2];
+	}
+	uint32_t* VkFFTCPUStorageOrder(VkFFTStagePlan* stagePlan, uint32_t size) {
+		//uploads of a split axis leave digit u of the storage index, in base of the length of upload u, holding digit numPasses - 1 - u of the frequency - mixed radix digit reversal
+		uint32_t* order = (uint32_t*)malloc(size * sizeof(uint32_t));
+		for (uint32_t s = 0; s < size; s++) {
+			uint32_t k = 0;
+			uint32_t rest = s;
+			for (uint32_t u = 0; u < stagePlan->numPasses; u++) {
+				uint32_t length = 1 << stagePlan->logSize[u];
+				k = k * length + rest % length;
+				rest /= length;
+			}
+			order[s] = k;
+		}
+		return order;
+	}
+	VkResult VkFFTInitializeCPU() {
+		//CPU backend: every axis is one set of radix 2/4/8 FFTs done VKFFT_CPU_LANES sequences at a time, axes longer than VKFFT_CPU_MAX_LINE are split in two passes of the four step FFT
+		isCPUBackend = true;
+		//axes that VkFFTAppend would do in several uploads with the limits of the configured device (defaults without one) are stored in the same four step order, so both backends fill the buffer identically. The R2C x axis keeps natural order
+		VkFFTDetectDeviceLimits();
+		uint32_t maxReorderDim = 0;
+		for (uint32_t i = 0; i < configuration.FFTdim; i++) {
+			for (uint32_t j = 0; j < (((i > 0) && (configuration.performR2C)) ? 2 : 1); j++) {
+				VkFFTStagePlan stagePlan;
+				if (j == 0)
+					VkFFTPlanStages(&stagePlan, log2(configuration.size[i]), (i > 0), (configuration.performR2C) ? configuration.size[0] / 2 : configuration.size[0], configuration.groupedBatch[i]);
+				else
+					VkFFTPlanStages(&stagePlan, log2(configuration.size[i]), (i > 1), configuration.size[1], configuration.groupedBatch[i]);
+				if (stagePlan.numPasses < 2) continue;
+				if (configuration.performOutputPruning[i]) {
+					printf("Output pruning of axis %d is not supported, the axis is done in %d uploads and its result is stored in four step order\n", i, stagePlan.numPasses);
+					return VK_ERROR_INITIALIZATION_FAILED;
+				}
+				if ((i == 0) && (configuration.performR2C)) continue;
+				if (j == 0) storageOrder[i] = VkFFTCPUStorageOrder(&stagePlan, configuration.size[i]);
+				else supportStorageOrder[i - 1] = VkFFTCPUStorageOrder(&stagePlan, configuration.size[i]);
+				if (configuration.size[i] > maxReorderDim) maxReorderDim = configuration.size[i];
+			}
+		}
+		uint32_t numThreads = configuration.numberCPUThreads;
+		if (numThreads == 0) numThreads = std::thread::hardware_concurrency();
+		if (numThreads == 0) numThreads = 1;
+		threadPool = new VkFFTCPUThreadPool();
+		threadPool->initialize(numThreads);
+		uint32_t maxPassDim = 1;
+		uint32_t maxFourStepDim = 0;
+		uint64_t numSystems = (uint64_t)configuration.coordinateFeatures * configuration.numberBatches;
+		for (uint32_t i = 0; i < configuration.FFTdim; i++) {
+			twiddleTables[i] = (float*)malloc(2 * configuration.size[i] * sizeof(float));
+			for (uint32_t j = 0; j < configuration.size[i]; j++) {
+				double angle = 2 * M_PI * j / configuration.size[i];
+				twiddleTables[i][2 * j] = (float)cos(angle);
+				twiddleTables[i][2 * j + 1] = (float)sin(angle);
+			}
+			uint32_t fftDim = ((i == 0) && (configuration.performR2C)) ? configuration.size[0] / 2 : configuration.size[i];
+			if (fftDim >= VKFFT_CPU_MIN_FOUR_STEP) {
+				if (fftDim > maxFourStepDim) maxFourStepDim = fftDim;
+				//lines are distributed between threads if there are enough of them and the scratch of all threads is not too big
+				uint64_t numLines = numSystems * configuration.size[0] * configuration.size[1] * configuration.size[2] / configuration.size[i];
+				if ((numLines >= numThreads) && (fftDim <= 65536) && (fftDim > fourStepThreadDim)) fourStepThreadDim = fftDim;
+			}
+			if (fftDim > VKFFT_CPU_MAX_LINE) fftDim = fftDim / (1 << ((uint32_t)log2(fftDim) / 2));
+			if (fftDim > maxPassDim) maxPassDim = fftDim;
+		}
+		threadScratch = (float**)malloc(numThreads * sizeof(float*));
+		for (uint32_t i = 0; i < numThreads; i++)
+			threadScratch[i] = (float*)malloc(4 * VKFFT_CPU_LANES * (maxPassDim + 1) * sizeof(float));
+		if (maxFourStepDim > 0) {
+			fourStepScratch = (float**)calloc(2 * numThreads, sizeof(float*));
+			for (uint32_t i = 0; i < 2 * numThreads; i++) {
+				uint32_t lineSize = (i < 2) ? maxFourStepDim : fourStepThreadDim;
+				if (lineSize > 0) fourStepScratch[i] = (float*)malloc(2 * (lineSize + 1) * sizeof(float));
+			}
+		}
+		if (maxReorderDim > 0) {
+			reorderScratch = (float**)malloc(numThreads * sizeof(float*));
+			for (uint32_t i = 0; i < numThreads; i++)
+				reorderScratch[i] = (float*)malloc(2 * maxReorderDim * sizeof(float));
+		}
+		if (configuration.performConvolution)
+			convolutionScratch = (float*)malloc(configuration.coordinateFeatures * VkFFTCPUSystemSize() * sizeof(float));
+		return VK_SUCCESS;
+	}
+	void VkFFTDeleteCPU() {
+		for (uint32_t i = 0; i < 3; i++) {
+			free(storageOrder[i]);
+			storageOrder[i] = NULL;
+			if (i < 2) {
+				free(supportStorageOrder[i]);
+				supportStorageOrder[i] = NULL;
+			}
+		}
+		//initialization failed before the threads were started
+		if (threadPool == NULL) return;
+		if (reorderScratch != NULL) {
+			for (uint32_t i = 0; i < threadPool->numThreads; i++)
+				free(reorderScratch[i]);
+			free(reorderScratch);
+			reorderScratch = NULL;
+		}
+		for (uint32_t i = 0; i < threadPool->numThreads; i++)
+			free(threadScratch[i]);
+		free(threadScratch);
+		threadScratch = NULL;
+		if (fourStepScratch != NULL) {
+			for (uint32_t i = 0; i < 2 * threadPool->numThreads; i++)
+				free(fourStepScratch[i]);
+			free(fourStepScratch);
+			fourStepScratch = NULL;
+		}
+		threadPool->destroy();
+		delete threadPool;
+		threadPool = NULL;
+		for (uint32_t i = 0; i < 3; i++) {
+			free(twiddleTables[i]);
+			twiddleTables[i] = NULL;
+		}
+		free(convolutionScratch);
+		convolutionScratch = NULL;
+	}
+	void VkFFTCPURunPass(VkFFTCPUPass* pass, bool isSerial = false, uint32_t threadID = 0) {
+		//tasks of whole groups of lanes, big enough to hide the scheduling cost, and at least 4 per thread if there are enough lines. Serial pass is done in one task by threadID
+		uint64_t numLines = (uint64_t)pass->lineCount[0] * pass->lineCount[1] * pass->lineCount[2];
+		pass->radix = configuration.radix;
+		pass->threadScratch = threadScratch;
+		if (isSerial) {
+			pass->linesPerTask = (uint32_t)numLines;
+			VkFFTCPUPassTask(pass, 0, threadID);
+			return;
+		}
+		uint64_t numGroups = (numLines + VKFFT_CPU_LANES - 1) / VKFFT_CPU_LANES;
+		uint64_t groupsPerTask = 65536 / ((uint64_t)pass->fftDim * VKFFT_CPU_LANES) + 1;
+		if (groupsPerTask > numGroups / (4 * threadPool->numThreads)) groupsPerTask = numGroups / (4 * threadPool->numThreads);
+		if (groupsPerTask == 0) groupsPerTask = 1;
+		pass->linesPerTask = (uint32_t)(groupsPerTask * VKFFT_CPU_LANES);
+		threadPool->run(VkFFTCPUPassTask, pass, (uint32_t)((numLines + pass->linesPerTask - 1) / pass->linesPerTask));
+	}
+	void VkFFTCPUTransformAxis(float* data, uint64_t numSystems, uint32_t axis_id, bool inverse) {
+		//all lines of one axis in numSystems consecutive systems. Zeropadded axes that are not transformed yet (forward) or already were (inverse) are processed only in their input or output range, like the shaders do
+		uint32_t* size = configuration.size;
+		uint64_t rowLength = (configuration.performR2C) ? size[0] / 2 + 1 : size[0];
+		uint64_t axisStride[3] = { 1, rowLength, rowLength * size[1] };
+		bool isReal = (axis_id == 0) && (configuration.performR2C);
+		VkFFTCPUPass pass = {};
+		pass.fftDim = (isReal) ? size[0] / 2 : size[axis_id];
+		if ((pass.fftDim == 1) && (!isReal)) return;
+		pass.realTransform = (isReal) ? ((inverse) ? 2 : 1) : 0;
+		pass.inverse = inverse;
+		pass.scale = (inverse) ? 1.0f / pass.fftDim : 1.0f;
+		pass.twiddles = twiddleTables[axis_id];
+		pass.twiddleSize = size[axis_id];
+		uint64_t lineOffset = 0;
+		uint64_t lineStride[3];
+		uint32_t k = 0;
+		for (uint32_t i = 0; i < 3; i++) {
+			if (i == axis_id) continue;
+			uint32_t range[2] = { 0, (i == 0) ? (uint32_t)rowLength : size[i] };
+			if ((i > axis_id) && (i < configuration.FFTdim) && (configuration.performZeropadding[i])) {
+				range[0] = (inverse) ? configuration.zeropadOutputRange[i][0] : configuration.zeropadInputRange[i][0];
+				range[1] = (inverse) ? configuration.zeropadOutputRange[i][1] : configuration.zeropadInputRange[i][1];
+			}
+			pass.lineCount[k] = range[1] - range[0];
+			lineOffset += range[0] * axisStride[i];
+			lineStride[k] = axisStride[i];
+			k++;
+		}
+		pass.lineCount[2] = (uint32_t)numSystems;
+		lineStride[2] = axisStride[2] * size[2];
+		//ranges are in real numbers - one per element of the R2C x axis, two per complex element otherwise
+		uint64_t unit = (isReal) ? 1 : 2;
+		pass.inputRange[0] = 0;
+		pass.inputRange[1] = (uint64_t)-1;
+		pass.outputRange[0] = 0;
+		pass.outputRange[1] = (uint64_t)-1;
+		if ((!inverse) && (configuration.performZeropadding[axis_id])) {
+			pass.inputRange[0] = configuration.zeropadInputRange[axis_id][0] * unit;
+			pass.inputRange[1] = configuration.zeropadInputRange[axis_id][1] * unit;
+		}
+		if ((inverse) && (configuration.performZeropadding[axis_id])) {
+			pass.outputRange[0] = configuration.zeropadOutputRange[axis_id][0] * unit;
+			pass.outputRange[1] = configuration.zeropadOutputRange[axis_id][1] * unit;
+		}
+		if (configuration.performOutputPruning[axis_id]) {
+			if (pass.outputRange[0] < configuration.outputPruningRange[axis_id][0] * unit) pass.outputRange[0] = configuration.outputPruningRange[axis_id][0] * unit;
+			if (pass.outputRange[1] > configuration.outputPruningRange[axis_id][1] * unit) pass.outputRange[1] = configuration.outputPruningRange[axis_id][1] * unit;
+		}
+		for (uint32_t i = 0; i < 2; i++) {
+			pass.maskLineFactor[i] = 0;
+			pass.maskElementFactor[i] = 1;
+		}
+		pass.input = data;
+		pass.output = data;
+		pass.inputOffset = lineOffset;
+		pass.outputOffset = lineOffset;
+		for (uint32_t i = 0; i < 3; i++) {
+			pass.inputLineStride[i] = lineStride[i];
+			pass.outputLineStride[i] = lineStride[i];
+		}
+		pass.inputStride = axisStride[axis_id];
+		pass.outputStride = axisStride[axis_id];
+		uint64_t numLines = (uint64_t)pass.lineCount[0] * pass.lineCount[1] * pass.lineCount[2];
+		if ((isReal) && (!inverse)) VkFFTCPUPadRows(data, numSystems, true);
+		if (inverse) VkFFTCPUReorderAxis(&pass, axis_id);
+		if ((pass.fftDim <= VKFFT_CPU_MAX_LINE) && ((numLines >= VKFFT_CPU_LANES) || (pass.fftDim < VKFFT_CPU_MIN_FOUR_STEP)))
+			VkFFTCPURunPass(&pass);
+		else if ((numLines >= threadPool->numThreads) && (pass.fftDim <= fourStepThreadDim)) {
+			fourStepPass = &pass;
+			threadPool->run(VkFFTCPUFourStepTask, this, (uint32_t)numLines);
+		}
+		else {
+			for (uint64_t t = 0; t < numLines; t++)
+				VkFFTCPUFourStepLine(&pass, t, 0, false);
+		}
+		if (!inverse) VkFFTCPUReorderAxis(&pass, axis_id);
+		if ((isReal) && (inverse)) VkFFTCPUPadRows(data, numSystems, false);
+	}
+	void VkFFTCPUPadRows(float* data, uint64_t numSystems, bool pad) {
+		//real rows of R2C buffers are packed in each x-y plane, which is padded to (size[0]+2)*size[1] - the layout VkFFTAppend reads before the forward FFT and writes after the inverse one. The x axis is transformed in rows of size[0]+2, so they are moved apart before the forward transform and back together after the inverse one
+		uint32_t* size = configuration.size;
+		uint64_t planeSize = (uint64_t)(size[0] + 2) * size[1];
+		for (uint64_t p = 0; p < numSystems * size[2]; p++) {
+			float* plane = data + p * planeSize;
+			for (uint32_t n = 1; n < size[1]; n++) {
+				//padding moves rows up, starting from the last one, packing moves them down, starting from the second one
+				uint64_t j = (pad) ? size[1] - n : n;
+				if (pad)
+					memmove(plane + j * (size[0] + 2), plane + j * size[0], size[0] * sizeof(float));
+				else
+					memmove(plane + j * size[0], plane + j * (size[0] + 2), size[0] * sizeof(float));
+			}
+		}
+	}
+	void VkFFTCPUReorderAxis(VkFFTCPUPass* pass, uint32_t axis_id) {
+		//moves the lines of the pass between natural and four step order: after the forward transform and before the inverse one
+		VkFFTCPUReorder reorder = {};
+		reorder.order = storageOrder[axis_id];
+		if ((axis_id > 0) && (configuration.performR2C)) reorder.lastColumnOrder = supportStorageOrder[axis_id - 1];
+		if ((reorder.order == NULL) && (reorder.lastColumnOrder == NULL)) return;
+		reorder.data = pass->output;
+		reorder.fftDim = pass->fftDim;
+		reorder.offset = pass->outputOffset;
+		for (uint32_t i = 0; i < 3; i++) {
+			reorder.lineCount[i] = pass->lineCount[i];
+			reorder.lineStride[i] = pass->outputLineStride[i];
+		}
+		reorder.stride = pass->outputStride;
+		reorder.inverse = pass->inverse;
+		reorder.threadScratch = reorderScratch;
+		uint64_t numLines = (uint64_t)pass->lineCount[0] * pass->lineCount[1] * pass->lineCount[2];
+		reorder.linesPerTask = numLines / (4 * threadPool->numThreads);
+		if (reorder.linesPerTask == 0) reorder.linesPerTask = 1;
+		threadPool->run(VkFFTCPUReorderTask, &reorder, (uint32_t)((numLines + reorder.linesPerTask - 1) / reorder.linesPerTask));
+	}
+	static void VkFFTCPUFourStepTask(void* data, uint32_t taskID, uint32_t threadID) {
+		VkFFTApplication* app = (VkFFTApplication*)data;
+		app->VkFFTCPUFourStepLine(app->fourStepPass, taskID, threadID, true);
+	}
+	void VkFFTCPUFourStepLine(VkFFTCPUPass* pass, uint64_t t, uint32_t threadID, bool isSerial) {
+		//four step FFT of line t of the pass: fftDim = N1 * N2, columns n2 of N1 elements are transformed and multiplied by exp(+-2 pi i n2 k1 / fftDim), then rows k1 of N2 elements are transformed and stored to k1 + N1 * k2. Serial line is done by threadID alone, otherwise both passes are split between all threads
+		uint32_t N2 = 1 << ((uint32_t)log2(pass->fftDim) / 2);
+		uint32_t N1 = pass->fftDim / N2;
+		uint64_t elementStride = pass->inputStride;
+		uint64_t lineStart = pass->inputOffset + (t % pass->lineCount[0]) * pass->inputLineStride[0] + ((t / pass->lineCount[0]) % pass->lineCount[1]) * pass->inputLineStride[1] + (t / pass->lineCount[0] / pass->lineCount[1]) * pass->inputLineStride[2];
+		float* columnsResult = fourStepScratch[2 * threadID];
+		float* realLine = fourStepScratch[2 * threadID + 1];
+		VkFFTCPUPass columns = *pass;
+		columns.realTransform = 0;
+		columns.fftDim = N1;
+		columns.lineCount[0] = N2;
+		columns.lineCount[1] = 1;
+		columns.lineCount[2] = 1;
+		if (pass->realTransform == 2) {
+			//C2R: X[0..fftDim] of the line is turned into fftDim complex numbers before the inverse FFT
+			for (uint64_t n = 0; n <= pass->fftDim; n++) {
+				realLine[2 * n] = pass->input[2 * (lineStart + n * elementStride)];
+				realLine[2 * n + 1] = pass->input[2 * (lineStart + n * elementStride) + 1];
+			}
+			VkFFTCPURealProcess(realLine, realLine + 1, 2, pass->fftDim, pass->twiddles, 1, true);
+			columns.input = realLine;
+			columns.inputOffset = 0;
+			columns.inputLineStride[0] = 1;
+			columns.inputStride = N2;
+		}
+		else {
+			columns.inputOffset = lineStart;
+			columns.inputLineStride[0] = elementStride;
+			columns.inputStride = N2 * elementStride;
+		}
+		columns.maskLineFactor[0] = 1;
+		columns.maskElementFactor[0] = N2;
+		columns.output = columnsResult;
+		columns.outputOffset = 0;
+		columns.outputLineStride[0] = 1;
+		columns.outputStride = N2;
+		columns.outputRange[0] = 0;
+		columns.outputRange[1] = (uint64_t)-1;
+		columns.fourStepDim = pass->fftDim;
+		columns.scale = 1.0f;
+		VkFFTCPURunPass(&columns, isSerial, threadID);
+		VkFFTCPUPass rows = *pass;
+		rows.realTransform = 0;
+		rows.fftDim = N2;
+		rows.lineCount[0] = N1;
+		rows.lineCount[1] = 1;
+		rows.lineCount[2] = 1;
+		rows.input = columnsResult;
+		rows.inputOffset = 0;
+		rows.inputLineStride[0] = N2;
+		rows.inputStride = 1;
+		rows.inputRange[0] = 0;
+		rows.inputRange[1] = (uint64_t)-1;
+		if (pass->realTransform == 1) {
+			//R2C: the result of the FFT of fftDim complex numbers is turned into X[0..fftDim] after the second pass
+			rows.output = realLine;
+			rows.outputOffset = 0;
+			rows.outputLineStride[0] = 1;
+			rows.outputStride = N1;
+			VkFFTCPURunPass(&rows, isSerial, threadID);
+			VkFFTCPURealProcess(realLine, realLine + 1, 2, pass->fftDim, pass->twiddles, 1, false);
+			for (uint64_t n = 0; n <= pass->fftDim; n++) {
+				pass->output[2 * (lineStart + n * elementStride)] = realLine[2 * n];
+				pass->output[2 * (lineStart + n * elementStride) + 1] = realLine[2 * n + 1];
+			}
+		}
+		else {
+			rows.outputOffset = lineStart;
+			rows.outputLineStride[0] = elementStride;
+			rows.outputStride = N1 * elementStride;
+			rows.maskLineFactor[1] = 1;
+			rows.maskElementFactor[1] = N1;
+			VkFFTCPURunPass(&rows, isSerial, threadID);
+		}
+	}
+	void VkFFTCPUTransform(float* data, uint64_t numSystems, bool inverse) {
+		//axes are done in the order of VkFFTAppend: x, y, z for forward FFT and z, y, x for inverse
+		for (uint32_t i = 0; i < configuration.FFTdim; i++)
+			VkFFTCPUTransformAxis(data, numSystems, (inverse) ? configuration.FFTdim - 1 - i : i, inverse);
+	}
+	bool executeOnCPU(float* buffer, float* kernel = NULL, float* outputBuffer = NULL) {
+		//runs the plan of an application initialized without a Vulkan device on host memory with the layout of configuration.buffer. Results are in the order of VkFFTAppend on the configured device: axes it splits in several uploads are left in four step order, which the inverse FFT takes as input. Convolution reads numberBatches inputs from buffer and the kernel prepared by VkFFTConvolutionKernel::prepareConvolutionKernelOnCPU and stores numberKernels outputs per input batch to outputBuffer. NULL outputBuffer - in-place
+		if (!isCPUBackend) {
+			printf("executeOnCPU needs an application initialized without a Vulkan device, or with useCPU\n");
+			return false;
+		}
+		if ((configuration.isInputFormatted) || (configuration.isOutputFormatted)) {
+			printf("CPU backend supports only padded R2C buffers\n");
+			return false;
+		}
+		if (outputBuffer == NULL) outputBuffer = buffer;
+		uint64_t systemSize = VkFFTCPUSystemSize();
+		uint32_t coordinates = configuration.coordinateFeatures;
+		if (!configuration.performConvolution) {
+			uint64_t numSystems = (uint64_t)coordinates * configuration.numberBatches;
+			if (outputBuffer != buffer) memcpy(outputBuffer, buffer, numSystems * systemSize * sizeof(float));
+			VkFFTCPUTransform(outputBuffer, numSystems, configuration.inverse);
+			return true;
+		}
+		if (kernel == NULL) {
+			printf("Convolution on the CPU needs the kernel prepared by prepareConvolutionKernelOnCPU\n");
+			return false;
+		}
+		uint32_t N = configuration.matrixConvolution;
+		uint32_t numberKernels = (N > 1) ? 1 : configuration.numberKernels;
+		float** input = (float**)malloc(coordinates * sizeof(float*));
+		float** kernelSystems = (float**)malloc(coordinates * sizeof(float*));
+		VkFFTCPUConvolutionStep step = {};
+		step.input = input;
+		step.kernel = kernelSystems;
+		step.size = systemSize / 2;
+		step.elementsPerTask = (step.size + 4 * threadPool->numThreads - 1) / (4 * threadPool->numThreads);
+		if (step.elementsPerTask < 4096) step.elementsPerTask = 4096;
+		step.conjugateKernel = configuration.performCorrelation;
+		for (uint32_t b = 0; b < configuration.numberBatches; b++) {
+			//input batch is transformed in the scratch buffer, so in-place outputs don't overwrite coordinates that are still needed
+			memcpy(convolutionScratch, buffer + b * coordinates * systemSize, coordinates * systemSize * sizeof(float));
+			VkFFTCPUTransform(convolutionScratch, coordinates, false);
+			for (uint32_t f = 0; f < numberKernels; f++) {
+				for (uint32_t v = 0; v < coordinates; v++) {
+					//1x1: output coordinate v is input v times kernel f, coordinate v. NxN: output coordinate v is the sum over c of kernel[v][c] times input c, symmetric kernel stores only the upper triangle
+					step.numInputs = 0;
+					for (uint32_t c = 0; c < coordinates; c++) {
+						uint64_t kernelSystem;
+						if (N > 1) {
+							uint32_t row = (v < c) ? v : c;
+							uint32_t column = (v < c) ? c : v;
+							kernelSystem = (configuration.symmetricKernel) ? row * N - row * (row - 1) / 2 + column - row : v * N + c;
+						}
+						else {
+							if (c != v) continue;
+							kernelSystem = f * coordinates + v;
+						}
+						input[step.numInputs] = convolutionScratch + c * systemSize;
+						kernelSystems[step.numInputs] = kernel + kernelSystem * systemSize;
+						step.numInputs++;
+					}
+					step.output = outputBuffer + (((uint64_t)b * numberKernels + f) * coordinates + v) * systemSize;
+					threadPool->run(VkFFTCPUConvolutionTask, &step, (uint32_t)((step.size + step.elementsPerTask - 1) / step.elementsPerTask));
+				}
+			}
+			VkFFTCPUTransform(outputBuffer + (uint64_t)b * numberKernels * coordinates * systemSize, (uint64_t)numberKernels * coordinates, true);
+		}
+		free(input);
+		free(kernelSystems);
+		return true;
+	}
+#endif
+	VkResult VkFFTRecordCommandBuffer(VkCommandPool commandPool, VkCommandBufferLevel level, VkCommandBuffer* commandBuffer, uint32_t numberAppends = 1) {
+		//records numberAppends VkFFTAppend calls once into a new simultaneous use command buffer from commandPool. A primary is submitted directly, a secondary is executed with vkCmdExecuteCommands - both any number of times, also while pending, with no recording cost per call. Buffers of the configuration are baked into the descriptor sets, so the command buffer is valid until deleteVulkanFFT. Every pass ends with a barrier, so executions of the same command buffer can follow each other. Per-pass timestamps are not recorded
+#ifdef VKFFT_CPU_BACKEND
+		if (isCPUBackend) {
+			printf("Application was initialized without a Vulkan device, use executeOnCPU\n");
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+#endif
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = commandPool;
+		commandBufferAllocateInfo.level = level;
+		commandBufferAllocateInfo.commandBufferCount = 1;
+		VkResult res = vkAllocateCommandBuffers(configuration.device[0], &commandBufferAllocateInfo, commandBuffer);
+		if (res != VK_SUCCESS) return res;
+		//compute only secondary - no render pass is inherited
+		VkCommandBufferInheritanceInfo commandBufferInheritanceInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+		VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+		if (level == VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+			commandBufferBeginInfo.pInheritanceInfo = &commandBufferInheritanceInfo;
+		vkBeginCommandBuffer(commandBuffer[0], &commandBufferBeginInfo);
+		VkQueryPool* timestampQueryPool = configuration.timestampQueryPool;
+		configuration.timestampQueryPool = NULL;
+		for (uint32_t i = 0; i < numberAppends; i++)
+			VkFFTAppend(commandBuffer[0]);
+		configuration.timestampQueryPool = timestampQueryPool;
+		return vkEndCommandBuffer(commandBuffer[0]);
 	}
 	void VkFFTAppend(VkCommandBuffer commandBuffer) {
-		VkMemoryBarrier memory_barrier = {
-				VK_STRUCTURE_TYPE_MEMORY_BARRIER,
-				nullptr,
-				VK_ACCESS_SHADER_WRITE_BIT,
-				VK_ACCESS_SHADER_READ_BIT,
-		};
+#ifdef VKFFT_CPU_BACKEND
+		if (isCPUBackend) {
+			printf("Application was initialized without a Vulkan device, use executeOnCPU\n");
+			return;
+		}
+#endif
+		if ((!isDryRun) && (configuration.timestampQueryPool != NULL) && (passTimings != NULL) && (numTimestampQueries < configuration.timestampQueryCount)) {
+			//start of this VkFFTAppend - first pass is timed from here
+			vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, configuration.timestampQueryPool[0], numTimestampQueries);
+			lastTimestampQuery = numTimestampQueries;
+			numTimestampQueries++;
+		}
 		if (!configuration.inverse) {
 			//FFT axis 0
 			for (uint32_t j = 0; j < configuration.numberBatches; j++) {
 				for (int l = localFFTPlan.numAxisUploads[0]-1; l >=0; l--) {
 					VkFFTAxis* axis = &localFFTPlan.axes[0][l];
-					axis->pushConstants.batch = j;
+					if ((configuration.performConvolution) && (configuration.FFTdim == 1) && (l == 0)) {
+						//convolution step - batch is the number of kernels each input batch is multiplied by
+						axis->pushConstants.batch = (configuration.matrixConvolution == 1) ? configuration.numberKernels : 0;
+						axis->pushConstants.inputBatch = j;
+					}
+					else
+						axis->pushConstants.batch = j;
 					uint32_t maxCoordinate = ((configuration.matrixConvolution) > 1 && (configuration.performConvolution) && (configuration.FFTdim == 1)) ? 1 : configuration.coordinateFeatures;
 					for (uint32_t i = 0; i < maxCoordinate; i++) {
 						axis->pushConstants.coordinate = i;
-						vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-						vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-						vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+						VkFFTBindPass(commandBuffer, axis);
 						if (l == 0) {
 							if (configuration.performZeropadding[1]) {
 								if (configuration.performZeropadding[2]) {
 
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0 / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.zeropadInputRange[1][1] / 2.0), configuration.zeropadInputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.zeropadInputRange[1][1], configuration.zeropadInputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0 / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.zeropadInputRange[1][1] / 2.0), configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0) , configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.zeropadInputRange[1][1] , configuration.size[2]);
 								}
 							}
 							else {
 								if (configuration.performZeropadding[2]) {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0) , ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0) , configuration.zeropadInputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1] , ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1] , configuration.zeropadInputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0) , configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0) , configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.size[2]);
 								}
 							}
 						}
@@ -2651,34 +3750,34 @@ typedef struct VkFFTApplication {
 								if (configuration.performZeropadding[2]) {
 
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0 / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.zeropadInputRange[1][1] / 2.0), configuration.zeropadInputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.zeropadInputRange[1][1], configuration.zeropadInputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0 / 2.0), configuration.size[2] );
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.zeropadInputRange[1][1] / 2.0), configuration.size[2] );
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.zeropadInputRange[1][1], configuration.size[2]);
 								}
 							}
 							else {
 								if (configuration.performZeropadding[2]) {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0) , ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0) , configuration.zeropadInputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1] , ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1] , configuration.zeropadInputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0) , configuration.size[2] );
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0) , configuration.size[2] );
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1] , configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1] , configuration.size[2]);
 								}
 							}
 						}
 					}
-					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+					VkFFTPassBarrier(commandBuffer, axis);
 				}
 			}
 			
@@ -2744,33 +3843,36 @@ typedef struct VkFFTApplication {
 						for (int l = localFFTPlan.numSupportAxisUploads[0]-1; l >=0; l--) {
 							VkFFTAxis* axis = &localFFTPlan.supportAxes[0][l];
 							uint32_t maxCoordinate = ((configuration.matrixConvolution > 1)&&(l == 0)) ? 1 : configuration.coordinateFeatures;
-							for (uint32_t i = 0; i < maxCoordinate; i++) {
-								axis->pushConstants.coordinate = i;
+							for (uint32_t j = 0; j < configuration.numberBatches; j++) {
+								for (uint32_t i = 0; i < maxCoordinate; i++) {
+									axis->pushConstants.coordinate = i;
 								
-								axis->pushConstants.batch = ((l == 0)&& (configuration.matrixConvolution == 1)) ? configuration.numberKernels : 0;
+									axis->pushConstants.batch = (l == 0) ? ((configuration.matrixConvolution == 1) ? configuration.numberKernels : 0) : j;
+									axis->pushConstants.inputBatch = j;
 
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-								if (l == 0) {
-									if (configuration.performZeropadding[2]) {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
-									}
-									else {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
-									}
-								}
-								else{
-									if (configuration.performZeropadding[2]) {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, ceil(configuration.size[2] / 2.0));
+									VkFFTBindPass(commandBuffer, axis);
+									if (l == 0) {
+										if (configuration.performZeropadding[2]) {
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadInputRange[2][1]);
+										}
+										else {
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										}
 									}
-									else {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
+									else{
+										if (configuration.performZeropadding[2]) {
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.zeropadInputRange[2][1]);
+										}
+										else {
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
+										}
 									}
 								}
 							}
-							if (l >0)
-								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+							if (l > 0)
+								VkFFTPassBarrier(commandBuffer, axis);
+							else
+								VkFFTEndPass(commandBuffer, axis);
 
 						}
 						
@@ -2779,28 +3881,29 @@ typedef struct VkFFTApplication {
 					for (int l = localFFTPlan.numAxisUploads[1]-1; l >=0; l--) {
 						VkFFTAxis* axis = &localFFTPlan.axes[1][l];
 						uint32_t maxCoordinate = ((configuration.matrixConvolution > 1) && (l == 0)) ? 1 : configuration.coordinateFeatures;
-						for (uint32_t i = 0; i < maxCoordinate; i++) {
+						for (uint32_t j = 0; j < configuration.numberBatches; j++) {
+							for (uint32_t i = 0; i < maxCoordinate; i++) {
 
-							axis->pushConstants.coordinate = i;
-							axis->pushConstants.batch = ((l == 0) && (configuration.matrixConvolution == 1)) ? configuration.numberKernels : 0;
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-							if (configuration.performZeropadding[2]) {
-								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
-								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
-							}
-							else {
-								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
-								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
+								axis->pushConstants.coordinate = i;
+								axis->pushConstants.batch = (l == 0) ? ((configuration.matrixConvolution == 1) ? configuration.numberKernels : 0) : j;
+								axis->pushConstants.inputBatch = j;
+								VkFFTBindPass(commandBuffer, axis);
+								if (configuration.performZeropadding[2]) {
+									if (configuration.performR2C == true)
+										VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadInputRange[2][1]);
+									else
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadInputRange[2][1]);
+								}
+								else {
+									if (configuration.performR2C == true)
+										VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
+									else
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0]* configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
 
+								}
 							}
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 					
@@ -2843,28 +3946,26 @@ typedef struct VkFFTApplication {
 								axis->pushConstants.batch = j;
 								for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 									axis->pushConstants.coordinate = i;
-									vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+									VkFFTBindPass(commandBuffer, axis);
 									if (l == 0) {
 										if (configuration.performZeropadding[2]) {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil (configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadInputRange[2][1]);
 										}
 										else {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 										}
 									}
 									else {
 										if (configuration.performZeropadding[2]) {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.zeropadInputRange[2][1]);
 										}
 										else {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
 										}
 									}
 								}
 								if (l >=0)
-									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+									VkFFTPassBarrier(commandBuffer, axis);
 
 							}
 						}
@@ -2875,24 +3976,22 @@ typedef struct VkFFTApplication {
 							axis->pushConstants.batch = j;
 							for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 								axis->pushConstants.coordinate = i;
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+								VkFFTBindPass(commandBuffer, axis);
 								if (configuration.performZeropadding[2]) {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadInputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadInputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 
 								}
 							}
-							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+							VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
@@ -2973,19 +4072,20 @@ typedef struct VkFFTApplication {
 						for (int l = localFFTPlan.numSupportAxisUploads[1]-1; l >= 0; l--) {
 							VkFFTAxis* axis = &localFFTPlan.supportAxes[1][l];
 							uint32_t maxCoordinate = ((configuration.matrixConvolution > 1) && (l == 0)) ? 1 : configuration.coordinateFeatures;
-							for (uint32_t i = 0; i < maxCoordinate; i++) {
-								axis->pushConstants.coordinate = i;
+							for (uint32_t j = 0; j < configuration.numberBatches; j++) {
+								for (uint32_t i = 0; i < maxCoordinate; i++) {
+									axis->pushConstants.coordinate = i;
 								
-								axis->pushConstants.batch = ((l == 0) && (configuration.matrixConvolution == 1)) ? configuration.numberKernels : 0;
+									axis->pushConstants.batch = (l == 0) ? ((configuration.matrixConvolution == 1) ? configuration.numberKernels : 0) : j;
+									axis->pushConstants.inputBatch = j;
 
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-								vkCmdDispatch(commandBuffer, configuration.size[1] / axis->axisBlock[0]* configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
+									VkFFTBindPass(commandBuffer, axis);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->axisBlock[0]* configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
 
+								}
 							}
 							if (l >=0)
-								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+								VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
@@ -2994,19 +4094,20 @@ typedef struct VkFFTApplication {
 
 						VkFFTAxis* axis = &localFFTPlan.axes[2][l];
 						uint32_t maxCoordinate = ((configuration.matrixConvolution > 1) && (l == 0)) ? 1 : configuration.coordinateFeatures;
-						for (uint32_t i = 0; i < maxCoordinate; i++) {
-							axis->pushConstants.coordinate = i;
-							axis->pushConstants.batch = ((l == 0) && (configuration.matrixConvolution == 1)) ? configuration.numberKernels : 0;
+						for (uint32_t j = 0; j < configuration.numberBatches; j++) {
+							for (uint32_t i = 0; i < maxCoordinate; i++) {
+								axis->pushConstants.coordinate = i;
+								axis->pushConstants.batch = (l == 0) ? ((configuration.matrixConvolution == 1) ? configuration.numberKernels : 0) : j;
+								axis->pushConstants.inputBatch = j;
 
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
-							else
-								vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+								VkFFTBindPass(commandBuffer, axis);
+								if (configuration.performR2C == true)
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+								else
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+							}
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 					//}
@@ -3060,14 +4161,12 @@ typedef struct VkFFTApplication {
 								for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 									axis->pushConstants.coordinate = i;
 									
-									vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-									vkCmdDispatch(commandBuffer, configuration.size[1] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
+									VkFFTBindPass(commandBuffer, axis);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
 
 								}
 								if (l >= 0)
-									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+									VkFFTPassBarrier(commandBuffer, axis);
 
 							}
 						}
@@ -3078,15 +4177,13 @@ typedef struct VkFFTApplication {
 							axis->pushConstants.batch = j;
 							for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 								axis->pushConstants.coordinate = i;
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+								VkFFTBindPass(commandBuffer, axis);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
 							}
-							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+							VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
@@ -3102,7 +4199,7 @@ typedef struct VkFFTApplication {
 
 				//transpose 1-2, after 0-1
 				/*if (configuration.performTranspose[1]) {
-					for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+					for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 						localFFTPlan_inverse_convolution.transpose[1].pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							localFFTPlan_inverse_convolution.transpose[1].pushConstants.coordinate = i;
@@ -3130,7 +4227,7 @@ typedef struct VkFFTApplication {
 				}
 
 				if (configuration.performTranspose[0]) {
-					for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+					for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 						localFFTPlan_inverse_convolution.axes[1].pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							localFFTPlan_inverse_convolution.axes[1].pushConstants.coordinate = i;
@@ -3158,103 +4255,95 @@ typedef struct VkFFTApplication {
 				//multiple upload ifft leftovers
 				if (configuration.FFTdim == 3) {
 					if (configuration.performR2C == true) {
-						for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+						for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 							for (int l = 1; l< localFFTPlan_inverse_convolution.numSupportAxisUploads[1]; l++) {
 								VkFFTAxis* axis = &localFFTPlan_inverse_convolution.supportAxes[1][l];
 								uint32_t maxCoordinate = configuration.coordinateFeatures;
 								for (uint32_t i = 0; i < maxCoordinate; i++) {
 									axis->pushConstants.coordinate = i;
 									axis->pushConstants.batch = j;
-									vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-									vkCmdDispatch(commandBuffer, configuration.size[1] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
+									VkFFTBindPass(commandBuffer, axis);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
 
 								}
 								if (l > 0)
-									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+									VkFFTPassBarrier(commandBuffer, axis);
 
 							}
 						}
 					}
-					for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+					for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 						for (int l = 1; l <  localFFTPlan_inverse_convolution.numAxisUploads[2]; l++) {
 							VkFFTAxis* axis = &localFFTPlan_inverse_convolution.axes[2][l];
 							uint32_t maxCoordinate = configuration.coordinateFeatures;
 							for (uint32_t i = 0; i < maxCoordinate; i++) {
 								axis->pushConstants.coordinate = i;
 								axis->pushConstants.batch = j;
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+								VkFFTBindPass(commandBuffer, axis);
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
 							}
-							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+							VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
 				}
 				if (configuration.performR2C == true) {
-					for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+					for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 						for (int l = localFFTPlan_inverse_convolution.numSupportAxisUploads[0]-1; l >=0; l--) {
 							VkFFTAxis* axis = &localFFTPlan_inverse_convolution.supportAxes[0][l];
 							axis->pushConstants.batch = j;
 							for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 
 								axis->pushConstants.coordinate = i;
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+								VkFFTBindPass(commandBuffer, axis);
 								if (l == 0) {
 									if (configuration.performZeropadding[2]) {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 									}
 									else {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 									}
 								}
 								else {
 									if (configuration.performZeropadding[2]) {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.zeropadOutputRange[2][1]);
 									}
 									else {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
 									}
 								}
 							}
 							if (l >= 0)
-								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+								VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
 				}
-				for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+				for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 					for (int l = localFFTPlan_inverse_convolution.numAxisUploads[1]-1; l >= 0; l--) {
 						VkFFTAxis* axis = &localFFTPlan_inverse_convolution.axes[1][l];
 						axis->pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							axis->pushConstants.coordinate = i;
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+							VkFFTBindPass(commandBuffer, axis);
 							if (configuration.performZeropadding[2]) {
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 							}
 							else {
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2] );
 
 							}
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 				}
@@ -3268,7 +4357,7 @@ typedef struct VkFFTApplication {
 			if (configuration.FFTdim > 1) {
 				// transpose 0 - 1, if needed
 				/*if (configuration.performTranspose[0]) {
-					for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+					for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 						localFFTPlan_inverse_convolution.transpose[0].pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							localFFTPlan_inverse_convolution.transpose[0].pushConstants.coordinate = i;
@@ -3296,41 +4385,39 @@ typedef struct VkFFTApplication {
 				}*/
 				if (configuration.FFTdim == 2) {
 					if (configuration.performR2C == true) {
-						for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+						for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 							for (int l = 1; l< localFFTPlan_inverse_convolution.numSupportAxisUploads[0]; l++) {
 								VkFFTAxis* axis = &localFFTPlan_inverse_convolution.supportAxes[0][l];
 								uint32_t maxCoordinate = configuration.coordinateFeatures;
 								for (uint32_t i = 0; i < maxCoordinate; i++) {
 									axis->pushConstants.coordinate = i;
 									axis->pushConstants.batch = j;
-									vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-									vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-									vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+									VkFFTBindPass(commandBuffer, axis);
 									if (l == 0) {
 										if (configuration.performZeropadding[2]) {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 										}
 										else {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 										}
 									}
 									else {
 										if (configuration.performZeropadding[2]) {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.zeropadOutputRange[2][1]);
 										}
 										else {
-											vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
 										}
 									}
 								}
 								if (l > 0)
-									vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+									VkFFTPassBarrier(commandBuffer, axis);
 
 							}
 						}
 
 					}
-					for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+					for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 						for (int l = 1; l< localFFTPlan_inverse_convolution.numAxisUploads[1]; l++) {
 							VkFFTAxis* axis = &localFFTPlan_inverse_convolution.axes[1][l];
 							uint32_t maxCoordinate = configuration.coordinateFeatures;
@@ -3338,65 +4425,61 @@ typedef struct VkFFTApplication {
 
 								axis->pushConstants.coordinate = i;
 								axis->pushConstants.batch = j;
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+								VkFFTBindPass(commandBuffer, axis);
 								if (configuration.performZeropadding[2]) {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 
 								}
 							}
-							vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+							VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
 				}
-				for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+				for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 					for (int l = localFFTPlan_inverse_convolution.numAxisUploads[0]-1; l >= 0; l--) {
 						VkFFTAxis* axis = &localFFTPlan_inverse_convolution.axes[0][l];
 						axis->pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							axis->pushConstants.coordinate = i;
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+							VkFFTBindPass(commandBuffer, axis);
 							if (l == 0) {
 								if (configuration.performZeropadding[1]) {
 									if (configuration.performZeropadding[2]) {
 
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0 / 2.0), ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.zeropadOutputRange[2][1]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.zeropadOutputRange[1][1], configuration.zeropadOutputRange[2][1]);
 									}
 									else {
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0 / 2.0), configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.size[2]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.zeropadOutputRange[1][1], configuration.size[2]);
 									}
 								}
 								else {
 									if (configuration.performZeropadding[2]) {
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.zeropadOutputRange[2][1]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.zeropadOutputRange[2][1]);
 									}
 									else {
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.size[2]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.size[2]);
 									}
 								}
 							}
@@ -3405,35 +4488,35 @@ typedef struct VkFFTApplication {
 									if (configuration.performZeropadding[2]) {
 
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0 / 2.0), ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.zeropadOutputRange[2][1]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.zeropadOutputRange[1][1], configuration.zeropadOutputRange[2][1]);
 									}
 									else {
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0 / 2.0), configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.size[2]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.zeropadOutputRange[1][1], configuration.size[2]);
 									}
 								}
 								else {
 									if (configuration.performZeropadding[2]) {
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.zeropadOutputRange[2][1]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], ceil(configuration.size[2] / 2.0));
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], configuration.zeropadOutputRange[2][1]);
 									}
 									else {
 										if (configuration.performR2C == true)
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
 										else
-											vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], configuration.size[2]);
+											VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], configuration.size[2]);
 									}
 								}
 							}
 
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 				}
@@ -3441,7 +4524,7 @@ typedef struct VkFFTApplication {
 
 			}
 			if (configuration.FFTdim == 1) {
-				for (uint32_t j = 0; j < configuration.numberKernels; j++) {
+				for (uint32_t j = 0; j < configuration.numberKernels * configuration.numberBatches; j++) {
 					for (int l = 1; l < localFFTPlan_inverse_convolution.numAxisUploads[0]; l++) {
 						VkFFTAxis* axis = &localFFTPlan_inverse_convolution.axes[0][l];
 						uint32_t maxCoordinate = configuration.coordinateFeatures;
@@ -3449,24 +4532,22 @@ typedef struct VkFFTApplication {
 
 							axis->pushConstants.coordinate = i;
 							axis->pushConstants.batch = j;
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+							VkFFTBindPass(commandBuffer, axis);
 							if (configuration.performZeropadding[2]) {
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 							}
 							else {
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 
 							}
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 				}
@@ -3518,40 +4599,38 @@ typedef struct VkFFTApplication {
 						//didn't transpose 0-1, didn't transpose 1-2
 				if (configuration.performR2C == true) {
 					for (uint32_t j = 0; j < configuration.numberBatches; j++) {
-						for (int l = localFFTPlan.numSupportAxisUploads[1]-1; l >=0; l--) {
+						for (int l = 0; l < localFFTPlan.numSupportAxisUploads[1]; l++) {
 							VkFFTAxis* axis = &localFFTPlan.supportAxes[1][l];
 							axis->pushConstants.batch = j;
 							for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 								axis->pushConstants.coordinate = i;
 
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
-								vkCmdDispatch(commandBuffer, configuration.size[1] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
+								VkFFTBindPass(commandBuffer, axis);
+								VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, 1);
 
 							}
-							if (l >0)
-								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+							if (l < localFFTPlan.numSupportAxisUploads[1] - 1)
+								VkFFTPassBarrier(commandBuffer, axis);
+							else
+								VkFFTEndPass(commandBuffer, axis);
 
 						}
 					}
 				}
 				
 				for (uint32_t j = 0; j < configuration.numberBatches; j++) {
-					for (int l = localFFTPlan.numAxisUploads[2]-1; l >=0; l--) {
+					for (int l = 0; l < localFFTPlan.numAxisUploads[2]; l++) {
 						VkFFTAxis* axis = &localFFTPlan.axes[2][l];
 						axis->pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							axis->pushConstants.coordinate = i;
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+							VkFFTBindPass(commandBuffer, axis);
 							if (configuration.performR2C == true)
-								vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+								VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
 							else
-								vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
+								VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[2] / axis->specializationConstants.fftDim, 1, configuration.size[1]);
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 				}
@@ -3613,61 +4692,57 @@ typedef struct VkFFTApplication {
 				
 				if (configuration.performR2C == true) {
 					for (uint32_t j = 0; j < configuration.numberBatches; j++) {
-						for (int l = localFFTPlan.numSupportAxisUploads[0]-1; l >= 0; l--) {
+						for (int l = 0; l < localFFTPlan.numSupportAxisUploads[0]; l++) {
 							VkFFTAxis* axis = &localFFTPlan.supportAxes[0][l];
 							axis->pushConstants.batch = j;
 							for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 								axis->pushConstants.coordinate = i;
-								vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-								vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-								vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+								VkFFTBindPass(commandBuffer, axis);
 								if (l == 0) {
 									if (configuration.performZeropadding[2]) {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 									}
 									else {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 									}
 								}
 								else {
 									if (configuration.performZeropadding[2]) {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.zeropadOutputRange[2][1]);
 									}
 									else {
-										vkCmdDispatch(commandBuffer, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[1] / axis->specializationConstants.fftDim / axis->axisBlock[0], 1, configuration.size[2]);
 									}
 								}
 							}
 							if (l >= 0)
-								vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+								VkFFTPassBarrier(commandBuffer, axis);
 
 						}
 					}
 				}
 				for (uint32_t j = 0; j < configuration.numberBatches; j++) {
-					for (int l = localFFTPlan.numAxisUploads[1]-1; l >= 0; l--) {
+					for (int l = 0; l < localFFTPlan.numAxisUploads[1]; l++) {
 						VkFFTAxis* axis = &localFFTPlan.axes[1][l];
 						axis->pushConstants.batch = j;
 						for (uint32_t i = 0; i < configuration.coordinateFeatures; i++) {
 							axis->pushConstants.coordinate = i;
-							vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-							vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-							vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+							VkFFTBindPass(commandBuffer, axis);
 							if (configuration.performZeropadding[2]) {
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, ceil(configuration.size[2] / 2.0));
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.zeropadOutputRange[2][1]);
 							}
 							else {
 								if (configuration.performR2C == true)
-									vkCmdDispatch(commandBuffer, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+									VkFFTDispatch(commandBuffer, axis, ceil(configuration.size[0] / 2.0) / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 								else
-									vkCmdDispatch(commandBuffer, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
+									VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->axisBlock[0] * configuration.size[1] / axis->specializationConstants.fftDim, 1, configuration.size[2]);
 
 							}
 						}
-						vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+						VkFFTPassBarrier(commandBuffer, axis);
 
 					}
 				}
@@ -3705,43 +4780,41 @@ typedef struct VkFFTApplication {
 			}
 			//FFT axis 0
 			for (uint32_t j = 0; j < configuration.numberBatches; j++) {
-				for (int l = localFFTPlan.numAxisUploads[0]-1; l >=0; l--) {
+				for (int l = 0; l < localFFTPlan.numAxisUploads[0]; l++) {
 					VkFFTAxis* axis = &localFFTPlan.axes[0][l];
 					axis->pushConstants.batch = j;
 					uint32_t maxCoordinate = ((configuration.matrixConvolution) > 1 && (configuration.performConvolution) && (configuration.FFTdim == 1)) ? 1 : configuration.coordinateFeatures;
 					for (uint32_t i = 0; i < maxCoordinate; i++) {
 						axis->pushConstants.coordinate = i;
-						vkCmdPushConstants(commandBuffer, axis->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(VkFFTPushConstantsLayout), &axis->pushConstants);
-						vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipeline);
-						vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, axis->pipelineLayout, 0, 1, &axis->descriptorSet, 0, NULL);
+						VkFFTBindPass(commandBuffer, axis);
 						if (l == 0) {
 							if (configuration.performZeropadding[1]) {
 								if (configuration.performZeropadding[2]) {
 
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0 / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.zeropadOutputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.zeropadOutputRange[1][1], configuration.zeropadOutputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0 / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.zeropadOutputRange[1][1], configuration.size[2]);
 								}
 							}
 							else {
 								if (configuration.performZeropadding[2]) {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.zeropadOutputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.zeropadOutputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, ceil(configuration.size[1] / 2.0), configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim, configuration.size[1], configuration.size[2]);
 								}
 							}
 						}
@@ -3750,43 +4823,57 @@ typedef struct VkFFTApplication {
 								if (configuration.performZeropadding[2]) {
 
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0 / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.zeropadOutputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.zeropadOutputRange[1][1], configuration.zeropadOutputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0 / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.zeropadOutputRange[1][1] / 2.0), configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.zeropadOutputRange[1][1], configuration.size[2]);
 								}
 							}
 							else {
 								if (configuration.performZeropadding[2]) {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.zeropadOutputRange[2][1]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], ceil(configuration.size[2] / 2.0));
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], configuration.zeropadOutputRange[2][1]);
 								}
 								else {
 									if (configuration.performR2C == true)
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], ceil(configuration.size[1] / 2.0), configuration.size[2]);
 									else
-										vkCmdDispatch(commandBuffer, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], configuration.size[2]);
+										VkFFTDispatch(commandBuffer, axis, configuration.size[0] / axis->specializationConstants.fftDim / axis->axisBlock[0], configuration.size[1], configuration.size[2]);
 								}
 							}
 						}
 					}
-					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+					VkFFTPassBarrier(commandBuffer, axis);
 
 				}
 			}
 			
 
 		}
-
+		//barrier after the last pass, unless the caller synchronizes
+		if (configuration.externalSynchronization)
+			pendingBarrierAxis = NULL;
+		else
+			VkFFTRecordBarrier(commandBuffer);
 	}
 	void deleteVulkanFFT() {
+		if (passTimings != NULL) {
+			free(passTimings);
+			passTimings = NULL;
+		}
+#ifdef VKFFT_CPU_BACKEND
+		if (isCPUBackend) {
+			VkFFTDeleteCPU();
+			return;
+		}
+#endif
 		for (uint32_t i = 0; i < configuration.FFTdim; i++) {
 			for (uint32_t j = 0; j < localFFTPlan.numAxisUploads[i]; j++)
 				deleteAxis(&localFFTPlan.axes[i][j]);
@@ -3816,3 +4903,896 @@ typedef struct VkFFTApplication {
 		}
 	}
 };
+typedef struct VkFFTConvolutionKernel {
+	//Transforms convolution kernel once and keeps it in the kernel buffer of the convolution configuration, in the compact layout read by convolution shaders
+	VkFFTConfiguration configuration = {}; //forward FFT configuration of the kernel, derived from the convolution configuration
+	VkFFTApplication app_kernel = {};
+	bool isPrepared = false; //kernel buffer holds the transformed kernel. Set by markPrepared once the transform has executed and reset only by initializeConvolutionKernel, so the kernel can be reused by any number of convolutions
+	uint32_t getKernelCoordinates(VkFFTConfiguration convolutionConfiguration) {
+		//number of systems stored in the kernel: NxN matrix convolution - N*N coordinates, or only the upper triangle N*(N+1)/2 for symmetric kernel. 1x1 convolution - coordinateFeatures per kernel
+		if (convolutionConfiguration.matrixConvolution > 1) {
+			uint32_t N = convolutionConfiguration.matrixConvolution;
+			return (convolutionConfiguration.symmetricKernel) ? N * (N + 1) / 2 : N * N;
+		}
+		return convolutionConfiguration.coordinateFeatures;
+	}
+	VkDeviceSize getKernelBufferSize(VkFFTConfiguration convolutionConfiguration) {
+		VkDeviceSize systemSize = (convolutionConfiguration.performR2C) ? (convolutionConfiguration.size[0] / 2 + 1) : convolutionConfiguration.size[0];
+		for (uint32_t i = 1; i < convolutionConfiguration.FFTdim; i++)
+			systemSize *= convolutionConfiguration.size[i];
+		uint32_t numberKernels = (convolutionConfiguration.matrixConvolution > 1) ? 1 : convolutionConfiguration.numberKernels;
+		return numberKernels * getKernelCoordinates(convolutionConfiguration) * systemSize * 2 * sizeof(float);
+	}
+	VkResult initializeConvolutionKernel(VkFFTConfiguration convolutionConfiguration) {
+		//kernel buffer is filled with the kernel in the same layout as input data (with R2C padding, if used), it is transformed in-place
+		configuration = convolutionConfiguration;
+		configuration.performConvolution = false;
+		configuration.performCorrelation = false;
+		configuration.inverse = false;
+		configuration.matrixConvolution = 1;
+		configuration.symmetricKernel = false;
+		configuration.coordinateFeatures = getKernelCoordinates(convolutionConfiguration);
+		configuration.numberBatches = (convolutionConfiguration.matrixConvolution > 1) ? 1 : convolutionConfiguration.numberKernels;
+		configuration.numberKernels = 1;
+		for (uint32_t i = 0; i < 3; i++)
+			configuration.performOutputPruning[i] = false;
+		configuration.isInputFormatted = false;
+		configuration.isOutputFormatted = false;
+		configuration.buffer = convolutionConfiguration.kernel;
+		configuration.inputBuffer = convolutionConfiguration.kernel;
+		configuration.outputBuffer = convolutionConfiguration.kernel;
+		configuration.bufferSize = convolutionConfiguration.kernelSize;
+		configuration.inputBufferSize = convolutionConfiguration.kernelSize;
+		configuration.outputBufferSize = convolutionConfiguration.kernelSize;
+		isPrepared = false;
+		if (configuration.bufferSize[0] < getKernelBufferSize(convolutionConfiguration)) {
+			//the in-place kernel transform would write past the end of the buffer
+			printf("Kernel buffer size %lu is smaller than needed %lu\n", (unsigned long)configuration.bufferSize[0], (unsigned long)getKernelBufferSize(convolutionConfiguration));
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		return app_kernel.initializeVulkanFFT(configuration);
+	}
+	void appendConvolutionKernelPreparation(VkCommandBuffer commandBuffer) {
+		//records the transform until markPrepared is called - record it in one command buffer only, as the transform is done in-place
+		if (isPrepared) return;
+		app_kernel.VkFFTAppend(commandBuffer);
+	}
+	void markPrepared() {
+		//call after the command buffer with appendConvolutionKernelPreparation has finished execution (e.g. after its fence is signaled)
+		isPrepared = true;
+	}
+#ifdef VKFFT_CPU_BACKEND
+	bool prepareConvolutionKernelOnCPU(float* kernel) {
+		//CPU backend counterpart of appendConvolutionKernelPreparation - kernel is host memory in the layout of the kernel buffer, transformed in-place once
+		if (isPrepared) return true;
+		isPrepared = app_kernel.executeOnCPU(kernel);
+		return isPrepared;
+	}
+#endif
+	void deleteConvolutionKernel() {
+		app_kernel.deleteVulkanFFT();
+	}
+} VkFFTConvolutionKernel;
+typedef struct VkFFTStreamingConvolution {
+	//Overlap-save convolution of a stream, longer than one FFT, with a FIR kernel. Built on top of single upload 1D C2C convolution application
+	VkFFTConfiguration configuration = {}; //1D C2C convolution configuration. size[0] - FFT block size, buffer - work buffer of (size[0] + kernelLength - 1) complex numbers: first size[0] - FFT work area, last kernelLength - 1 - overlap tail kept on device between blocks. kernel - forward FFT of the kernel zeropadded to size[0]
+	VkFFTApplication app_convolution = {};
+	uint32_t kernelLength = 1; //FIR kernel length in time domain. Consecutive blocks overlap by kernelLength - 1 samples
+	uint32_t blockLength = 0; //number of new samples consumed and filtered samples emitted per block, equal to size[0] - kernelLength + 1
+	uint32_t numberRingBlocks = 1; //number of blocks in the ring buffer
+	uint32_t currentBlock = 0; //ring slot to be processed next
+	VkBuffer* ringBuffer; //numberRingBlocks * blockLength complex numbers. Filtered block is written to the same slot its input was read from
+
+	void streamingBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStage, VkAccessFlags srcAccess, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+		VkMemoryBarrier memory_barrier = {
+				VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+				nullptr,
+				srcAccess,
+				dstAccess,
+		};
+		vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &memory_barrier, 0, NULL, 0, NULL);
+	}
+	VkResult initializeStreamingConvolution(VkFFTConfiguration inputLaunchConfiguration, uint32_t inputKernelLength, VkBuffer* inputRingBuffer, uint32_t inputNumberRingBlocks) {
+		configuration = inputLaunchConfiguration;
+		kernelLength = inputKernelLength;
+		ringBuffer = inputRingBuffer;
+		numberRingBlocks = inputNumberRingBlocks;
+		currentBlock = 0;
+		if ((configuration.FFTdim != 1) || (!configuration.performConvolution) || (configuration.performR2C) || (configuration.matrixConvolution > 1) || (configuration.coordinateFeatures != 1)) {
+			printf("Streaming convolution requires 1D C2C 1x1 convolution configuration with one coordinate\n");
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		if (kernelLength == 0) kernelLength = 1;
+		if (kernelLength > configuration.size[0] / 2 + 1) {
+			//overlap tail is taken from the current input block, so it has to fit in it
+			printf("Streaming convolution kernel length %d is bigger than half of the block FFT size %d, it will be clamped\n", kernelLength, configuration.size[0]);
+			kernelLength = configuration.size[0] / 2 + 1;
+		}
+		blockLength = configuration.size[0] - kernelLength + 1;
+		if (numberRingBlocks == 0) numberRingBlocks = 1;
+		configuration.inputBuffer = configuration.buffer;
+		configuration.outputBuffer = configuration.buffer;
+		VkResult res = app_convolution.initializeVulkanFFT(configuration);
+		if (res != VK_SUCCESS) {
+			app_convolution.deleteVulkanFFT();
+			return res;
+		}
+		if (app_convolution.localFFTPlan.numAxisUploads[0] > 1) {
+			printf("Streaming convolution block FFT size %d doesn't fit in one upload\n", configuration.size[0]);
+			app_convolution.deleteVulkanFFT();
+			return VK_ERROR_INITIALIZATION_FAILED;
+		}
+		return VK_SUCCESS;
+	}
+	void resetStreamingConvolution(VkCommandBuffer commandBuffer) {
+		//clear stream history - first block is convolved as if it was preceded by zeros
+		currentBlock = 0;
+		if (kernelLength > 1) {
+			vkCmdFillBuffer(commandBuffer, configuration.buffer[0], configuration.size[0] * 2 * sizeof(float), (kernelLength - 1) * 2 * sizeof(float), 0);
+			streamingBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+		}
+	}
+	void appendStreamingConvolution(VkCommandBuffer commandBuffer, uint32_t numBlocks) {
+		//records filtering of numBlocks consecutive ring slots, starting from currentBlock. Recording all blocks of a chunk in one command buffer allows one submit per chunk
+		VkDeviceSize complexSize = 2 * sizeof(float);
+		VkDeviceSize tailOffset = configuration.size[0] * complexSize;
+		for (uint32_t b = 0; b < numBlocks; b++) {
+			VkDeviceSize ringOffset = currentBlock * blockLength * complexSize;
+			VkBufferCopy copyRegion = {};
+			//work area = [tail of the previous block, new block]
+			if (kernelLength > 1) {
+				copyRegion.srcOffset = tailOffset;
+				copyRegion.dstOffset = 0;
+				copyRegion.size = (kernelLength - 1) * complexSize;
+				vkCmdCopyBuffer(commandBuffer, configuration.buffer[0], configuration.buffer[0], 1, &copyRegion);
+			}
+			copyRegion.srcOffset = ringOffset;
+			copyRegion.dstOffset = (kernelLength - 1) * complexSize;
+			copyRegion.size = blockLength * complexSize;
+			vkCmdCopyBuffer(commandBuffer, ringBuffer[0], configuration.buffer[0], 1, &copyRegion);
+			if (kernelLength > 1) {
+				//save new tail before the slot is overwritten with the filtered block
+				streamingBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+				copyRegion.srcOffset = ringOffset + (blockLength - kernelLength + 1) * complexSize;
+				copyRegion.dstOffset = tailOffset;
+				copyRegion.size = (kernelLength - 1) * complexSize;
+				vkCmdCopyBuffer(commandBuffer, ringBuffer[0], configuration.buffer[0], 1, &copyRegion);
+			}
+			streamingBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+			app_convolution.VkFFTAppend(commandBuffer);
+			streamingBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+			//first kernelLength - 1 outputs are corrupted by circular wrap-around, the rest is the linear convolution of the new block
+			copyRegion.srcOffset = (kernelLength - 1) * complexSize;
+			copyRegion.dstOffset = ringOffset;
+			copyRegion.size = blockLength * complexSize;
+			vkCmdCopyBuffer(commandBuffer, configuration.buffer[0], ringBuffer[0], 1, &copyRegion);
+			streamingBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT);
+			currentBlock = (currentBlock + 1) % numberRingBlocks;
+		}
+	}
+	void deleteStreamingConvolution() {
+		app_convolution.deleteVulkanFFT();
+	}
+} VkFFTStreamingConvolution;
+static bool VkFFTAllocateBuffer(VkDevice device, VkPhysicalDevice physicalDevice, VkBuffer* buffer, VkDeviceMemory* deviceMemory, VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags preferredFlags, VkMemoryPropertyFlags requiredFlags, VkDeviceSize size, uint32_t numQueueFamilies = 0, const uint32_t* queueFamilyIndices = NULL) {
+	//buffer with its own memory allocation for the helpers below. Memory type with preferredFlags is used if available, otherwise any with requiredFlags. Buffers used by queues of different families are created with concurrent sharing
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if ((numQueueFamilies > 1) && (queueFamilyIndices[0] != queueFamilyIndices[1])) {
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		bufferCreateInfo.queueFamilyIndexCount = numQueueFamilies;
+		bufferCreateInfo.pQueueFamilyIndices = queueFamilyIndices;
+	}
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usageFlags;
+	if (vkCreateBuffer(device, &bufferCreateInfo, NULL, buffer) != VK_SUCCESS) {
+		printf("Buffer creation failed\n");
+		return false;
+	}
+	VkMemoryRequirements memoryRequirements = {};
+	vkGetBufferMemoryRequirements(device, buffer[0], &memoryRequirements);
+	VkPhysicalDeviceMemoryProperties memoryProperties = {};
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+	VkMemoryPropertyFlags propertyFlags[2] = { preferredFlags | requiredFlags, requiredFlags };
+	uint32_t memoryTypeIndex = (uint32_t)-1;
+	for (uint32_t p = 0; (p < 2) && (memoryTypeIndex == (uint32_t)-1); p++) {
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+			if ((memoryRequirements.memoryTypeBits & (1 << i)) && ((memoryProperties.memoryTypes[i].propertyFlags & propertyFlags[p]) == propertyFlags[p])) {
+				memoryTypeIndex = i;
+				break;
+			}
+		}
+	}
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.allocationSize = memoryRequirements.size;
+	memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+	if ((memoryTypeIndex == (uint32_t)-1) || (vkAllocateMemory(device, &memoryAllocateInfo, NULL, deviceMemory) != VK_SUCCESS)) {
+		printf("Could not allocate %lu bytes of memory\n", (unsigned long)memoryRequirements.size);
+		vkDestroyBuffer(device, buffer[0], NULL);
+		return false;
+	}
+	vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
+	return true;
+}
+static VkDeviceSize VkFFTGetHostImportAlignment(VkPhysicalDevice physicalDevice) {
+	//pointer and size of host memory imported with VK_EXT_external_memory_host have to be multiples of it. Queried with vkGetPhysicalDeviceProperties2 (Vulkan 1.1 instance), otherwise the page size is assumed
+	VkPhysicalDeviceProperties properties = {};
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	if (properties.apiVersion < VK_API_VERSION_1_1) return 4096;
+	VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT };
+	VkPhysicalDeviceProperties2 properties2 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+	properties2.pNext = &hostProperties;
+	vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+	return (hostProperties.minImportedHostPointerAlignment > 0) ? hostProperties.minImportedHostPointerAlignment : 4096;
+}
+static bool VkFFTImportHostBuffer(VkDevice device, VkPhysicalDevice physicalDevice, void* hostPointer, VkDeviceSize size, VkBufferUsageFlags usageFlags, VkBuffer* buffer, VkDeviceMemory* deviceMemory, uint32_t numQueueFamilies = 0, const uint32_t* queueFamilyIndices = NULL) {
+	//wraps an existing host allocation in a VkBuffer with VK_EXT_external_memory_host (has to be enabled on the device), without a copy. The buffer can be used as inputBuffer of an application, read directly by the shaders over the bus, or as the source of a device copy instead of a staging buffer. Host memory has to stay allocated until the buffer and memory are destroyed
+	VkDeviceSize alignment = VkFFTGetHostImportAlignment(physicalDevice);
+	if ((((uintptr_t)hostPointer) % alignment != 0) || (size % alignment != 0)) {
+		printf("Imported host pointer and size have to be aligned to %lu bytes\n", (unsigned long)alignment);
+		return false;
+	}
+	PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties = (PFN_vkGetMemoryHostPointerPropertiesEXT)vkGetDeviceProcAddr(device, "vkGetMemoryHostPointerPropertiesEXT");
+	if (getMemoryHostPointerProperties == NULL) {
+		printf("VK_EXT_external_memory_host is not enabled on the device\n");
+		return false;
+	}
+	VkMemoryHostPointerPropertiesEXT hostPointerProperties = { VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT };
+	if (getMemoryHostPointerProperties(device, (VkExternalMemoryHandleTypeFlagBits)VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT, hostPointer, &hostPointerProperties) != VK_SUCCESS) {
+		printf("Host pointer can not be imported\n");
+		return false;
+	}
+	VkExternalMemoryBufferCreateInfo externalMemoryBufferCreateInfo = { VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+	externalMemoryBufferCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+	VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+	bufferCreateInfo.pNext = &externalMemoryBufferCreateInfo;
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	if ((numQueueFamilies > 1) && (queueFamilyIndices[0] != queueFamilyIndices[1])) {
+		bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		bufferCreateInfo.queueFamilyIndexCount = numQueueFamilies;
+		bufferCreateInfo.pQueueFamilyIndices = queueFamilyIndices;
+	}
+	bufferCreateInfo.size = size;
+	bufferCreateInfo.usage = usageFlags;
+	if (vkCreateBuffer(device, &bufferCreateInfo, NULL, buffer) != VK_SUCCESS) {
+		printf("Buffer creation failed\n");
+		return false;
+	}
+	VkMemoryRequirements memoryRequirements = {};
+	vkGetBufferMemoryRequirements(device, buffer[0], &memoryRequirements);
+	uint32_t memoryTypeBits = memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+	uint32_t memoryTypeIndex = 0;
+	while ((memoryTypeIndex < 32) && (!(memoryTypeBits & (1 << memoryTypeIndex)))) memoryTypeIndex++;
+	VkImportMemoryHostPointerInfoEXT importMemoryHostPointerInfo = { VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT };
+	importMemoryHostPointerInfo.handleType = (VkExternalMemoryHandleTypeFlagBits)VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+	importMemoryHostPointerInfo.pHostPointer = hostPointer;
+	VkMemoryAllocateInfo memoryAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+	memoryAllocateInfo.pNext = &importMemoryHostPointerInfo;
+	memoryAllocateInfo.allocationSize = size;
+	memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+	if ((memoryTypeIndex == 32) || (vkAllocateMemory(device, &memoryAllocateInfo, NULL, deviceMemory) != VK_SUCCESS)) {
+		printf("Host memory import failed\n");
+		vkDestroyBuffer(device, buffer[0], NULL);
+		return false;
+	}
+	vkBindBufferMemory(device, buffer[0], deviceMemory[0], 0);
+	return true;
+}
+typedef struct VkFFTStagingPool {
+	//Persistent host visible staging memory for host<->device transfers. Staging buffer is split in numberSlots ring slots of slotSize bytes, each with its own reusable command buffer and fence. Transfers bigger than a slot are streamed through the ring, so memcpy of one slot overlaps with the copy of the others and peak host visible memory is numberSlots * slotSize, independent of the transfer size
+	VkDevice* device;
+	VkPhysicalDevice* physicalDevice;
+	VkQueue* queue;
+	VkCommandPool* commandPool; //has to be created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+	VkDeviceSize slotSize = 0;
+	uint32_t numberSlots = 0;
+	uint32_t currentSlot = 0; //ring slot used by the next chunk
+	VkBuffer stagingBuffer = {};
+	VkDeviceMemory stagingBufferDeviceMemory = {};
+	char* stagingData = NULL; //staging buffer, mapped for the lifetime of the pool
+	VkCommandBuffer* commandBuffers = NULL;
+	VkFence* fences = NULL;
+	bool* isPending = NULL; //slot has a submitted copy that was not waited on yet
+
+	bool initializeStagingPool(VkDevice* inputDevice, VkPhysicalDevice* inputPhysicalDevice, VkQueue* inputQueue, VkCommandPool* inputCommandPool, VkDeviceSize inputSlotSize, uint32_t inputNumberSlots) {
+		//all allocations are done here, transfers only reuse them
+		device = inputDevice;
+		physicalDevice = inputPhysicalDevice;
+		queue = inputQueue;
+		commandPool = inputCommandPool;
+		numberSlots = (inputNumberSlots > 0) ? inputNumberSlots : 1;
+		slotSize = (inputSlotSize + 255) / 256 * 256; //keeps slot offsets aligned for any element type
+		currentSlot = 0;
+		//host cached memory is preferred, as downloads are read by memcpy
+		if (!VkFFTAllocateBuffer(device[0], physicalDevice[0], &stagingBuffer, &stagingBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_CACHED_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, slotSize * numberSlots)) {
+			printf("Staging pool could not be allocated\n");
+			return false;
+		}
+		vkMapMemory(device[0], stagingBufferDeviceMemory, 0, slotSize * numberSlots, 0, (void**)&stagingData);
+		commandBuffers = (VkCommandBuffer*)malloc(numberSlots * sizeof(VkCommandBuffer));
+		fences = (VkFence*)malloc(numberSlots * sizeof(VkFence));
+		isPending = (bool*)malloc(numberSlots * sizeof(bool));
+		VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+		commandBufferAllocateInfo.commandPool = commandPool[0];
+		commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocateInfo.commandBufferCount = numberSlots;
+		vkAllocateCommandBuffers(device[0], &commandBufferAllocateInfo, commandBuffers);
+		VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+		for (uint32_t i = 0; i < numberSlots; i++) {
+			vkCreateFence(device[0], &fenceCreateInfo, NULL, &fences[i]);
+			isPending[i] = false;
+		}
+		return true;
+	}
+	void waitSlot(uint32_t slot) {
+		if (!isPending[slot]) return;
+		vkWaitForFences(device[0], 1, &fences[slot], VK_TRUE, 100000000000);
+		vkResetFences(device[0], 1, &fences[slot]);
+		isPending[slot] = false;
+	}
+	void waitStagingPool() {
+		//all copies submitted through the pool are complete after this call
+		for (uint32_t i = 0; i < numberSlots; i++)
+			waitSlot(i);
+	}
+	void submitSlot(uint32_t slot, VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize srcOffset, VkDeviceSize dstOffset, VkDeviceSize size) {
+		//command buffer of the slot is re-recorded with one copy - recording a copy is cheap, allocation is what the pool avoids
+		VkCommandBuffer commandBuffer = commandBuffers[slot];
+		vkResetCommandBuffer(commandBuffer, 0);
+		VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+		VkBufferCopy copyRegion = {};
+		copyRegion.srcOffset = srcOffset;
+		copyRegion.dstOffset = dstOffset;
+		copyRegion.size = size;
+		vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
+		vkEndCommandBuffer(commandBuffer);
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		vkQueueSubmit(queue[0], 1, &submitInfo, fences[slot]);
+		isPending[slot] = true;
+	}
+	void transferDataFromCPU(const void* data, VkBuffer* buffer, VkDeviceSize size, VkDeviceSize bufferOffset = 0) {
+		//upload of size bytes to buffer at bufferOffset. Returns when the data is in the buffer
+		const char* src = (const char*)data;
+		for (VkDeviceSize offset = 0; offset < size; offset += slotSize) {
+			VkDeviceSize chunkSize = (size - offset < slotSize) ? size - offset : slotSize;
+			uint32_t slot = currentSlot;
+			waitSlot(slot);
+			memcpy(stagingData + slot * slotSize, src + offset, chunkSize);
+			submitSlot(slot, stagingBuffer, buffer[0], slot * slotSize, bufferOffset + offset, chunkSize);
+			currentSlot = (currentSlot + 1) % numberSlots;
+		}
+		waitStagingPool();
+	}
+	void transferDataToCPU(void* data, VkBuffer* buffer, VkDeviceSize size, VkDeviceSize bufferOffset = 0) {
+		//download of size bytes from buffer at bufferOffset. Copies of the next numberSlots - 1 chunks are in flight while a chunk is read from the staging memory
+		char* dst = (char*)data;
+		waitStagingPool();
+		uint64_t numChunks = (size + slotSize - 1) / slotSize;
+		uint64_t numSubmitted = 0;
+		for (uint64_t i = 0; i < numChunks; i++) {
+			for (; (numSubmitted < numChunks) && (numSubmitted < i + numberSlots); numSubmitted++) {
+				VkDeviceSize offset = numSubmitted * slotSize;
+				VkDeviceSize chunkSize = (size - offset < slotSize) ? size - offset : slotSize;
+				uint32_t slot = (currentSlot + numSubmitted) % numberSlots;
+				submitSlot(slot, buffer[0], stagingBuffer, bufferOffset + offset, slot * slotSize, chunkSize);
+			}
+			VkDeviceSize offset = i * slotSize;
+			VkDeviceSize chunkSize = (size - offset < slotSize) ? size - offset : slotSize;
+			uint32_t slot = (currentSlot + i) % numberSlots;
+			waitSlot(slot);
+			memcpy(dst + offset, stagingData + slot * slotSize, chunkSize);
+		}
+		currentSlot = (currentSlot + numChunks) % numberSlots;
+	}
+	void deleteStagingPool() {
+		if (stagingData == NULL) return;
+		waitStagingPool();
+		for (uint32_t i = 0; i < numberSlots; i++)
+			vkDestroyFence(device[0], fences[i], NULL);
+		vkFreeCommandBuffers(device[0], commandPool[0], numberSlots, commandBuffers);
+		vkUnmapMemory(device[0], stagingBufferDeviceMemory);
+		vkDestroyBuffer(device[0], stagingBuffer, NULL);
+		vkFreeMemory(device[0], stagingBufferDeviceMemory, NULL);
+		free(commandBuffers);
+		free(fences);
+		free(isPending);
+		stagingData = NULL;
+	}
+} VkFFTStagingPool;
+typedef struct {
+	double time; //ms, from the first upload to the last download
+	double throughput; //GB/s of host data streamed through the device - input and output bytes per second
+	uint64_t numberChunks;
+	uint64_t bytesUploaded;
+	uint64_t bytesDownloaded;
+} VkFFTStreamingStatistics;
+typedef struct VkFFTStreamingExecutor {
+	//Pipelined FFT of a host dataset with more batches than fit in one device buffer. Batches are split in chunks of configuration.numberBatches. Each of numberSlots slots has its own device buffer, application, staging memory and pre-recorded upload, compute and download command buffers, so upload of chunk i+1, VkFFTAppend of chunk i and download of chunk i-1 run concurrently on the transfer and compute queues. Chunks are ordered by semaphores, slots are reused after their download fence
+	VkFFTConfiguration configuration = {}; //configuration of one chunk, in-place. device, physicalDevice and queue (compute) are required, buffers are allocated by the executor. With VKFFT_CPU_BACKEND and without device the chunks are transformed by the CPU backend - host-only stand-in of the pipeline with the same chunking
+	VkQueue* transferQueue = NULL; //queue for uploads and downloads, can be the compute queue
+	uint32_t queueFamilyIndices[2] = { 0,0 }; //compute and transfer queue families
+	uint32_t numberSlots = 0;
+	bool isCPUBackend = false;
+	VkDeviceSize chunkSize = 0; //bytes of one chunk
+	VkDeviceSize batchSize = 0; //bytes of one batch in the host arrays
+	VkFFTApplication* apps = NULL;
+	VkBuffer* buffers = NULL;
+	VkDeviceMemory* bufferDeviceMemory = NULL;
+	VkBuffer stagingBuffer = {}; //upload area of chunkSize per slot, followed by download area of chunkSize per slot
+	VkDeviceMemory stagingBufferDeviceMemory = {};
+	char* stagingData = NULL;
+	VkCommandPool commandPools[2] = {}; //compute and transfer
+	VkCommandBuffer* commandBuffers = NULL; //upload, compute and download per slot. Transfer only runs submit the same download, waiting on the upload semaphore
+	VkSemaphore* semaphores = NULL; //upload done and compute done per slot
+	VkFence* fences = NULL; //download done per slot
+	uint64_t* pendingChunks = NULL; //chunk downloaded in the slot and not copied to the output yet, (uint64_t)-1 - none
+	float* cpuChunk = NULL;
+	void (*packChunk)(void* userData, uint64_t chunk, uint64_t chunkBatches, char* data) = NULL; //optional gather of the chunk from host memory into data, for chunks that are not contiguous in the input. NULL - chunks are copied from input
+	void (*unpackChunk)(void* userData, uint64_t chunk, uint64_t chunkBatches, const char* data) = NULL; //optional scatter of the transformed chunk to host memory. NULL - chunks are copied to output
+	void* userData = NULL;
+
+	bool initializeStreamingExecutor(VkFFTConfiguration inputLaunchConfiguration, uint32_t computeQueueFamilyIndex, VkQueue* inputTransferQueue, uint32_t transferQueueFamilyIndex, uint32_t inputNumberSlots = 3) {
+		configuration = inputLaunchConfiguration;
+		transferQueue = (inputTransferQueue != NULL) ? inputTransferQueue : configuration.queue;
+		queueFamilyIndices[0] = computeQueueFamilyIndex;
+		queueFamilyIndices[1] = (inputTransferQueue != NULL) ? transferQueueFamilyIndex : computeQueueFamilyIndex;
+		numberSlots = (inputNumberSlots > 2) ? inputNumberSlots : 2; //download of chunk i-1 is submitted after upload of chunk i, so one slot is always in flight
+#ifdef VKFFT_CPU_BACKEND
+		isCPUBackend = (configuration.useCPU) || (configuration.device == NULL);
+#endif
+		if ((configuration.isInputFormatted) || (configuration.isOutputFormatted) || ((configuration.performConvolution) && ((configuration.numberKernels > 1) || (isCPUBackend)))) {
+			printf("Streaming executor supports in-place FFTs and single kernel convolutions on the GPU\n");
+			return false;
+		}
+		VkFFTApplication planner = {};
+		chunkSize = planner.getMemoryRequirements(configuration).bufferSize;
+		batchSize = chunkSize / configuration.numberBatches;
+		if (isCPUBackend) {
+			numberSlots = 1;
+			apps = new VkFFTApplication[1]();
+			if (apps[0].initializeVulkanFFT(configuration) != VK_SUCCESS) {
+				deleteStreamingExecutor();
+				return false;
+			}
+			cpuChunk = (float*)malloc(chunkSize);
+			return true;
+		}
+		if ((configuration.device == NULL) || (configuration.queue == NULL) || (configuration.physicalDevice == NULL)) {
+			printf("Streaming executor needs device, queue and physicalDevice in the configuration\n");
+			return false;
+		}
+		VkDevice device = configuration.device[0];
+		apps = new VkFFTApplication[numberSlots]();
+		buffers = (VkBuffer*)malloc(numberSlots * sizeof(VkBuffer));
+		bufferDeviceMemory = (VkDeviceMemory*)malloc(numberSlots * sizeof(VkDeviceMemory));
+		for (uint32_t i = 0; i < numberSlots; i++) {
+			if (!VkFFTAllocateBuffer(device, configuration.physicalDevice[0], &buffers[i], &bufferDeviceMemory[i], VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, 0, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, chunkSize, 2, queueFamilyIndices)) {
+				numberSlots = i;
+				deleteStreamingExecutor();
+				return false;
+			}
+		}
+		if (!VkFFTAllocateBuffer(device, configuration.physicalDevice[0], &stagingBuffer, &stagingBufferDeviceMemory, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_CACHED_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 2 * numberSlots * chunkSize, 2, queueFamilyIndices)) {
+			deleteStreamingExecutor();
+			return false;
+		}
+		vkMapMemory(device, stagingBufferDeviceMemory, 0, 2 * numberSlots * chunkSize, 0, (void**)&stagingData);
+		for (uint32_t i = 0; i < 2; i++) {
+			VkCommandPoolCreateInfo commandPoolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+			commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndices[i];
+			vkCreateCommandPool(device, &commandPoolCreateInfo, NULL, &commandPools[i]);
+		}
+		commandBuffers = (VkCommandBuffer*)malloc(3 * numberSlots * sizeof(VkCommandBuffer));
+		semaphores = (VkSemaphore*)calloc(2 * numberSlots, sizeof(VkSemaphore));
+		fences = (VkFence*)calloc(numberSlots, sizeof(VkFence));
+		pendingChunks = (uint64_t*)malloc(numberSlots * sizeof(uint64_t));
+		VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+		VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+		for (uint32_t i = 0; i < numberSlots; i++) {
+			VkFFTConfiguration slotConfiguration = configuration;
+			slotConfiguration.buffer = &buffers[i];
+			slotConfiguration.inputBuffer = &buffers[i];
+			slotConfiguration.outputBuffer = &buffers[i];
+			slotConfiguration.bufferSize = &chunkSize;
+			slotConfiguration.inputBufferSize = &chunkSize;
+			slotConfiguration.outputBufferSize = &chunkSize;
+			if (apps[i].initializeVulkanFFT(slotConfiguration) != VK_SUCCESS) {
+				//semaphores and fences of the remaining slots are still null handles
+				deleteStreamingExecutor();
+				return false;
+			}
+			vkCreateSemaphore(device, &semaphoreCreateInfo, NULL, &semaphores[2 * i]);
+			vkCreateSemaphore(device, &semaphoreCreateInfo, NULL, &semaphores[2 * i + 1]);
+			vkCreateFence(device, &fenceCreateInfo, NULL, &fences[i]);
+			pendingChunks[i] = (uint64_t)-1;
+			//command buffers are recorded once - every chunk of the slot uses the same buffers and copy regions
+			for (uint32_t c = 0; c < 3; c++) {
+				VkCommandBufferAllocateInfo commandBufferAllocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+				commandBufferAllocateInfo.commandPool = commandPools[(c == 1) ? 0 : 1];
+				commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				commandBufferAllocateInfo.commandBufferCount = 1;
+				VkCommandBuffer* commandBuffer = &commandBuffers[3 * i + c];
+				vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, commandBuffer);
+				VkCommandBufferBeginInfo commandBufferBeginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+				vkBeginCommandBuffer(commandBuffer[0], &commandBufferBeginInfo);
+				VkBufferCopy copyRegion = {};
+				copyRegion.size = chunkSize;
+				if (c == 0) {
+					copyRegion.srcOffset = i * chunkSize;
+					vkCmdCopyBuffer(commandBuffer[0], stagingBuffer, buffers[i], 1, &copyRegion);
+				}
+				else if (c == 1)
+					apps[i].VkFFTAppend(commandBuffer[0]);
+				else {
+					copyRegion.dstOffset = (numberSlots + i) * chunkSize;
+					vkCmdCopyBuffer(commandBuffer[0], buffers[i], stagingBuffer, 1, &copyRegion);
+				}
+				vkEndCommandBuffer(commandBuffer[0]);
+			}
+		}
+		return true;
+	}
+	void submit(VkQueue queue, VkCommandBuffer commandBuffer, VkSemaphore* waitSemaphore, VkPipelineStageFlags waitStage, VkSemaphore* signalSemaphore, VkFence fence) {
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		if (waitSemaphore != NULL) {
+			submitInfo.waitSemaphoreCount = 1;
+			submitInfo.pWaitSemaphores = waitSemaphore;
+			submitInfo.pWaitDstStageMask = &waitStage;
+		}
+		if (signalSemaphore != NULL) {
+			submitInfo.signalSemaphoreCount = 1;
+			submitInfo.pSignalSemaphores = signalSemaphore;
+		}
+		vkQueueSubmit(queue, 1, &submitInfo, fence);
+	}
+	uint64_t getChunkBatches(uint64_t chunk, uint64_t numberBatches) {
+		uint64_t first = chunk * configuration.numberBatches;
+		return (numberBatches - first < configuration.numberBatches) ? numberBatches - first : configuration.numberBatches;
+	}
+	void readChunk(const float* input, uint64_t chunk, uint64_t numberBatches, char* data) {
+		if (packChunk != NULL) packChunk(userData, chunk, getChunkBatches(chunk, numberBatches), data);
+		else memcpy(data, (const char*)input + chunk * configuration.numberBatches * batchSize, getChunkBatches(chunk, numberBatches) * batchSize);
+	}
+	void writeChunk(float* output, uint64_t chunk, uint64_t numberBatches, const char* data) {
+		if (unpackChunk != NULL) unpackChunk(userData, chunk, getChunkBatches(chunk, numberBatches), data);
+		else memcpy((char*)output + chunk * configuration.numberBatches * batchSize, data, getChunkBatches(chunk, numberBatches) * batchSize);
+	}
+	void finishSlot(uint32_t slot, float* output, uint64_t numberBatches) {
+		//waits for the download of the chunk in the slot and copies it to its place in the output
+		uint64_t chunk = pendingChunks[slot];
+		if (chunk == (uint64_t)-1) return;
+		vkWaitForFences(configuration.device[0], 1, &fences[slot], VK_TRUE, 100000000000);
+		vkResetFences(configuration.device[0], 1, &fences[slot]);
+		writeChunk(output, chunk, numberBatches, stagingData + (numberSlots + slot) * chunkSize);
+		pendingChunks[slot] = (uint64_t)-1;
+	}
+	VkFFTStreamingStatistics executeStreaming(const float* input, float* output, uint64_t numberBatches, bool transferOnly = false) {
+		//transforms numberBatches batches of input (same layout as configuration.buffer, batches concatenated) to output. With packChunk/unpackChunk set, input/output are not accessed and can be NULL. transferOnly skips VkFFTAppend - the same pipeline measures the host<->device bandwidth the transform is bounded by
+		VkFFTStreamingStatistics statistics = {};
+		uint64_t numberChunks = (numberBatches + configuration.numberBatches - 1) / configuration.numberBatches;
+		auto timeStart = std::chrono::steady_clock::now();
+#ifdef VKFFT_CPU_BACKEND
+		for (uint64_t i = 0; (isCPUBackend) && (i < numberChunks); i++) {
+			readChunk(input, i, numberBatches, (char*)cpuChunk);
+			if (!transferOnly) apps[0].executeOnCPU(cpuChunk);
+			writeChunk(output, i, numberBatches, (const char*)cpuChunk);
+		}
+#endif
+		for (uint64_t i = 0; (!isCPUBackend) && (i <= numberChunks); i++) {
+			if (i < numberChunks) {
+				uint32_t slot = i % numberSlots;
+				finishSlot(slot, output, numberBatches);
+				readChunk(input, i, numberBatches, stagingData + slot * chunkSize);
+				submit(transferQueue[0], commandBuffers[3 * slot], NULL, 0, &semaphores[2 * slot], VK_NULL_HANDLE);
+				if (!transferOnly)
+					submit(configuration.queue[0], commandBuffers[3 * slot + 1], &semaphores[2 * slot], VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, &semaphores[2 * slot + 1], VK_NULL_HANDLE);
+			}
+			if (i > 0) {
+				//download of the previous chunk is submitted after the upload of the current one, so the transfer queue never waits for compute with an upload behind it
+				uint32_t slot = (i - 1) % numberSlots;
+				submit(transferQueue[0], commandBuffers[3 * slot + 2], &semaphores[2 * slot + ((transferOnly) ? 0 : 1)], VK_PIPELINE_STAGE_TRANSFER_BIT, NULL, fences[slot]);
+				pendingChunks[slot] = i - 1;
+			}
+		}
+		for (uint32_t i = 0; (!isCPUBackend) && (i < numberSlots); i++)
+			finishSlot(i, output, numberBatches);
+		auto timeEnd = std::chrono::steady_clock::now();
+		statistics.time = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count() * 0.001;
+		statistics.numberChunks = numberChunks;
+		statistics.bytesUploaded = numberBatches * batchSize;
+		statistics.bytesDownloaded = numberBatches * batchSize;
+		statistics.throughput = (statistics.time > 0) ? (statistics.bytesUploaded + statistics.bytesDownloaded) / (statistics.time * 1e6) : 0;
+		return statistics;
+	}
+	void deleteStreamingExecutor() {
+		if (apps == NULL) return;
+		if (isCPUBackend) {
+			apps[0].deleteVulkanFFT();
+			free(cpuChunk);
+		}
+		else {
+			VkDevice device = configuration.device[0];
+			vkDeviceWaitIdle(device);
+			if (commandBuffers != NULL) {
+				for (uint32_t i = 0; i < numberSlots; i++) {
+					apps[i].deleteVulkanFFT();
+					vkDestroySemaphore(device, semaphores[2 * i], NULL);
+					vkDestroySemaphore(device, semaphores[2 * i + 1], NULL);
+					vkDestroyFence(device, fences[i], NULL);
+				}
+				for (uint32_t i = 0; i < 2; i++)
+					vkDestroyCommandPool(device, commandPools[i], NULL);
+				free(commandBuffers);
+				free(semaphores);
+				free(fences);
+				free(pendingChunks);
+				commandBuffers = NULL;
+			}
+			if (stagingData != NULL) {
+				vkUnmapMemory(device, stagingBufferDeviceMemory);
+				vkDestroyBuffer(device, stagingBuffer, NULL);
+				vkFreeMemory(device, stagingBufferDeviceMemory, NULL);
+				stagingData = NULL;
+			}
+			for (uint32_t i = 0; i < numberSlots; i++) {
+				vkDestroyBuffer(device, buffers[i], NULL);
+				vkFreeMemory(device, bufferDeviceMemory[i], NULL);
+			}
+			free(buffers);
+			free(bufferDeviceMemory);
+		}
+		delete[] apps;
+		apps = NULL;
+	}
+} VkFFTStreamingExecutor;
+typedef struct VkFFTOutOfCore {
+	//3D C2C FFT of a volume in host memory bigger than device memory, for example memory-mapped input and output files. First pass - 2D FFTs of slabs of z planes, from input to output. Second pass - 1D FFTs along z of slabs of y rows of output, transposed on the host so that z is contiguous, and written back in-place. Both passes are pipelined by streaming executors, so device memory and host staging memory are bounded by the slab size, not the volume size
+	VkFFTConfiguration configuration = {}; //FFTdim 3 C2C configuration of the whole volume with one batch and coordinate. device, physicalDevice and queue as in VkFFTStreamingExecutor, without device both passes run on the CPU backend
+	VkFFTStreamingExecutor executors[2]; //slabs of planes (x and y axes) and slabs of rows (z axis)
+	uint64_t planesPerSlab = 0;
+	uint64_t rowsPerSlab = 0;
+	float* volume = NULL; //output of the current executeOutOfCore, gathered and scattered by the second pass
+
+	bool initializeOutOfCore(VkFFTConfiguration inputLaunchConfiguration, VkDeviceSize maxSlabSize, uint32_t computeQueueFamilyIndex = 0, VkQueue* transferQueue = NULL, uint32_t transferQueueFamilyIndex = 0) {
+		//maxSlabSize - bytes of one slab. Each pass keeps 3 slabs on the device and 6 in host visible staging memory
+		configuration = inputLaunchConfiguration;
+		if ((configuration.FFTdim != 3) || (configuration.performR2C) || (configuration.performConvolution) || (configuration.coordinateFeatures != 1) || (configuration.numberBatches != 1)) {
+			printf("Out-of-core FFT supports 3D C2C transforms of one volume\n");
+			return false;
+		}
+		uint64_t planeSize = (uint64_t)configuration.size[0] * configuration.size[1] * 2 * sizeof(float);
+		uint64_t rowSize = (uint64_t)configuration.size[0] * configuration.size[2] * 2 * sizeof(float);
+		planesPerSlab = maxSlabSize / planeSize;
+		if (planesPerSlab < 1) planesPerSlab = 1;
+		if (planesPerSlab > configuration.size[2]) planesPerSlab = configuration.size[2];
+		rowsPerSlab = maxSlabSize / rowSize;
+		if (rowsPerSlab < 1) rowsPerSlab = 1;
+		if (rowsPerSlab > configuration.size[1]) rowsPerSlab = configuration.size[1];
+		VkFFTConfiguration slabConfiguration = configuration;
+		slabConfiguration.FFTdim = 2;
+		slabConfiguration.size[2] = 1;
+		slabConfiguration.numberBatches = planesPerSlab;
+		if (!executors[0].initializeStreamingExecutor(slabConfiguration, computeQueueFamilyIndex, transferQueue, transferQueueFamilyIndex))
+			return false;
+		VkFFTConfiguration rowConfiguration = configuration;
+		rowConfiguration.FFTdim = 1;
+		rowConfiguration.size[0] = configuration.size[2];
+		rowConfiguration.size[1] = 1;
+		rowConfiguration.size[2] = 1;
+		rowConfiguration.numberBatches = rowsPerSlab * configuration.size[0];
+		if (!executors[1].initializeStreamingExecutor(rowConfiguration, computeQueueFamilyIndex, transferQueue, transferQueueFamilyIndex)) {
+			executors[0].deleteStreamingExecutor();
+			return false;
+		}
+		executors[1].packChunk = packRows;
+		executors[1].unpackChunk = unpackRows;
+		executors[1].userData = this;
+		return true;
+	}
+	static void packRows(void* userData, uint64_t chunk, uint64_t chunkBatches, char* data) {
+		//z pencils of rows [chunk * rowsPerSlab, ...) are stored one after another. z is read in blocks of 16 planes, so that writes to data stay in cache
+		VkFFTOutOfCore* outOfCore = (VkFFTOutOfCore*)userData;
+		uint64_t planeSize = (uint64_t)outOfCore->configuration.size[0] * outOfCore->configuration.size[1];
+		uint64_t Z = outOfCore->configuration.size[2];
+		const float* src = outOfCore->volume + 2 * chunk * outOfCore->rowsPerSlab * outOfCore->configuration.size[0];
+		float* dst = (float*)data;
+		for (uint64_t z0 = 0; z0 < Z; z0 += 16) {
+			uint64_t z1 = (z0 + 16 < Z) ? z0 + 16 : Z;
+			for (uint64_t p = 0; p < chunkBatches; p++) {
+				for (uint64_t z = z0; z < z1; z++) {
+					dst[2 * (p * Z + z)] = src[2 * (z * planeSize + p)];
+					dst[2 * (p * Z + z) + 1] = src[2 * (z * planeSize + p) + 1];
+				}
+			}
+		}
+	}
+	static void unpackRows(void* userData, uint64_t chunk, uint64_t chunkBatches, const char* data) {
+		VkFFTOutOfCore* outOfCore = (VkFFTOutOfCore*)userData;
+		uint64_t planeSize = (uint64_t)outOfCore->configuration.size[0] * outOfCore->configuration.size[1];
+		uint64_t Z = outOfCore->configuration.size[2];
+		float* dst = outOfCore->volume + 2 * chunk * outOfCore->rowsPerSlab * outOfCore->configuration.size[0];
+		const float* src = (const float*)data;
+		for (uint64_t z0 = 0; z0 < Z; z0 += 16) {
+			uint64_t z1 = (z0 + 16 < Z) ? z0 + 16 : Z;
+			for (uint64_t p = 0; p < chunkBatches; p++) {
+				for (uint64_t z = z0; z < z1; z++) {
+					dst[2 * (z * planeSize + p)] = src[2 * (p * Z + z)];
+					dst[2 * (z * planeSize + p) + 1] = src[2 * (p * Z + z) + 1];
+				}
+			}
+		}
+	}
+	VkFFTStreamingStatistics executeOutOfCore(const float* input, float* output) {
+		//input is only read. Statistics sum both passes - bytes uploaded and downloaded are twice the volume size
+		volume = output;
+		VkFFTStreamingStatistics planes = executors[0].executeStreaming(input, output, configuration.size[2]);
+		VkFFTStreamingStatistics rows = executors[1].executeStreaming(NULL, NULL, (uint64_t)configuration.size[0] * configuration.size[1]);
+		VkFFTStreamingStatistics statistics = {};
+		statistics.time = planes.time + rows.time;
+		statistics.numberChunks = planes.numberChunks + rows.numberChunks;
+		statistics.bytesUploaded = planes.bytesUploaded + rows.bytesUploaded;
+		statistics.bytesDownloaded = planes.bytesDownloaded + rows.bytesDownloaded;
+		statistics.throughput = (statistics.time > 0) ? (statistics.bytesUploaded + statistics.bytesDownloaded) / (statistics.time * 1e6) : 0;
+		return statistics;
+	}
+	void deleteOutOfCore() {
+		executors[0].deleteStreamingExecutor();
+		executors[1].deleteStreamingExecutor();
+	}
+} VkFFTOutOfCore;
+#if defined(VK_VERSION_1_2) || defined(VK_KHR_timeline_semaphore)
+//timeline semaphores are used through their VK_KHR_timeline_semaphore names, which Vulkan 1.2 headers keep as aliases of the core ones
+typedef struct VkFFTQueueTicket {
+	uint32_t queueIndex = 0; //queue the submission was scheduled on
+	uint64_t value = 0; //value of the timeline semaphore of the queue signaled when the submission is complete. 0 - no submission
+} VkFFTQueueTicket;
+typedef struct VkFFTQueueScheduler {
+	//Spreads independent submissions, for example command buffers recorded with VkFFTRecordCommandBuffer, over several queues, so that small FFTs run concurrently and fill the gaps of barrier-bound passes of each other. Every queue has a timeline semaphore and every submission signals its next value - the returned ticket can be waited for on the host or made a dependency of a later submission on any queue, no fences are used. Needs timeline semaphores (Vulkan 1.2 or VK_KHR_timeline_semaphore) enabled on the device
+	VkDevice device = VK_NULL_HANDLE;
+	uint32_t numberQueues = 0;
+	VkQueue* queues = NULL;
+	VkSemaphore* semaphores = NULL; //timeline semaphore of each queue
+	uint64_t* submittedValues = NULL; //last value signaled by a submission to each queue
+	uint32_t nextQueue = 0; //queue tried first by the next submit, to rotate between equally loaded queues
+	uint32_t maxDependencies = 0; //most dependencies a single submit can wait for
+	VkSemaphore* waitSemaphoreHandles = NULL; //scratch wait lists of submit, maxDependencies long
+	uint64_t* waitValues = NULL;
+	VkPipelineStageFlags* waitStages = NULL;
+	PFN_vkWaitSemaphoresKHR waitSemaphores = NULL;
+	PFN_vkGetSemaphoreCounterValueKHR getSemaphoreCounterValue = NULL;
+
+	bool initializeQueueScheduler(VkDevice inputDevice, VkQueue* inputQueues, uint32_t inputNumberQueues, uint32_t inputMaxDependencies = 8) {
+		//queues can be from different families, command buffers passed to submit must be compatible with all of them
+		device = inputDevice;
+		waitSemaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(device, "vkWaitSemaphores");
+		if (waitSemaphores == NULL) waitSemaphores = (PFN_vkWaitSemaphoresKHR)vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR");
+		getSemaphoreCounterValue = (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValue");
+		if (getSemaphoreCounterValue == NULL) getSemaphoreCounterValue = (PFN_vkGetSemaphoreCounterValueKHR)vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR");
+		if ((waitSemaphores == NULL) || (getSemaphoreCounterValue == NULL) || (inputNumberQueues == 0)) {
+			printf("Queue scheduler needs timeline semaphores enabled on the device and at least one queue\n");
+			return false;
+		}
+		numberQueues = inputNumberQueues;
+		maxDependencies = inputMaxDependencies;
+		queues = (VkQueue*)malloc(sizeof(VkQueue) * numberQueues);
+		semaphores = (VkSemaphore*)malloc(sizeof(VkSemaphore) * numberQueues);
+		submittedValues = (uint64_t*)malloc(sizeof(uint64_t) * numberQueues);
+		waitSemaphoreHandles = (VkSemaphore*)malloc(sizeof(VkSemaphore) * maxDependencies);
+		waitValues = (uint64_t*)malloc(sizeof(uint64_t) * maxDependencies);
+		waitStages = (VkPipelineStageFlags*)malloc(sizeof(VkPipelineStageFlags) * maxDependencies);
+		for (uint32_t i = 0; i < numberQueues; i++) {
+			queues[i] = inputQueues[i];
+			VkSemaphoreTypeCreateInfoKHR semaphoreTypeCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR };
+			semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+			semaphoreTypeCreateInfo.initialValue = 0;
+			VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+			semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+			vkCreateSemaphore(device, &semaphoreCreateInfo, NULL, &semaphores[i]);
+			submittedValues[i] = 0;
+		}
+		nextQueue = 0;
+		return true;
+	}
+	VkFFTQueueTicket submit(VkCommandBuffer commandBuffer, VkFFTQueueTicket* dependencies = NULL, uint32_t numberDependencies = 0) {
+		//submits commandBuffer to the queue with the fewest unfinished submissions. It starts after the submissions of dependencies are complete, on whichever queues they were scheduled. Command buffer is submitted as is - it needs the simultaneous use flag if it can be pending on two queues at once
+		VkFFTQueueTicket ticket = {};
+		if (numberDependencies > maxDependencies) {
+			printf("Queue scheduler submit has %d dependencies, initialized for at most %d\n", numberDependencies, maxDependencies);
+			return ticket;
+		}
+		uint32_t queueIndex = nextQueue;
+		uint64_t minPending = (uint64_t)-1;
+		for (uint32_t k = 0; k < numberQueues; k++) {
+			uint32_t i = (nextQueue + k) % numberQueues;
+			uint64_t completedValue = 0;
+			getSemaphoreCounterValue(device, semaphores[i], &completedValue);
+			if (submittedValues[i] - completedValue < minPending) {
+				minPending = submittedValues[i] - completedValue;
+				queueIndex = i;
+			}
+		}
+		nextQueue = (queueIndex + 1) % numberQueues;
+		//waits and signals are all timeline semaphores - values are passed for each of them
+		uint32_t numberWaits = 0;
+		for (uint32_t i = 0; i < numberDependencies; i++) {
+			//also on the same queue - consecutive submissions are not ordered without a wait
+			if (dependencies[i].value == 0) continue;
+			waitSemaphoreHandles[numberWaits] = semaphores[dependencies[i].queueIndex];
+			waitValues[numberWaits] = dependencies[i].value;
+			waitStages[numberWaits] = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			numberWaits++;
+		}
+		ticket.queueIndex = queueIndex;
+		ticket.value = submittedValues[queueIndex] + 1;
+		VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR };
+		timelineSubmitInfo.waitSemaphoreValueCount = numberWaits;
+		timelineSubmitInfo.pWaitSemaphoreValues = waitValues;
+		timelineSubmitInfo.signalSemaphoreValueCount = 1;
+		timelineSubmitInfo.pSignalSemaphoreValues = &ticket.value;
+		VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+		submitInfo.pNext = &timelineSubmitInfo;
+		submitInfo.waitSemaphoreCount = numberWaits;
+		submitInfo.pWaitSemaphores = waitSemaphoreHandles;
+		submitInfo.pWaitDstStageMask = waitStages;
+		submitInfo.commandBufferCount = (commandBuffer != VK_NULL_HANDLE) ? 1 : 0;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		submitInfo.signalSemaphoreCount = 1;
+		submitInfo.pSignalSemaphores = &semaphores[queueIndex];
+		VkResult res = vkQueueSubmit(queues[queueIndex], 1, &submitInfo, VK_NULL_HANDLE);
+		if (res != VK_SUCCESS) {
+			printf("Queue submission failed: %d\n", res);
+			ticket.value = 0;
+			return ticket;
+		}
+		submittedValues[queueIndex] = ticket.value;
+		return ticket;
+	}
+	bool isComplete(VkFFTQueueTicket ticket) {
+		if (ticket.value == 0) return true;
+		uint64_t completedValue = 0;
+		getSemaphoreCounterValue(device, semaphores[ticket.queueIndex], &completedValue);
+		return (completedValue >= ticket.value);
+	}
+	void wait(VkFFTQueueTicket ticket) {
+		if (ticket.value == 0) return;
+		VkSemaphoreWaitInfoKHR semaphoreWaitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR };
+		semaphoreWaitInfo.semaphoreCount = 1;
+		semaphoreWaitInfo.pSemaphores = &semaphores[ticket.queueIndex];
+		semaphoreWaitInfo.pValues = &ticket.value;
+		waitSemaphores(device, &semaphoreWaitInfo, 100000000000);
+	}
+	void waitQueueScheduler() {
+		//waits for all submissions on all queues
+		VkSemaphoreWaitInfoKHR semaphoreWaitInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR };
+		semaphoreWaitInfo.semaphoreCount = numberQueues;
+		semaphoreWaitInfo.pSemaphores = semaphores;
+		semaphoreWaitInfo.pValues = submittedValues;
+		waitSemaphores(device, &semaphoreWaitInfo, 100000000000);
+	}
+	void deleteQueueScheduler() {
+		if (semaphores == NULL) return;
+		waitQueueScheduler();
+		for (uint32_t i = 0; i < numberQueues; i++)
+			vkDestroySemaphore(device, semaphores[i], NULL);
+		free(queues);
+		free(semaphores);
+		free(submittedValues);
+		free(waitSemaphoreHandles);
+		free(waitValues);
+		free(waitStages);
+		queues = NULL;
+		semaphores = NULL;
+		submittedValues = NULL;
+		waitSemaphoreHandles = NULL;
+		waitValues = NULL;
+		waitStages = NULL;
+		numberQueues = 0;
+	}
+} VkFFTQueueScheduler;
+#endif